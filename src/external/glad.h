@@ -3048,6 +3048,17 @@ GLAPI int GLAD_GL_ARB_framebuffer_object;
 #define GL_ARB_framebuffer_sRGB 1
 GLAPI int GLAD_GL_ARB_framebuffer_sRGB;
 #endif
+#ifndef GL_ARB_get_program_binary
+#define GL_ARB_get_program_binary 1
+/* Not loaded by gladLoadGLLoader(), function pointers must be queried by the application */
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_PROGRAM_BINARY_FORMATS 0x87FF
+typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+#endif
 #ifndef GL_ARB_multisample
 #define GL_ARB_multisample 1
 GLAPI int GLAD_GL_ARB_multisample;
@@ -3704,6 +3715,13 @@ typedef void (APIENTRYP PFNGLGETLOCALCONSTANTFLOATVEXTPROC)(GLuint id, GLenum va
 GLAPI PFNGLGETLOCALCONSTANTFLOATVEXTPROC glad_glGetLocalConstantFloatvEXT;
 #define glGetLocalConstantFloatvEXT glad_glGetLocalConstantFloatvEXT
 #endif
+#ifndef GL_KHR_parallel_shader_compile
+#define GL_KHR_parallel_shader_compile 1
+/* Not loaded by gladLoadGLLoader(), function pointers must be queried by the application */
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+#endif
 
 #ifdef __cplusplus
 }
@@ -26,7 +26,9 @@
 #if !defined(FNODE_H)
 #define FNODE_H
 
-#define FNODE_STATIC
+#if !defined(FNODE_STATIC) && !defined(FNODE_EXTERN)
+    #define FNODE_STATIC               // Functions are static unless FNODE_EXTERN is defined before including this file
+#endif
 
 #if defined(FNODE_STATIC)
     #define FNODEDEF static            // Functions just visible to module including this file
@@ -48,6 +50,8 @@
 //----------------------------------------------------------------------------------
 #define     MAX_INPUTS                  4                       // Max number of inputs in every node
 #define     MAX_VALUES                  16                      // Max number of values in every output
+#define     MAX_TEXTURES                8                       // Max number of shader texture units
+#define     MAX_HOISTED_VARYINGS        4                       // Max fragment values computed in vertex stage
 
 //----------------------------------------------------------------------------------
 // Enums Definition
@@ -118,26 +122,32 @@ typedef enum {
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-typedef struct FNodeValue {
-    float value;                            // Output data value
-    Rectangle shape;                        // Output data shape
-    char *valueText;                        // Output data value as text
-} FNodeValue;
-
 typedef struct FNodeOutput {
-    FNodeValue data[MAX_VALUES];            // Output data array (float, Vector2, Vector3 or Vector4)
+    float data[MAX_VALUES];                 // Output data values packed contiguously (float, Vector2, Vector3 or Vector4)
     int dataCount;                          // Output data length to know which type of data represents
 } FNodeOutput;
 
+typedef struct FNodeOutputView {
+    Rectangle shapes[MAX_VALUES];           // Output data values shapes
+    char *texts[MAX_VALUES];                // Output data values as text (only updated when values change)
+    bool stale;                             // Output data values texts must be formatted again when node or its output lines are drawn
+} FNodeOutputView;
+
 typedef struct FNodeData {
     unsigned int id;                        // Node unique identifier
     FNodeType type;                         // Node type (values, operations...)
     const char *name;                       // Displayed name of the node
     int inputs[MAX_INPUTS];                 // Inputs node ids array
+    struct FLineData *inputLines[MAX_INPUTS];   // Lines linked to every input (same order as inputs node ids)
     unsigned int inputsCount;               // Inputs node ids array length
     unsigned int inputsLimit;               // Inputs node ids length limit
+    int *outputs;                           // Linked node ids array which use this node as input
+    unsigned int outputsCount;              // Linked node ids array length
+    unsigned int outputsLimit;              // Linked node ids array allocated length
     bool property;                          // Node is property state
+    bool dirty;                             // Node output values need to be calculated again state
     FNodeOutput output;                     // Value output (contains the value and its length)
+    FNodeOutputView outputView;             // Value output interface layout and display text
     Rectangle shape;                        // Node rectangle data
     Rectangle inputShape;                   // Node input rectangle data (automatically calculated from shape)
     Rectangle outputShape;                  // Node input rectangle data (automatically calculated from shape)
@@ -147,6 +157,7 @@ typedef struct FLineData {
     unsigned int id;                        // Line unique identifier
     unsigned int from;                      // Id from line start node
     unsigned int to;                        // Id from line end node
+    int index;                              // Lines pool index of the line
 } FLineData, *FLine;
 
 typedef struct FCommentData {
@@ -164,6 +175,95 @@ typedef struct FCommentData {
     Rectangle sizeBrShape;                  // Comment bottom-right size edit rectangle data
 } FCommentData, *FComment;
 
+typedef struct FString {
+    char *text;                             // Null terminated text (reallocated when it grows)
+    int length;                             // Text length without null terminator
+    int capacity;                           // Text allocated length
+} FString;
+
+typedef struct FIdPool {
+    int *freeIds;                           // Released ids available to be used again
+    int freeCount;                          // Released ids array length
+    int freeLimit;                          // Released ids array allocated length
+    int nextId;                             // Lowest id never used before
+} FIdPool;
+
+typedef struct FArena {
+    int slotSize;                           // Size in bytes of every slot (record and its text storage)
+    void *blocks;                           // Last allocated memory block (every block starts with a pointer to the previous one)
+    int blockUsed;                          // Slots handed out from last allocated block
+    void *freeSlots;                        // Released slots list (every released slot starts with a pointer to the next one)
+    int usedMemory;                         // Arena allocated memory in bytes
+} FArena;
+
+typedef struct FNodeContextData {
+    int usedMemory;                         // Total used RAM from memory allocation
+    FIdPool nodesIds;                       // Nodes unique identifiers allocator
+    FIdPool linesIds;                       // Lines unique identifiers allocator
+    FIdPool commentsIds;                    // Comments unique identifiers allocator
+    FArena nodesArena;                      // Nodes and their values text memory allocator
+    FArena linesArena;                      // Lines memory allocator
+    FArena commentsArena;                   // Comments and their value text memory allocator
+
+    int nodesCount;                         // Created nodes count
+    int nodesLimit;                         // Nodes pool allocated length
+    FNode *nodes;                           // Nodes pointers pool
+    int *nodesIndex;                        // Nodes pool index of every node id (-1 if id is not used)
+    bool *nodesChanged;                     // Nodes output values changed during current values calculation
+    int selectedNode;                       // Current selected node to drag in canvas
+    int editNode;                           // Current edited node data
+    int editNodeType;                       // Current edited node data index
+    char *editNodeText;                     // Current edited node data value text before any changes
+    int *evaluationOrder;                   // Nodes indexes sorted by inputs dependencies to calculate values in a single pass
+    int evaluationOrderCount;               // Nodes evaluation order length
+    bool topologyChanged;                   // Nodes or lines changed since last evaluation order build state
+    bool cycleDetected;                     // Current nodes links contain a cycle state
+    struct FInstruction *program;           // Nodes values calculation instructions lowered from evaluation order
+    int programCount;                       // Lowered program instructions count
+    int programLimit;                       // Lowered program allocated length
+    struct FProgramBlock *programBlocks;    // Lowered program instructions grouped by node
+    int programBlocksCount;                 // Lowered program blocks count
+    int programBlocksLimit;                 // Lowered program blocks, registers and widths allocated length (in nodes)
+    int *programWidths;                     // Nodes output values count resolved while lowering
+    float *registers;                       // Lowered program registers (MAX_VALUES floats per node index)
+    bool programStale;                      // Lowered widths do not match current width selector values state
+
+    ShaderVersion shaderVersion;            // Shader version of code being generated
+    bool usedUnits[MAX_TEXTURES];           // Shader code generation declared texture units
+    bool fetchedUnits[MAX_TEXTURES];        // Shader code generation texture units already sampled in current stage
+    int *expressionIds;                     // Shader code generation first structurally identical node id of each node id
+    signed char *foldStates;                // Shader code generation compile-time constant state of each node id (-1 unknown, 0 varying, 1 constant)
+    signed char *interpolations;            // Shader code generation interpolation of each node id value over a primitive (-1 unknown)
+    int hoistedNodes[MAX_HOISTED_VARYINGS]; // Shader code generation fragment node ids computed in vertex stage
+    int hoistedCount;                       // Shader code generation fragment node ids computed in vertex stage count
+
+    int linesCount;                         // Created lines count
+    int linesLimit;                         // Lines pool allocated length
+    FLine *lines;                           // Lines pointers pool
+    int lineState;                          // Current line linking state (0 = waiting for output to link, 1 = output selected, waiting for input to link)
+    FLine tempLine;                         // Temporally created line during line states
+    int pendingLinesCount;                  // Created lines without end node count (lines being linked)
+
+    int commentsCount;                      // Created comments count
+    int commentsLimit;                      // Comments pool allocated length
+    FComment *comments;                     // Comments pointers pool
+    int commentState;                       // Current comment creation state (0 = waiting to create, 1 = waiting to finish creation)
+    int selectedComment;                    // Current selected comment to drag in canvas
+    int editSize;                           // Current edited comment
+    int editSizeType;                       // Current edited comment size (0 = top, 1 = bottom, 2 = left, 3 = right, 4 = top-left, 5 = top-right, 6 = bottom-left, 7 = bottom-right)
+    int editComment;                        // Current edited comment value
+    int *selectedCommentNodes;              // Current selected comment nodes ids list to drag
+    int selectedCommentNodesCount;          // Current selected comment nodes ids list count
+    FComment tempComment;                   // Temporally created comment during comment states
+    Vector2 tempCommentPos;                 // Temporally created comment start position
+    Vector2 screenSize;                     // Window screen width
+    Camera2D camera;                        // Node area 2d camera for panning
+    Camera camera3d;                        // Visor camera 3d for model and shader visualization
+    bool debugMode;                         // Drawing debug information state
+    int menuOffset;                         // Interface elements position current offset
+    bool interact;                          // Buttons and text can interact state
+} FNodeContextData, *FNodeContext;
+
 #if defined(__cplusplus)
 extern "C" {                                    // Prevents name mangling of functions
 #endif
@@ -176,38 +276,52 @@ extern "C" {                                    // Prevents name mangling of fun
 //------------------------------------------------------------------------------------
 // Module Functions Declaration
 //------------------------------------------------------------------------------------
-FNODEDEF void InitFNode();                                                           // Initializes FNode global variables
+FNODEDEF FNodeContext InitFNode();                                                   // Initializes a context which owns a graph and its editing state
+#if !defined(FNODE_NO_EDITOR)
 FNODEDEF void SetBackfaceCulling(bool state);                                        // Set backface culling state in openGL context
-FNODEDEF FNode CreateNodePI();                                                       // Creates a node which returns PI value
-FNODEDEF FNode CreateNodeE();                                                        // Creates a node which returns e value
-FNODEDEF FNode CreateNodeMatrix(Matrix mat);                                         // Creates a matrix 4x4 node (OpenGL style 4x4 - right handed, column major)
-FNODEDEF FNode CreateNodeValue(float value);                                         // Creates a value node (1 float)
-FNODEDEF FNode CreateNodeVector2(Vector2 vector);                                    // Creates a Vector2 node (2 float)
-FNODEDEF FNode CreateNodeVector3(Vector3 vector);                                    // Creates a Vector3 node (3 float)
-FNODEDEF FNode CreateNodeVector4(Vector4 vector);                                    // Creates a Vector4 node (4 float)
-FNODEDEF FNode CreateNodeOperator(FNodeType type, const char *name, int inputs);     // Creates an operator node with type name and inputs limit as parameters
-FNODEDEF FNode CreateNodeUniform(FNodeType type, const char *name, int dataCount);   // Creates an uniform node with type name and data count as parameters
-FNODEDEF FNode CreateNodeProperty(FNodeType type, const char *name, int dataCount, int inputs);  // Creates a property node with type name and data count as parameters
-FNODEDEF FNode CreateNodeMaterial(FNodeType type, const char *name, int dataCount);  // Creates the main node that contains final fragment color
-FNODEDEF FNode InitializeNode(bool isOperator);                                      // Initializes a new node with generic parameters
-FNODEDEF int GetNodeIndex(int id);                                                   // Returns the index of a node searching by its id
-FNODEDEF FLine CreateNodeLine();                                                     // Creates a line between two nodes
-FNODEDEF FComment CreateComment();                                                   // Creates a comment
+#endif
+FNODEDEF FNode CreateNodePI(FNodeContext context);                                   // Creates a node which returns PI value
+FNODEDEF FNode CreateNodeE(FNodeContext context);                                    // Creates a node which returns e value
+FNODEDEF FNode CreateNodeMatrix(FNodeContext context, Matrix mat);                   // Creates a matrix 4x4 node (OpenGL style 4x4 - right handed, column major)
+FNODEDEF FNode CreateNodeValue(FNodeContext context, float value);                   // Creates a value node (1 float)
+FNODEDEF FNode CreateNodeVector2(FNodeContext context, Vector2 vector);              // Creates a Vector2 node (2 float)
+FNODEDEF FNode CreateNodeVector3(FNodeContext context, Vector3 vector);              // Creates a Vector3 node (3 float)
+FNODEDEF FNode CreateNodeVector4(FNodeContext context, Vector4 vector);              // Creates a Vector4 node (4 float)
+FNODEDEF FNode CreateNodeOperator(FNodeContext context, FNodeType type, const char *name, int inputs);   // Creates an operator node with type name and inputs limit as parameters
+FNODEDEF FNode CreateNodeUniform(FNodeContext context, FNodeType type, const char *name, int dataCount);   // Creates an uniform node with type name and data count as parameters
+FNODEDEF FNode CreateNodeProperty(FNodeContext context, FNodeType type, const char *name, int dataCount, int inputs);   // Creates a property node with type name and data count as parameters
+FNODEDEF FNode CreateNodeMaterial(FNodeContext context, FNodeType type, const char *name, int dataCount);   // Creates the main node that contains final fragment color
+FNODEDEF FNode InitializeNode(FNodeContext context, bool isOperator);                // Initializes a new node with generic parameters
+FNODEDEF int GetNodeIndex(FNodeContext context, int id);                             // Returns the index of a node searching by its id
+FNODEDEF bool IsNodeReachable(FNodeContext context, int from, int to);               // Check if a node can be reached from another node following their linked outputs
+FNODEDEF FLine CreateNodeLine(FNodeContext context, int from, int to);               // Creates a line between two nodes (end node id is -1 while linking)
+FNODEDEF FComment CreateComment(FNodeContext context);                               // Creates a comment
 FNODEDEF void AlignNode(FNode node);                                                 // Aligns a node to the nearest grid intersection
 FNODEDEF void UpdateNodeShapes(FNode node);                                          // Updates a node shapes due to drag behaviour
-FNODEDEF void UpdateCommentShapes(FComment comment);                                 // Updates a comment shapes due to drag behaviour
+FNODEDEF void UpdateCommentShapes(FNodeContext context, FComment comment);           // Updates a comment shapes due to drag behaviour
 FNODEDEF Vector2 CameraToViewVector2(Vector2 vector, Camera2D camera);               // Converts Vector2 coordinates from world space to Camera2D space based on its offset
 FNODEDEF Rectangle CameraToViewRec(Rectangle rec, Camera2D camera);                  // Converts rectangle coordinates from world space to Camera2D space based on its offset
-FNODEDEF void CalculateValues();                                                     // Calculates nodes output values based on current inputs
-FNODEDEF void DrawNode(FNode node);                                                  // Draws a previously created node
-FNODEDEF void DrawNodeLine(FLine line);                                              // Draws a previously created node line
-FNODEDEF void DrawComment(FComment comment);                                         // Draws a previously created comment
-FNODEDEF void DestroyNode(FNode node);                                               // Destroys a node and its linked lines
-FNODEDEF void DestroyNodeLine(FLine line);                                           // Destroys a node line
-FNODEDEF void DestroyComment(FComment comment);                                      // Destroys a comment
-FNODEDEF void CloseFNode();                                                          // Unitializes FNode global variables
+FNODEDEF void CalculateValues(FNodeContext context);                                 // Calculates nodes output values based on current inputs
+FNODEDEF void SetNodeDirty(FNode node);                                              // Marks a node to calculate its values and the values of its linked nodes again
+FNODEDEF void EvaluateMeshVertices(FNodeContext context, Mesh mesh, float *positions, Image *images, int imagesCount, int workersCount);   // Calculates vertex output values (vec4) of every mesh vertex using worker threads
+FNODEDEF Image BakeFragmentImage(FNodeContext context, int width, int height, Image *images, int imagesCount, int workersCount);   // Calculates fragment output color of every texel of a grid using worker threads
+FNODEDEF bool LoadGraph(FNodeContext context, const char *fileName);                 // Loads nodes and lines from a serialized graph data file
+FNODEDEF bool SaveGraph(FNodeContext context, const char *fileName);                 // Serializes nodes and lines to a graph data file
+FNODEDEF void GenerateShader(FNodeContext context, ShaderVersion version, bool hoistVertex, FString *vertexCode, FString *fragmentCode);   // Generates vertex and fragment shaders code of current nodes
+#if !defined(FNODE_NO_EDITOR)
+FNODEDEF void DrawNode(FNodeContext context, FNode node);                            // Draws a previously created node
+FNODEDEF void DrawNodeLine(FNodeContext context, FLine line);                        // Draws a previously created node line
+FNODEDEF void DrawComment(FNodeContext context, FComment comment);                   // Draws a previously created comment
+#endif
+FNODEDEF void DestroyNode(FNodeContext context, FNode node);                         // Destroys a node and its linked lines
+FNODEDEF void DestroyNodes(FNodeContext context, FNode *nodes, int count);           // Destroys a list of nodes and their linked lines, calculating nodes values once
+FNODEDEF void DestroyNodeLinks(FNodeContext context, FNode node, bool inputs, bool outputs);  // Destroys a node input and output lines, calculating nodes values once
+FNODEDEF void DestroyNodeLine(FNodeContext context, FLine line);                     // Destroys a node line
+FNODEDEF void DestroyComment(FNodeContext context, FComment comment);                // Destroys a comment
+FNODEDEF void CloseFNode(FNodeContext context);                                      // Unitializes a context releasing all its memory
 FNODEDEF void TraceLogFNode(bool error, const char *text, ...);                      // Outputs a trace log message
-FNODEDEF int FSearch(char *filename, char *string);                                  // Returns 1 if a specific string is found in a text file
+FNODEDEF void AppendString(FString *string, const char *text, ...);                  // Appends formatted text to a growable string
+FNODEDEF void UnloadString(FString *string);                                         // Releases a growable string memory
 
 #if defined(__cplusplus)
 }
@@ -225,27 +339,51 @@ FNODEDEF int FSearch(char *filename, char *string);
 
 // Check if custom malloc/free functions defined, if not, using standard ones
 #if !defined(FNODE_MALLOC)
-    #include <stdlib.h>     // Required for: malloc(), free()
+    #include <stdlib.h>     // Required for: malloc(), realloc(), free()
 
     #define     FNODE_MALLOC(size)      malloc(size)            // Memory allocation function as define
+    #define     FNODE_REALLOC(ptr, size) realloc(ptr, size)     // Memory reallocation function as define
     #define     FNODE_FREE(ptr)         free(ptr)               // Memory deallocation function as define
 #endif
 
-#include <stdio.h>              // Required for: FILE, fopen(), fprintf(), fclose(), fscanf(), stdout, vprintf(), sprintf(), fgets()
-#include <string.h>             // Required for: strcat(), strstr()
-#include <math.h>               // Required for: fabs(), sqrt(), sinf(), cosf(), cos(), sin(), tan(), pow(), floor()
+#include <stdio.h>              // Required for: FILE, fopen(), fprintf(), fclose(), fscanf(), stdout, vprintf(), sprintf(), vsnprintf()
+#include <string.h>             // Required for: strcat(), strstr(), memset(), memcpy()
+#include <math.h>               // Required for: fabs(), sqrt(), sinf(), cosf(), cos(), sin(), tan(), pow(), floor(), rint(), signbit()
 #include <stdarg.h>             // Required for: va_list, va_start(), vfprintf(), va_end()
 
-#include "external/glad.h"      // Required for GLAD extensions loading library, includes OpenGL headers
+// Check if editor drawing and OpenGL state functions are built, headless tools only load and compile graphs
+#if !defined(FNODE_NO_EDITOR)
+    #include "external/glad.h"  // Required for GLAD extensions loading library, includes OpenGL headers
+#endif
+
+// Check if x86 SIMD operator kernels can be built, they are selected at runtime based on CPU features
+#if !defined(FNODE_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define FNODE_SIMD_X86
+    #include <immintrin.h>      // Required for: SSE and AVX intrinsics
+#endif
+
+// Check if worker threads can be used to calculate mesh vertices values, a single thread is used otherwise
+#if !defined(FNODE_NO_THREADS) && !defined(_MSC_VER)
+    #define FNODE_THREADS
+    #include <pthread.h>        // Required for: pthread_t, pthread_create(), pthread_join(), pthread_once()
+    #include <unistd.h>         // Required for: sysconf()
+#endif
 
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
-#define     MAX_NODES                       128                     // Max number of nodes
+#define     NODES_POOL_LENGTH               128                     // Nodes pool initial length (doubled when full)
 #define     MAX_NODE_LENGTH                 16                      // Max node output data value text length
-#define     MAX_LINES                       512                     // Max number of lines (8 lines for each node)
-#define     MAX_COMMENTS                    16                      // Max number of comments
+#define     LINES_POOL_LENGTH               512                     // Lines pool initial length (doubled when full)
+#define     COMMENTS_POOL_LENGTH            16                      // Comments pool initial length (doubled when full)
+#define     ARENA_BLOCK_LENGTH              64                      // Slots count of every arena memory block
+#define     BATCH_CHUNK_LENGTH              64                      // Vertices or texels count calculated at once by a batch worker
+#define     BAKE_TILE_SIZE                  8                       // Bake tiles width and height in texels (a tile fills a batch chunk)
+#define     MAX_WORKERS                     16                      // Max number of batch worker threads
 #define     MAX_COMMENT_LENGTH              20                      // Max comment value text length
+#define     STRING_LENGTH                   1024                    // Growable strings initial length (doubled when full)
+#define     MAX_CODE_LENGTH                 512                     // Max generated shader code line length
+#define     MAX_LITERAL_LENGTH              160                     // Max generated float or vector literal length (up to 4 values)
 #define     MIN_COMMENT_SIZE                75                      // Min comment width and height values
 #define     NODE_LINE_DIVISIONS             20                      // Node curved line divisions
 #define     NODE_DATA_WIDTH                 30                      // Node data text width
@@ -259,6 +397,17 @@ FNODEDEF int FSearch(char *filename, char *string);
 #define     UI_TOGGLE_TEXT_PADDING          20                      // Interface toggle text padding
 #define     UI_TOGGLE_BORDER_WIDTH          2                       // Interface toogle border width
 
+#define     ARENA_ALIGN(size)               (((size) + 15) & ~15)   // Rounds a size up to arena slots alignment
+#define     BITSET_WORDS(count)             (((count) + 31)/32)     // Node ids bitset required words
+#define     BITSET_TEST(set, id)            ((set)[(id)/32] & (1u << ((id)%32)))    // Node ids bitset bit state
+#define     BITSET_SET(set, id)             ((set)[(id)/32] |= (1u << ((id)%32)))   // Node ids bitset bit enable
+
+#if defined(FNODE_THREADS)
+    #define FETCH_ADD(pointer, value)       __sync_fetch_and_add(pointer, value)            // Adds a value to a shared integer and returns its previous value
+#else
+    #define FETCH_ADD(pointer, value)       ((*(pointer) += (value)) - (value))
+#endif
+
 #define     COLOR_INPUT_DISABLED_SHAPE      (Color){ 255, 151, 163, 255 }
 #define     COLOR_INPUT_DISABLED_BORDER     (Color){ 199, 4, 10, 255 }
 #define     COLOR_INPUT_ENABLED_SHAPE       (Color){ 151, 232, 255, 255 }
@@ -268,42 +417,132 @@ FNODEDEF int FSearch(char *filename, char *string);
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-// ...
+typedef enum {
+    FOP_LOAD,                               // Loads a node values (constants, uniforms and attributes)
+    FOP_COPY,
+    FOP_ADD,
+    FOP_SUBTRACT,
+    FOP_MULTIPLY,
+    FOP_DIVIDE,
+    FOP_SCALE,                              // Multiplies by first value of a register
+    FOP_SCALEVALUE,                         // Multiplies by instruction immediate value
+    FOP_DIVIDEBY,                           // Divides by first value of a register
+    FOP_MIN,
+    FOP_MAX,
+    FOP_CLAMP01,
+    FOP_MATRIXVECTOR,                       // Transforms destination vector by a matrix register
+    FOP_VECTORMATRIX,                       // Transforms a vector register by destination matrix
+    FOP_MATRIXMULTIPLY,
+    FOP_ONEMINUS,
+    FOP_ABS,
+    FOP_COS,
+    FOP_SIN,
+    FOP_TAN,
+    FOP_RECIPROCAL,
+    FOP_SQRT,
+    FOP_TRUNC,
+    FOP_ROUND,
+    FOP_CEIL,
+    FOP_EXP2,
+    FOP_POWER,
+    FOP_POSTERIZE,
+    FOP_STEP,
+    FOP_LERP,
+    FOP_SMOOTHSTEP,
+    FOP_NORMALIZE,
+    FOP_CROSSPRODUCT,
+    FOP_DESATURATE,
+    FOP_DISTANCE,
+    FOP_DOTPRODUCT,
+    FOP_LENGTH,
+    FOP_TRANSPOSE,
+    FOP_PROJECTION,
+    FOP_REJECTION,
+    FOP_HALFDIRECTION,
+    FOP_SELECT                              // Checks a width selector value still matches the lowered width
+} FOpcode;
+
+typedef struct FInstruction {
+    unsigned char opcode;                   // Operation to execute
+    unsigned char width;                    // Values count the operation works with (resolved when lowering)
+    int dst;                                // Destination register offset
+    int a;                                  // First operand register offset (node index for loads)
+    int b;                                  // Second operand register offset
+    int c;                                  // Third operand register offset
+    float value;                            // Immediate operand value
+} FInstruction;
+
+typedef struct FProgramBlock {
+    int node;                               // Node index whose values are calculated by the block instructions
+    int inputs[MAX_INPUTS];                 // Input nodes indexes
+    int inputsCount;                        // Input nodes indexes count
+    int first;                              // First instruction of the block in the program
+    int count;                              // Instructions count of the block
+    int width;                              // Node output values count resolved when lowering
+    int written;                            // Register values count written by the block instructions (cleared beyond width after execution)
+} FProgramBlock;
+
+typedef struct FKernels {
+    const char *name;                                                   // Kernels instruction set name
+    void (*add)(float *dst, const float *src, int count);               // Adds source values to destination values
+    void (*subtract)(float *dst, const float *src, int count);          // Subtracts source values from destination values
+    void (*multiply)(float *dst, const float *src, int count);          // Multiplies destination values by source values
+    void (*divide)(float *dst, const float *src, int count);            // Divides destination values by source values
+    void (*scale)(float *dst, float value, int count);                  // Multiplies destination values by a value
+    void (*divideBy)(float *dst, float value, int count);               // Divides destination values by a value
+    void (*min)(float *dst, const float *src, int count);               // Keeps the minimum between destination and source values
+    void (*max)(float *dst, const float *src, int count);               // Keeps the maximum between destination and source values
+    void (*clamp)(float *dst, float min, float max, int count);         // Clamps destination values by a min and max values
+    void (*matrixMultiply)(float *dst, const float *left, const float *right);  // Multiplies two matrices (destination can be one of them)
+    void (*matrixVector)(float *vector, const float *matrix);           // Transforms a vector by a matrix
+} FKernels;
+
+typedef struct FBatchWorker {
+    struct FBatch *batch;                   // Batch program and data shared by all workers
+    float *lanes;                           // Worker registers as structure of arrays (BATCH_CHUNK_LENGTH floats per slot value)
+    int next;                               // Next task of worker range (taken by other workers too when they finish their own range)
+    int last;                               // Last task of worker range (not included)
+} FBatchWorker;
+
+typedef struct FBatch {
+    FNode *nodes;                           // Nodes pointers pool of batch graph context
+    bool fragment;                          // Batch calculates fragment output values over a texels grid (vertex output values over mesh vertices otherwise)
+    Mesh mesh;                              // Mesh whose vertices attributes are loaded (vertex batches)
+    float *positions;                       // Vertex output values of every vertex (4 floats per vertex)
+    Image image;                            // Fragment output colors of every texel (fragment batches)
+    Color **pixels;                         // Sampler images pixels indexed by texture unit (NULL if not provided)
+    int *pixelsWidths;                      // Sampler images widths
+    int *pixelsHeights;                     // Sampler images heights
+    int pixelsCount;                        // Sampler images count
+    Image *copies;                          // Sampler images copies converted to 8 bits per channel
+    FInstruction *program;                  // Per-item nodes instructions with registers remapped to batch slots
+    int programCount;                       // Per-item nodes instructions count
+    FProgramBlock *blocks;                  // Per-item nodes blocks copied from lowered program
+    int blocksCount;                        // Per-item nodes blocks count
+    int *slots;                             // Batch slot of every node index (-1 if not needed by output node)
+    int slotsCount;                         // Batch slots count
+    int *invariants;                        // Nodes indexes whose values are the same for every item
+    int *invariantSlots;                    // Batch slot of every invariant node
+    int invariantsCount;                    // Invariant nodes count
+    int outputSlot;                         // Batch slot of the node linked to output node (-1 if not linked)
+    int outputWidth;                        // Values count of the node linked to output node
+    FBatchWorker *workers;                  // Workers whose ranges of tasks can be stolen
+    int workersCount;                       // Workers count
+} FBatch;
+
+typedef enum {
+    INTERPOLATION_UNIFORM,                  // Value is equal over a primitive
+    INTERPOLATION_LINEAR,                   // Value is linear in interpolated vertex attributes
+    INTERPOLATION_NONE                      // Value is not linearly interpolable
+} FInterpolation;
 
 //------------------------------------------------------------------------------------
 // Global Variables Definition
 //------------------------------------------------------------------------------------
-int usedMemory = 0;                         // Total used RAM from memory allocation
-
-int nodesCount = 0;                         // Created nodes count
-FNode nodes[MAX_NODES];                     // Nodes pointers pool
-int selectedNode = -1;                      // Current selected node to drag in canvas
-int editNode = -1;                          // Current edited node data
-int editNodeType = -1;                      // Current edited node data index
-char *editNodeText = NULL;                  // Current edited node data value text before any changes
-
-int linesCount = 0;                         // Created lines count
-FLine lines[MAX_LINES];                     // Lines pointers pool
-int lineState = 0;                          // Current line linking state (0 = waiting for output to link, 1 = output selected, waiting for input to link)
-FLine tempLine = NULL;                      // Temporally created line during line states
-
-int commentsCount = 0;                      // Created comments count
-FComment comments[MAX_COMMENTS];            // Comments pointers pool
-int commentState = 0;                       // Current comment creation state (0 = waiting to create, 1 = waiting to finish creation)
-int selectedComment = -1;                   // Current selected comment to drag in canvas
-int editSize = -1;                          // Current edited comment
-int editSizeType = -1;                      // Current edited comment size (0 = top, 1 = bottom, 2 = left, 3 = right, 4 = top-left, 5 = top-right, 6 = bottom-left, 7 = bottom-right)
-int editComment = -1;                       // Current edited comment value
-int selectedCommentNodes[MAX_NODES];        // Current selected comment nodes ids list to drag
-int selectedCommentNodesCount;              // Current selected comment nodes ids list count
-FComment tempComment = NULL;                // Temporally created comment during comment states
-Vector2 tempCommentPos = { 0, 0 };          // Temporally created comment start position
-Vector2 screenSize = { 1280, 800 };         // Window screen width
-Camera2D camera;                            // Node area 2d camera for panning
-Camera camera3d;                            // Visor camera 3d for model and shader visualization
-bool debugMode = false;                     // Drawing debug information state
-int menuOffset = 0;                         // Interface elements position current offset
-bool interact = true;                       // Buttons and text can interact state
+static FKernels kernels = { 0 };            // Operator kernels selected based on CPU features (shared by all contexts and threads)
+#if defined(FNODE_THREADS)
+static pthread_once_t kernelsOnce = PTHREAD_ONCE_INIT;  // Operator kernels selection state (contexts can be initialized by concurrent threads)
+#endif
 
 //------------------------------------------------------------------------------------
 // Module Internal Functions Declaration
@@ -324,11 +563,7 @@ static Vector2 FVector2Rejection(Vector2 a, Vector2 b);                    // Re
 static Vector3 FVector3Rejection(Vector3 a, Vector3 b);                    // Returns the rejection vector of two Vector3
 static Vector4 FVector4Rejection(Vector4 a, Vector4 b);                    // Returns the rejection vector of two Vector4
 static Vector3 FCrossProduct(Vector3 a, Vector3 b);                        // Returns the cross product of two vectors
-static Matrix FMatrixIdentity();                                           // Returns identity matrix
 static Matrix FMatrixMultiply(Matrix left, Matrix right);                  // Returns the result of multiply two matrices
-static Matrix FMatrixTranslate(float x, float y, float z);                 // Returns translation matrix
-static Matrix FMatrixRotate(Vector3 axis, float angle);                    // Create rotation matrix from axis and angle provided in radians
-static Matrix FMatrixScale(float x, float y, float z);                     // Returns scaling matrix
 static void FMatrixTranspose(Matrix *mat);                                 // Transposes provided matrix
 static void FMultiplyMatrixVector(Vector4 *v, Matrix mat);                 // Transform a quaternion given a transformation matrix
 static float FCos(float value);                                            // Returns the cosine value of a radian angle
@@ -342,51 +577,167 @@ static float FTrunc(float value);                                          // Re
 static float FRound(float value);                                          // Returns a rounded value of a value
 static float FCeil(float value);                                           // Returns a rounded up to the nearest integer of a value
 static float FLerp(float valueA, float valueB, float time);                // Returns the interpolation between two values
-static Vector2 FVector2Lerp(Vector2 valueA, Vector2 valueB, float time);   // Returns the interpolation between two Vector2 values
-static Vector3 FVector3Lerp(Vector3 valueA, Vector3 valueB, float time);   // Returns the interpolation between two Vector3 values
-static Vector4 FVector4Lerp(Vector4 valueA, Vector4 valueB, float time);   // Returns the interpolation between two Vector4 values
 static float FSmoothStep(float min, float max, float value);               // Returns the interpolate of a value in a range
+#if !defined(FNODE_NO_EDITOR)
+static Matrix FMatrixIdentity();                                           // Returns identity matrix
 static float FEaseLinear(float t, float b, float c, float d);              // Returns an ease linear value between two parameters 
 static float FEaseInOutQuad(float t, float b, float c, float d);           // Returns an ease quadratic in-out value between two parameters
+#endif
+
+static int AllocateId(FIdPool *pool);                                      // Returns an unused id from a pool
+static void ReleaseId(FNodeContext context, FIdPool *pool, int id);        // Returns an id to a pool to be used again
+static void ResetIdPool(FNodeContext context, FIdPool *pool);              // Releases all ids of a pool and its allocated memory
+static void *ArenaAlloc(FNodeContext context, FArena *arena);              // Returns an unused slot from an arena
+static void ArenaRelease(FArena *arena, void *slot);                       // Returns a slot to an arena to be used again
+static void ResetArena(FNodeContext context, FArena *arena);               // Releases all slots of an arena and its allocated memory
+static void GrowNodesPool(FNodeContext context);                           // Doubles nodes pool length and its related arrays
+static bool AddNodeLink(FNodeContext context, FLine line);                 // Adds a line to its end node inputs and its start node outputs (false if inputs are full)
+static void RemoveNodeLink(FNodeContext context, FLine line);              // Removes a line from its end node inputs and its start node outputs
+static void RemoveNode(FNodeContext context, FNode node);                  // Removes a node and its linked lines without calculating nodes values
+static void RemoveNodeLinks(FNodeContext context, FNode node, bool inputs, bool outputs);  // Removes a node input and output lines without calculating nodes values
+static void RemoveNodeLine(FNodeContext context, FLine line);              // Removes a line from its nodes and lines pool without calculating nodes values
+static void UpdateEvaluationOrder(FNodeContext context);                   // Sorts nodes by their inputs dependencies
+static void EmitInstruction(FNodeContext context, FOpcode opcode, int width, int dst, int a, int b, int c, float value);    // Adds an instruction to the lowered program
+static int SelectorWidth(float value);                                     // Returns the output values count selected by a vertex color or sampler type value
+static void LowerProgram(FNodeContext context);                            // Lowers nodes in evaluation order into a linear instructions program with resolved widths
+static void ExecuteInstruction(const FInstruction *ins, float *d, const float *a, const float *b, const float *c);   // Executes a lowered instruction over registers values
+static void RunProgram(FNodeContext context, bool all);                    // Executes lowered program blocks whose node or inputs changed, or all of them
+static bool IsNodeVisible(FNodeContext context, FNode node);               // Check if a node shape is inside nodes area camera view
+static void UpdateNodeView(FNode node);                                    // Formats node output values texts and updates its shapes
+
+static void BuildBatch(FNodeContext context, FBatch *batch);               // Remaps output node instructions to batch slots and splits per-item nodes from invariant ones
+static double RunBatch(FBatch *batch, int tasksCount, int workersCount);   // Runs batch tasks on worker threads and returns elapsed time
+static void *RunBatchWorker(void *data);                                   // Runs worker range tasks and then steals remaining tasks from other workers
+static void RunBatchTask(FBatch *batch, float *lanes, int task);           // Calculates output values of a chunk of vertices or a tile of texels
+static void RunBatchChunk(const FBatch *batch, float *lanes, int first, int count, const float *texcoords, bool *discarded);   // Calculates nodes values of a chunk of items
+static void GetBatchOutput(const FBatch *batch, const float *lanes, int lane, float *values);    // Returns output node values of a chunk item converted to a vec4
+static void SampleImage(const FBatch *batch, int unit, float u, float v, float *color);         // Returns a bilinear filtered color of a sampler image with repeat wrapping
+static void LoadBatchImages(FBatch *batch, Image *images, int imagesCount);   // Copies sampler images converted to 8 bits per channel so workers can read their pixels
+static void UnloadBatchImages(FBatch *batch);                              // Releases sampler images copies of a batch
+static void SelectKernels();                                               // Selects the fastest operator kernels supported by current CPU
+static void AddScalar(float *dst, const float *src, int count);            // Adds source values to destination values
+static void SubtractScalar(float *dst, const float *src, int count);       // Subtracts source values from destination values
+static void MultiplyScalar(float *dst, const float *src, int count);       // Multiplies destination values by source values
+static void DivideScalar(float *dst, const float *src, int count);         // Divides destination values by source values
+static void ScaleScalar(float *dst, float value, int count);               // Multiplies destination values by a value
+static void DivideByScalar(float *dst, float value, int count);            // Divides destination values by a value
+static void MinScalar(float *dst, const float *src, int count);            // Keeps the minimum between destination and source values
+static void MaxScalar(float *dst, const float *src, int count);            // Keeps the maximum between destination and source values
+static void ClampScalar(float *dst, float min, float max, int count);      // Clamps destination values by a min and max values
+static void MatrixMultiplyScalar(float *dst, const float *left, const float *right);   // Multiplies two matrices (destination can be one of them)
+static void MatrixVectorScalar(float *vector, const float *matrix);        // Transforms a vector by a matrix
+#if defined(FNODE_SIMD_X86)
+static void AddSSE(float *dst, const float *src, int count);               // Adds source values to destination values (SSE)
+static void SubtractSSE(float *dst, const float *src, int count);          // Subtracts source values from destination values (SSE)
+static void MultiplySSE(float *dst, const float *src, int count);          // Multiplies destination values by source values (SSE)
+static void DivideSSE(float *dst, const float *src, int count);            // Divides destination values by source values (SSE)
+static void ScaleSSE(float *dst, float value, int count);                  // Multiplies destination values by a value (SSE)
+static void DivideBySSE(float *dst, float value, int count);               // Divides destination values by a value (SSE)
+static void MinSSE(float *dst, const float *src, int count);               // Keeps the minimum between destination and source values (SSE)
+static void MaxSSE(float *dst, const float *src, int count);               // Keeps the maximum between destination and source values (SSE)
+static void ClampSSE(float *dst, float min, float max, int count);         // Clamps destination values by a min and max values (SSE)
+static void MatrixMultiplySSE(float *dst, const float *left, const float *right);  // Multiplies two matrices (SSE)
+static void MatrixVectorSSE(float *vector, const float *matrix);           // Transforms a vector by a matrix (SSE)
+static void AddAVX(float *dst, const float *src, int count);               // Adds source values to destination values (AVX)
+static void SubtractAVX(float *dst, const float *src, int count);          // Subtracts source values from destination values (AVX)
+static void MultiplyAVX(float *dst, const float *src, int count);          // Multiplies destination values by source values (AVX)
+static void DivideAVX(float *dst, const float *src, int count);            // Divides destination values by source values (AVX)
+static void ScaleAVX(float *dst, float value, int count);                  // Multiplies destination values by a value (AVX)
+static void DivideByAVX(float *dst, float value, int count);               // Divides destination values by a value (AVX)
+static void MinAVX(float *dst, const float *src, int count);               // Keeps the minimum between destination and source values (AVX)
+static void MaxAVX(float *dst, const float *src, int count);               // Keeps the maximum between destination and source values (AVX)
+static void ClampAVX(float *dst, float min, float max, int count);         // Clamps destination values by a min and max values (AVX)
+static void MatrixMultiplyAVX(float *dst, const float *left, const float *right);  // Multiplies two matrices (AVX)
+#endif
 
+// Operator kernels tables, instruction set tables are only selected when current CPU supports them
+static const FKernels scalarKernels = { "scalar", AddScalar, SubtractScalar, MultiplyScalar, DivideScalar, ScaleScalar, DivideByScalar, MinScalar, MaxScalar, ClampScalar, MatrixMultiplyScalar, MatrixVectorScalar };
+#if defined(FNODE_SIMD_X86)
+static const FKernels sseKernels = { "sse", AddSSE, SubtractSSE, MultiplySSE, DivideSSE, ScaleSSE, DivideBySSE, MinSSE, MaxSSE, ClampSSE, MatrixMultiplySSE, MatrixVectorSSE };
+static const FKernels avxKernels = { "avx", AddAVX, SubtractAVX, MultiplyAVX, DivideAVX, ScaleAVX, DivideByAVX, MinAVX, MaxAVX, ClampAVX, MatrixMultiplyAVX, MatrixVectorSSE };
+#endif
+
+static void FindExpressions(FNodeContext context);                         // Maps each node id to its first structurally identical node id (common subexpressions)
+static int ResolveExpression(FNodeContext context, FNode node, int *table, int tableSize);    // Returns first structurally identical node id of a node, resolving its inputs first
+static unsigned int HashExpression(FNode node, const int *inputs);         // Returns hash of a node expression key (type, resolved inputs and constant values)
+static bool SameExpression(FNodeContext context, FNode node, const int *inputs, FNode other);    // Check if a node expression key is equal to an already resolved node expression
+static void FindConstants(FNodeContext context);                           // Finds nodes with values known at compile time (constant folding)
+static bool FoldNode(FNodeContext context, FNode node);                    // Check if a node values are known at compile time, folding operations over constant inputs
+static bool FoldableOperation(FNodeContext context, FNode node);           // Check if a node operation has the same CPU and GLSL results so its values can be folded
+static void FormatLiteral(char *text, const float *values, int count);     // Writes a GLSL float or vector literal with exact float values
+static void SimplifyExpression(FNodeContext context, FNodeData *expression);    // Removes identity operands of an expression (adding zero, multiplying or dividing by one)
+static bool IsConstantValue(FNodeContext context, int id, float value);    // Check if a node is a compile-time constant with all its values equal to a value
+static bool GetReciprocal(FNodeContext context, int id, float *values);    // Gets reciprocal values of a compile-time constant node if all of them are finite
+static bool ReducedExponent(FNodeContext context, int id);                 // Check if a power exponent node is a constant reduced to multiplications, square root or reciprocal
+static void GetExpression(FNodeContext context, FNode node, FNodeData *expression);    // Gets a node expression with structurally identical and simplified inputs
+static int GetReferencedInputs(FNodeContext context, const FNodeData *expression, int *inputs);    // Gets input node ids whose variables are referenced by an expression generated code
+static int MarkLiveNodes(FNodeContext context, FNode node, unsigned int *live, int *liveIds, int liveCount, bool fragment);    // Marks nodes referenced by a stage generated code, storing them in declaration order
+static bool IsNodeLive(FNodeContext context, const int *liveIds, int liveCount, FNodeType type);    // Check if any live node of a stage has a specific type
+static FInterpolation GetInterpolation(FNodeContext context, FNode node);  // Gets how a node value varies over a primitive (uniform, linear in interpolated attributes or non linear)
+static void FindHoistedNodes(FNodeContext context, FNode node, unsigned int *visited);    // Finds largest linearly interpolable fragment values to compute in vertex stage
+static bool IsNodeHoisted(FNodeContext context, int id);                   // Check if a fragment node value is computed in vertex stage
+static void CheckConstant(FNodeContext context, FNode node, FString *code);    // Check a live node searching for constant values to define them in shaders
+static void CompileNode(FNodeContext context, FNode node, FString *code, unsigned int *declared, bool fragment);    // Compiles a specific node checking its inputs and writing current node operation in shader
+
+#if !defined(FNODE_NO_EDITOR)
 static void FStringToFloat(float *pointer, const char *string);            // Sends a float conversion value of a string to an initialized float pointer
+#endif
 static void FFloatToString(char *buffer, float value);                     // Sends formatted output to an initialized string pointer
 
 //------------------------------------------------------------------------------------
 // Module Functions Definition
 //------------------------------------------------------------------------------------
-// Initializes FNode global variables
-FNODEDEF void InitFNode()
+// Initializes a context which owns a graph and its editing state
+FNODEDEF FNodeContext InitFNode()
 {
-    nodesCount = 0;
-    linesCount = 0;
-    commentsCount = 0;
-    selectedCommentNodesCount = 0;
-    for (int i = 0; i < MAX_NODES; i++) selectedCommentNodes[i] = -1;
-
-    // Initialize OpenGL states
-    SetBackfaceCulling(false);
+    FNodeContext context = (FNodeContext)FNODE_MALLOC(sizeof(FNodeContextData));
+    memset(context, 0, sizeof(FNodeContextData));
+
+    context->nodesArena.slotSize = ARENA_ALIGN(sizeof(FNodeData) + MAX_VALUES*MAX_NODE_LENGTH);
+    context->linesArena.slotSize = ARENA_ALIGN(sizeof(FLineData));
+    context->commentsArena.slotSize = ARENA_ALIGN(sizeof(FCommentData) + MAX_COMMENT_LENGTH);
+    context->selectedNode = -1;
+    context->editNode = -1;
+    context->editNodeType = -1;
+    context->topologyChanged = true;
+    context->shaderVersion = GLSL_330;
+    context->selectedComment = -1;
+    context->editSize = -1;
+    context->editSizeType = -1;
+    context->editComment = -1;
+    context->screenSize = (Vector2){ 1280, 800 };
+    context->interact = true;
+
+#if defined(FNODE_THREADS)
+    pthread_once(&kernelsOnce, SelectKernels);
+#else
+    if (kernels.name == NULL) SelectKernels();
+#endif
 
     TraceLogFNode(false, "initialization complete");
+
+    return context;
 }
 
+#if !defined(FNODE_NO_EDITOR)
 // Set backface culling state in openGL context
 FNODEDEF void SetBackfaceCulling(bool state)
 {
     if (state) glEnable(GL_CULL_FACE);
     else glDisable(GL_CULL_FACE);
 }
+#endif
 
 // Creates a node which returns PI value
-FNODEDEF FNode CreateNodePI()
+FNODEDEF FNode CreateNodePI(FNodeContext context)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(context, false);
 
     newNode->type = FNODE_PI;
     newNode->name = "PI";
     newNode->output.dataCount = 1;
-    newNode->output.data[0].value = PI;
-    FFloatToString(newNode->output.data[0].valueText, newNode->output.data[0].value);
+    newNode->output.data[0] = PI;
+    FFloatToString(newNode->outputView.texts[0], newNode->output.data[0]);
     newNode->inputsLimit = 0;
 
     UpdateNodeShapes(newNode);
@@ -395,15 +746,15 @@ FNODEDEF FNode CreateNodePI()
 }
 
 // Creates a node which returns e value
-FNODEDEF FNode CreateNodeE()
+FNODEDEF FNode CreateNodeE(FNodeContext context)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(context, false);
 
     newNode->type = FNODE_E;
     newNode->name = "e";
     newNode->output.dataCount = 1;
-    newNode->output.data[0].value = 2.71828182845904523536;
-    FFloatToString(newNode->output.data[0].valueText, newNode->output.data[0].value);
+    newNode->output.data[0] = 2.71828182845904523536;
+    FFloatToString(newNode->outputView.texts[0], newNode->output.data[0]);
     newNode->inputsLimit = 0;
 
     UpdateNodeShapes(newNode);
@@ -412,30 +763,30 @@ FNODEDEF FNode CreateNodeE()
 }
 
 // Creates a matrix 4x4 node (OpenGL style 4x4 - right handed, column major)
-FNODEDEF FNode CreateNodeMatrix(Matrix mat)
+FNODEDEF FNode CreateNodeMatrix(FNodeContext context, Matrix mat)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(context, false);
 
     newNode->type = FNODE_MATRIX;
     newNode->name = "Matrix (4x4)";
     newNode->output.dataCount = 16;
-    newNode->output.data[0].value = mat.m0;
-    newNode->output.data[1].value = mat.m1;
-    newNode->output.data[2].value = mat.m2;
-    newNode->output.data[3].value = mat.m3;
-    newNode->output.data[4].value = mat.m4;
-    newNode->output.data[5].value = mat.m5;
-    newNode->output.data[6].value = mat.m6;
-    newNode->output.data[7].value = mat.m7;
-    newNode->output.data[8].value = mat.m8;
-    newNode->output.data[9].value = mat.m9;
-    newNode->output.data[10].value = mat.m10;
-    newNode->output.data[11].value = mat.m11;
-    newNode->output.data[12].value = mat.m12;
-    newNode->output.data[13].value = mat.m13;
-    newNode->output.data[14].value = mat.m14;
-    newNode->output.data[15].value = mat.m15;
-    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->output.data[i].valueText, newNode->output.data[i].value);
+    newNode->output.data[0] = mat.m0;
+    newNode->output.data[1] = mat.m1;
+    newNode->output.data[2] = mat.m2;
+    newNode->output.data[3] = mat.m3;
+    newNode->output.data[4] = mat.m4;
+    newNode->output.data[5] = mat.m5;
+    newNode->output.data[6] = mat.m6;
+    newNode->output.data[7] = mat.m7;
+    newNode->output.data[8] = mat.m8;
+    newNode->output.data[9] = mat.m9;
+    newNode->output.data[10] = mat.m10;
+    newNode->output.data[11] = mat.m11;
+    newNode->output.data[12] = mat.m12;
+    newNode->output.data[13] = mat.m13;
+    newNode->output.data[14] = mat.m14;
+    newNode->output.data[15] = mat.m15;
+    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->outputView.texts[i], newNode->output.data[i]);
     newNode->shape.height = (NODE_DATA_HEIGHT + 5)*newNode->output.dataCount + 5;
     newNode->inputsLimit = 0;
 
@@ -445,15 +796,15 @@ FNODEDEF FNode CreateNodeMatrix(Matrix mat)
 }
 
 // Creates a value node (1 float)
-FNODEDEF FNode CreateNodeValue(float value)
+FNODEDEF FNode CreateNodeValue(FNodeContext context, float value)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(context, false);
 
     newNode->type = FNODE_VALUE;
     newNode->name = "Value";
     newNode->output.dataCount = 1;
-    newNode->output.data[0].value = value;
-    FFloatToString(newNode->output.data[0].valueText, newNode->output.data[0].value);
+    newNode->output.data[0] = value;
+    FFloatToString(newNode->outputView.texts[0], newNode->output.data[0]);
     newNode->inputsLimit = 0;
 
     UpdateNodeShapes(newNode);
@@ -462,16 +813,16 @@ FNODEDEF FNode CreateNodeValue(float value)
 }
 
 // Creates a Vector2 node (2 float)
-FNODEDEF FNode CreateNodeVector2(Vector2 vector)
+FNODEDEF FNode CreateNodeVector2(FNodeContext context, Vector2 vector)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(context, false);
 
     newNode->type = FNODE_VECTOR2;
     newNode->name = "Vector 2";
     newNode->output.dataCount = 2;
-    newNode->output.data[0].value = vector.x;
-    newNode->output.data[1].value = vector.y;
-    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->output.data[i].valueText, newNode->output.data[i].value);
+    newNode->output.data[0] = vector.x;
+    newNode->output.data[1] = vector.y;
+    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->outputView.texts[i], newNode->output.data[i]);
     newNode->shape.height = (NODE_DATA_HEIGHT + 5)*newNode->output.dataCount + 5;
     newNode->inputsLimit = 0;
 
@@ -481,17 +832,17 @@ FNODEDEF FNode CreateNodeVector2(Vector2 vector)
 }
 
 // Creates a Vector3 node (3 float)
-FNODEDEF FNode CreateNodeVector3(Vector3 vector)
+FNODEDEF FNode CreateNodeVector3(FNodeContext context, Vector3 vector)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(context, false);
 
     newNode->type = FNODE_VECTOR3;
     newNode->name = "Vector 3";
     newNode->output.dataCount = 3;
-    newNode->output.data[0].value = vector.x;
-    newNode->output.data[1].value = vector.y;
-    newNode->output.data[2].value = vector.z;
-    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->output.data[i].valueText, newNode->output.data[i].value);
+    newNode->output.data[0] = vector.x;
+    newNode->output.data[1] = vector.y;
+    newNode->output.data[2] = vector.z;
+    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->outputView.texts[i], newNode->output.data[i]);
     newNode->shape.height = (NODE_DATA_HEIGHT + 5)*newNode->output.dataCount + 5;
     newNode->inputsLimit = 0;
 
@@ -501,18 +852,18 @@ FNODEDEF FNode CreateNodeVector3(Vector3 vector)
 }
 
 // Creates a Vector4 node (4 float)
-FNODEDEF FNode CreateNodeVector4(Vector4 vector)
+FNODEDEF FNode CreateNodeVector4(FNodeContext context, Vector4 vector)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(context, false);
 
     newNode->type = FNODE_VECTOR4;
     newNode->name = "Vector 4";
     newNode->output.dataCount = 4;
-    newNode->output.data[0].value = vector.x;
-    newNode->output.data[1].value = vector.y;
-    newNode->output.data[2].value = vector.z;
-    newNode->output.data[3].value = vector.w;
-    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->output.data[i].valueText, newNode->output.data[i].value);
+    newNode->output.data[0] = vector.x;
+    newNode->output.data[1] = vector.y;
+    newNode->output.data[2] = vector.z;
+    newNode->output.data[3] = vector.w;
+    for (int i = 0; i < newNode->output.dataCount; i++) FFloatToString(newNode->outputView.texts[i], newNode->output.data[i]);
     newNode->shape.height = (NODE_DATA_HEIGHT + 5)*newNode->output.dataCount + 5;
     newNode->inputsLimit = 0;
 
@@ -522,9 +873,9 @@ FNODEDEF FNode CreateNodeVector4(Vector4 vector)
 }
 
 // Creates an operator node with type name and inputs limit as parameters
-FNODEDEF FNode CreateNodeOperator(FNodeType type, const char *name, int inputs)
+FNODEDEF FNode CreateNodeOperator(FNodeContext context, FNodeType type, const char *name, int inputs)
 {
-    FNode newNode = InitializeNode(true);
+    FNode newNode = InitializeNode(context, true);
 
     newNode->type = type;
     newNode->name = name;
@@ -536,9 +887,9 @@ FNODEDEF FNode CreateNodeOperator(FNodeType type, const char *name, int inputs)
 }
 
 // Creates an uniform node with type name and data count as parameters
-FNODEDEF FNode CreateNodeUniform(FNodeType type, const char *name, int dataCount)
+FNODEDEF FNode CreateNodeUniform(FNodeContext context, FNodeType type, const char *name, int dataCount)
 {
-    FNode newNode = InitializeNode(false);
+    FNode newNode = InitializeNode(context, false);
 
     newNode->type = type;
     newNode->name = name;
@@ -550,9 +901,9 @@ FNODEDEF FNode CreateNodeUniform(FNodeType type, const char *name, int dataCount
 }
 
 // Creates a property node with type name and data count as parameters
-FNODEDEF FNode CreateNodeProperty(FNodeType type, const char *name, int dataCount, int inputs)
+FNODEDEF FNode CreateNodeProperty(FNodeContext context, FNodeType type, const char *name, int dataCount, int inputs)
 {
-    FNode newNode = InitializeNode((inputs > 0));
+    FNode newNode = InitializeNode(context, (inputs > 0));
 
     newNode->type = type;
     newNode->name = name;
@@ -566,9 +917,9 @@ FNODEDEF FNode CreateNodeProperty(FNodeType type, const char *name, int dataCoun
 }
 
 // Creates the main node that contains final material attributes
-FNODEDEF FNode CreateNodeMaterial(FNodeType type, const char *name, int dataCount)
+FNODEDEF FNode CreateNodeMaterial(FNodeContext context, FNodeType type, const char *name, int dataCount)
 {
-    FNode newNode = InitializeNode(true);
+    FNode newNode = InitializeNode(context, true);
 
     newNode->type = type;
     newNode->name = name;
@@ -582,170 +933,183 @@ FNODEDEF FNode CreateNodeMaterial(FNodeType type, const char *name, int dataCoun
 }
 
 // Initializes a new node with generic parameters
-FNODEDEF FNode InitializeNode(bool isOperator)
+FNODEDEF FNode InitializeNode(FNodeContext context, bool isOperator)
 {
-    FNode newNode = (FNode)FNODE_MALLOC(sizeof(FNodeData));
-    usedMemory += sizeof(FNodeData);
+    FNode newNode = (FNode)ArenaAlloc(context, &context->nodesArena);
+    char *valuesText = (char *)newNode + sizeof(FNodeData);     // Values text storage placed after node data in its arena slot
 
-    int id = -1;
-    for (int i = 0; i < MAX_NODES; i++)
-    {
-        int currentId = i;
-
-        // Check if current id already exist in other node
-        for (int k = 0; k < nodesCount; k++)
-        {
-            if (nodes[k]->id == currentId)
-            {
-                currentId++;
-                break;
-            }
-        }
-
-        // If not exist, set it as new node id
-        if (currentId == i)
-        {
-            id = i;
-            break;
-        }
-    }
+    if (context->nodesCount == context->nodesLimit) GrowNodesPool(context);
 
     // Initialize node id
-    if (id != -1) newNode->id = id;
-    else TraceLogFNode(true, "node creation failed because there is any available id");
+    newNode->id = AllocateId(&context->nodesIds);
 
     // Initialize node inputs and inputs count
-    for (int i = 0; i < MAX_INPUTS; i++) newNode->inputs[i] = -1;
+    for (int i = 0; i < MAX_INPUTS; i++)
+    {
+        newNode->inputs[i] = -1;
+        newNode->inputLines[i] = NULL;
+    }
+
     newNode->inputsCount = 0;
     newNode->inputsLimit = MAX_INPUTS;
+    newNode->outputs = NULL;
+    newNode->outputsCount = 0;
+    newNode->outputsLimit = 0;
     newNode->property = false;
+    newNode->dirty = true;
 
     // Initialize shapes
-    newNode->shape = (Rectangle){ GetRandomValue(-camera.offset.x + 0, -camera.offset.x + screenSize.x*0.85f - 50*4), GetRandomValue(-camera.offset.y + screenSize.y/2 - 20 - 100, camera.offset.y + screenSize.y/2 - 20 + 100), 10 + NODE_DATA_WIDTH, 40 };
+#if !defined(FNODE_NO_EDITOR)
+    newNode->shape = (Rectangle){ GetRandomValue(-context->camera.offset.x + 0, -context->camera.offset.x + context->screenSize.x*0.85f - 50*4), GetRandomValue(-context->camera.offset.y + context->screenSize.y/2 - 20 - 100, context->camera.offset.y + context->screenSize.y/2 - 20 + 100), 10 + NODE_DATA_WIDTH, 40 };
+#else
+    newNode->shape = (Rectangle){ 0, 0, 10 + NODE_DATA_WIDTH, 40 };  // Nodes are not placed on screen without editor
+#endif
     if (isOperator) newNode->inputShape = (Rectangle){ 0, 0, 20, 20 };
     else newNode->inputShape = (Rectangle){ 0, 0, 0, 0 };
     newNode->outputShape = (Rectangle){ 0, 0, 20, 20 };
 
     // Initialize node output and output values count
     newNode->output.dataCount = 0;
+    memset(valuesText, '\0', MAX_VALUES*MAX_NODE_LENGTH);
+    newNode->outputView.stale = false;
 
     for (int i = 0; i < MAX_VALUES; i++)
     {
-        newNode->output.data[i].value = 0.0f;
-        newNode->output.data[i].shape = (Rectangle){ 0, 0, NODE_DATA_WIDTH, NODE_DATA_HEIGHT };
-        newNode->output.data[i].valueText = (char *)FNODE_MALLOC(MAX_NODE_LENGTH);
-        usedMemory += MAX_NODE_LENGTH;
-        for (int k = 0; k < MAX_NODE_LENGTH; k++) newNode->output.data[i].valueText[k] = '\0';
+        newNode->output.data[i] = 0.0f;
+        newNode->outputView.shapes[i] = (Rectangle){ 0, 0, NODE_DATA_WIDTH, NODE_DATA_HEIGHT };
+        newNode->outputView.texts[i] = valuesText + i*MAX_NODE_LENGTH;
     }
 
-    nodes[nodesCount] = newNode;
-    nodesCount++;
+    context->nodes[context->nodesCount] = newNode;
+    context->nodesIndex[newNode->id] = context->nodesCount;
+    context->nodesCount++;
+    context->topologyChanged = true;
 
-    TraceLogFNode(false, "created new node id %i (index: %i) [USED RAM: %i bytes]", newNode->id, (nodesCount - 1), usedMemory);
+    TraceLogFNode(false, "created new node id %i (index: %i) [USED RAM: %i bytes]", newNode->id, (context->nodesCount - 1), context->usedMemory);
 
     return newNode;
 }
 
 // Returns the index of a node searching by its id
-FNODEDEF int GetNodeIndex(int id)
+FNODEDEF int GetNodeIndex(FNodeContext context, int id)
 {
     int output = -1;
 
-    for (int i = 0; i < nodesCount; i++)
-    {
-        if (nodes[i]->id == id)
-        {
-            output = i;
-            break;
-        }
-    }
+    if ((id >= 0) && (id < context->nodesLimit)) output = context->nodesIndex[id];
 
     if (output == -1) TraceLogFNode(true, "error when trying to find a node index by its id");
 
     return output;
 }
 
-// Creates a line between two nodes
-FNODEDEF FLine CreateNodeLine(int from)
+// Check if a node can be reached from another node following their linked outputs
+FNODEDEF bool IsNodeReachable(FNodeContext context, int from, int to)
 {
-    FLine newLine = (FLine)FNODE_MALLOC(sizeof(FLineData));
-    usedMemory += sizeof(FLineData);
+    if (from == to) return true;
 
-    int id = -1;
-    for (int i = 0; i < MAX_LINES; i++)
+    int *stack = (int *)FNODE_MALLOC(context->nodesCount*sizeof(int));            // Depth-first search nodes indexes stack
+    bool *visited = (bool *)FNODE_MALLOC(context->nodesCount*sizeof(bool));       // Node was already pushed to stack
+    int stackCount = 0;
+    bool reached = false;
+
+    for (int i = 0; i < context->nodesCount; i++) visited[i] = false;
+
+    stack[0] = GetNodeIndex(context, from);
+    visited[stack[0]] = true;
+    stackCount = 1;
+
+    while ((stackCount > 0) && !reached)
     {
-        int currentId = i;
+        FNode current = context->nodes[stack[stackCount - 1]];
+        stackCount--;
 
-        // Check if current id already exist in other line
-        for (int k = 0; k < linesCount; k++)
+        for (int i = 0; i < current->outputsCount; i++)
         {
-            if (lines[k]->id == currentId)
+            if (current->outputs[i] == to)
             {
-                currentId++;
+                reached = true;
                 break;
             }
-        }
 
-        // If not exist, set it as new line id
-        if (currentId == i)
-        {
-            id = i;
-            break;
+            int output = GetNodeIndex(context, current->outputs[i]);
+
+            if (!visited[output])
+            {
+                visited[output] = true;
+                stack[stackCount] = output;
+                stackCount++;
+            }
         }
     }
 
+    FNODE_FREE(stack);
+    FNODE_FREE(visited);
+
+    return reached;
+}
+
+// Creates a line between two nodes (end node id is -1 while linking)
+FNODEDEF FLine CreateNodeLine(FNodeContext context, int from, int to)
+{
+    FLine newLine = (FLine)ArenaAlloc(context, &context->linesArena);
+
+    // Grow lines pool when it is full
+    if (context->linesCount == context->linesLimit)
+    {
+        int limit = ((context->linesLimit > 0) ? context->linesLimit*2 : LINES_POOL_LENGTH);
+
+        context->lines = (FLine *)FNODE_REALLOC(context->lines, limit*sizeof(FLine));
+        context->usedMemory += (limit - context->linesLimit)*sizeof(FLine);
+        context->linesLimit = limit;
+    }
+
     // Initialize line id
-    if (id != -1) newLine->id = id;
-    else TraceLogFNode(true, "line creation failed because there is any available id");
+    newLine->id = AllocateId(&context->linesIds);
 
-    // Initialize line input
+    // Initialize line input and output
     newLine->from = from;
-    newLine->to = -1;
+    newLine->to = to;
+
+    // Discard the line when its end node inputs are full, so every linked line is counted in its nodes
+    if ((to != -1) && !AddNodeLink(context, newLine))
+    {
+        ReleaseId(context, &context->linesIds, newLine->id);
+        ArenaRelease(&context->linesArena, newLine);
+        return NULL;
+    }
+
+    newLine->index = context->linesCount;
+    context->lines[context->linesCount] = newLine;
+    context->linesCount++;
 
-    lines[linesCount] = newLine;
-    linesCount++;
+    if (to != -1) context->topologyChanged = true;
+    else context->pendingLinesCount++;
 
-    TraceLogFNode(false, "created new line id %i (index: %i) [USED RAM: %i bytes]", newLine->id, (linesCount - 1), usedMemory);
+    TraceLogFNode(false, "created new line id %i (index: %i) [USED RAM: %i bytes]", newLine->id, (context->linesCount - 1), context->usedMemory);
 
     return newLine;
 }
 
 // Creates a comment
-FNODEDEF FComment CreateComment()
+FNODEDEF FComment CreateComment(FNodeContext context)
 {
-    FComment newComment = (FComment)FNODE_MALLOC(sizeof(FCommentData));
-    usedMemory += sizeof(FCommentData);
+    FComment newComment = (FComment)ArenaAlloc(context, &context->commentsArena);
 
-    int id = -1;
-    for (int i = 0; i < MAX_COMMENTS; i++)
+    // Grow comments pool when it is full
+    if (context->commentsCount == context->commentsLimit)
     {
-        int currentId = i;
-
-        // Check if current id already exist in other comment
-        for (int k = 0; k < commentsCount; k++)
-        {
-            if (comments[k]->id == currentId)
-            {
-                currentId++;
-                break;
-            }
-        }
+        int limit = ((context->commentsLimit > 0) ? context->commentsLimit*2 : COMMENTS_POOL_LENGTH);
 
-        // If not exist, set it as new comment id
-        if (currentId == i)
-        {
-            id = i;
-            break;
-        }
+        context->comments = (FComment *)FNODE_REALLOC(context->comments, limit*sizeof(FComment));
+        context->usedMemory += (limit - context->commentsLimit)*sizeof(FComment);
+        context->commentsLimit = limit;
     }
 
     // Initialize comment id
-    if (id != -1) newComment->id = id;
-    else TraceLogFNode(true, "comment creation failed because there is any available id");
+    newComment->id = AllocateId(&context->commentsIds);
 
     // Initialize comment input
-    newComment->value = (char *)FNODE_MALLOC(MAX_COMMENT_LENGTH);
-    usedMemory += MAX_COMMENT_LENGTH;
+    newComment->value = (char *)newComment + sizeof(FCommentData);
     for (int i = 0; i < MAX_COMMENT_LENGTH; i++)
     {
         if (i == 0) newComment->value[i] = 'C';
@@ -771,10 +1135,10 @@ FNODEDEF FComment CreateComment()
     newComment->sizeBlShape = (Rectangle){ 0, 0, 10, 10 };
     newComment->sizeBrShape = (Rectangle){ 0, 0, 10, 10 };
 
-    comments[commentsCount] = newComment;
-    commentsCount++;
+    context->comments[context->commentsCount] = newComment;
+    context->commentsCount++;
 
-    TraceLogFNode(false, "created new comment id %i (index: %i) [USED RAM: %i bytes]", newComment->id, (commentsCount - 1), usedMemory);
+    TraceLogFNode(false, "created new comment id %i (index: %i) [USED RAM: %i bytes]", newComment->id, (context->commentsCount - 1), context->usedMemory);
 
     return newComment;
 }
@@ -831,14 +1195,19 @@ FNODEDEF void UpdateNodeShapes(FNode node)
         int currentLength = 0;
         for (int i = 0; i < node->output.dataCount; i++)
         {
-            node->output.data[i].shape.x = node->shape.x + 5;
-            node->output.data[i].shape.width = NODE_DATA_WIDTH;
-            node->output.data[i].shape.width += MeasureText(node->output.data[i].valueText, 20);
+            int length = 0;
 
-            if (i == 0) node->output.data[i].shape.y = node->shape.y + 5;
-            else node->output.data[i].shape.y = node->output.data[i - 1].shape.y + node->output.data[i - 1].shape.height + 5;
+#if !defined(FNODE_NO_EDITOR)
+            // Values texts are only measured when there is a window to draw them
+            length = MeasureText(node->outputView.texts[i], 20);
+#endif
+
+            node->outputView.shapes[i].x = node->shape.x + 5;
+            node->outputView.shapes[i].width = NODE_DATA_WIDTH + length;
+
+            if (i == 0) node->outputView.shapes[i].y = node->shape.y + 5;
+            else node->outputView.shapes[i].y = node->outputView.shapes[i - 1].y + node->outputView.shapes[i - 1].height + 5;
 
-            int length = MeasureText(node->output.data[i].valueText, 20);
             if (length > currentLength)
             {
                 index = i;
@@ -848,18 +1217,20 @@ FNODEDEF void UpdateNodeShapes(FNode node)
 
         node->shape.width = 10 + NODE_DATA_WIDTH;
 
-        if (index != -1) node->shape.width += MeasureText(node->output.data[index].valueText, 20);
+        if (index != -1) node->shape.width += currentLength;
+#if !defined(FNODE_NO_EDITOR)
         else if (node->output.dataCount > 0)
         {
             bool isError = false;
 
             for (int i = 0; i < node->output.dataCount; i++)
             {
-                if (node->output.data[i].valueText[0] != '\0') isError = true;
+                if (node->outputView.texts[i][0] != '\0') isError = true;
             }
 
             if (isError) TraceLogFNode(true, "error trying to calculate node data longest value");
         }
+#endif
 
         if (node->type >= FNODE_MATRIX) node->shape.height = ((node->output.dataCount == 0) ? (NODE_DATA_HEIGHT/2 + 10) : ((NODE_DATA_HEIGHT + 5)*node->output.dataCount + 5));
 
@@ -877,11 +1248,11 @@ FNODEDEF void UpdateNodeShapes(FNode node)
 }
 
 // Updates a comment shapes due to drag behaviour
-FNODEDEF void UpdateCommentShapes(FComment comment)
+FNODEDEF void UpdateCommentShapes(FNodeContext context, FComment comment)
 {
     if (comment != NULL)
     {
-        if (commentState == 0)
+        if (context->commentState == 0)
         {
             if (comment->shape.width < MIN_COMMENT_SIZE) comment->shape.width = MIN_COMMENT_SIZE;
             if (comment->shape.height < MIN_COMMENT_SIZE) comment->shape.height = MIN_COMMENT_SIZE;
@@ -922,797 +1293,564 @@ FNODEDEF Rectangle CameraToViewRec(Rectangle rec, Camera2D camera)
 }
 
 // Calculates nodes output values based on current inputs
-FNODEDEF void CalculateValues()
+FNODEDEF void CalculateValues(FNodeContext context)
 {
-    for (int i = 0; i < nodesCount; i++)
+    // Evaluation order and its lowered program are only rebuilt when nodes or lines were created or destroyed
+    bool lowered = context->topologyChanged;
+
+    if (lowered)
     {
-        if (nodes[i] != NULL)
-        {
-            // Reset node inputs values and inputs count
-            for (int k = 0; k < MAX_INPUTS; k++) nodes[i]->inputs[k] = -1;
-            nodes[i]->inputsCount = 0;
+        UpdateEvaluationOrder(context);
+        LowerProgram(context);
+    }
 
-            // Search for node inputs and calculate inputs count
-            for (int k = 0; k < linesCount; k++)
-            {
-                if (lines[k] != NULL)
-                {
-                    // Check if line output (to) is the node input id
-                    if (lines[k]->to == nodes[i]->id)
-                    {
-                        nodes[i]->inputs[nodes[i]->inputsCount] = lines[k]->from;
-                        nodes[i]->inputsCount++;
-                    }
-                }
-            }
+    for (int i = 0; i < context->nodesCount; i++) context->nodesChanged[i] = false;
 
-            // Check if current node is an operator
-            if (nodes[i]->type > FNODE_VECTOR4 && nodes[i]->type < FNODE_APPEND)
-            {
-                // Calculate output values count based on first input node value count
-                if (nodes[i]->inputsCount > 0) 
-                {
-                    // Get which index has the first input node id from current nude
-                    int index = GetNodeIndex(nodes[i]->inputs[0]);
+    // A new program starts with empty registers, so all its blocks are executed once
+    RunProgram(context, lowered);
 
-                    nodes[i]->output.dataCount = nodes[index]->output.dataCount;
-                    for (int k = 0; k < nodes[i]->output.dataCount; k++) nodes[i]->output.data[k].value = nodes[index]->output.data[k].value;
+    // Lower the program again when a width selector value changed and run it from the start
+    while (context->programStale)
+    {
+        LowerProgram(context);
+        RunProgram(context, true);
+    }
+}
 
-                    for (int k = 1; k < nodes[i]->inputsCount; k++)
-                    {
-                        int inputIndex = GetNodeIndex(nodes[i]->inputs[k]);
+// Marks a node to calculate its values and the values of its linked nodes again
+FNODEDEF void SetNodeDirty(FNode node)
+{
+    if (node != NULL) node->dirty = true;
+    else TraceLogFNode(true, "error trying to mark a null referenced node");
+}
 
-                        // Apply inputs values to output based on node operation type
-                        switch (nodes[i]->type)
-                        {
-                            case FNODE_ADD:
-                            {
-                                for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value += nodes[inputIndex]->output.data[j].value;
-                            } break;
-                            case FNODE_SUBTRACT:
-                            {
-                                for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value -= nodes[inputIndex]->output.data[j].value;
-                            } break;
-                            case FNODE_MULTIPLY:
-                            {
-                                if (nodes[inputIndex]->output.dataCount == 1)
-                                {
-                                    for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value *= nodes[inputIndex]->output.data[0].value;
-                                }
-                                else
-                                {
-                                    for (int j = 0; j < nodes[i]->output.dataCount; j++)
-                                    {
-                                        if (nodes[inputIndex]->output.dataCount == 16 && nodes[i]->output.dataCount == 4)
-                                        {
-                                            Vector4 vector = { nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value, nodes[i]->output.data[3].value };
-                                            Matrix matrix = { nodes[inputIndex]->output.data[4].value, nodes[inputIndex]->output.data[5].value, nodes[inputIndex]->output.data[6].value, nodes[inputIndex]->output.data[7].value,
-                                            nodes[inputIndex]->output.data[8].value, nodes[inputIndex]->output.data[9].value, nodes[inputIndex]->output.data[10].value, nodes[inputIndex]->output.data[11].value,
-                                            nodes[inputIndex]->output.data[12].value, nodes[inputIndex]->output.data[13].value, nodes[inputIndex]->output.data[14].value, nodes[inputIndex]->output.data[15].value };
-                                            FMultiplyMatrixVector(&vector, matrix);
-
-                                            for (int k = 0; k < MAX_VALUES; k++) nodes[i]->output.data[k].value = 0.0f;
-                                            nodes[i]->output.data[0].value = vector.x;
-                                            nodes[i]->output.data[1].value = vector.y;
-                                            nodes[i]->output.data[2].value = vector.z;
-                                            nodes[i]->output.data[3].value = vector.w;
-                                            nodes[i]->output.dataCount = 4;
-                                        }
-                                        else if (nodes[inputIndex]->output.dataCount == 4 && nodes[i]->output.dataCount == 16)
-                                        {
-                                            Vector4 vector = { nodes[inputIndex]->output.data[0].value, nodes[inputIndex]->output.data[1].value, nodes[inputIndex]->output.data[2].value, nodes[inputIndex]->output.data[3].value };
-                                            Matrix matrix = { nodes[i]->output.data[4].value, nodes[i]->output.data[5].value, nodes[i]->output.data[6].value, nodes[i]->output.data[7].value,
-                                            nodes[i]->output.data[8].value, nodes[i]->output.data[9].value, nodes[i]->output.data[10].value, nodes[i]->output.data[11].value,
-                                            nodes[i]->output.data[12].value, nodes[i]->output.data[13].value, nodes[i]->output.data[14].value, nodes[i]->output.data[15].value };
-                                            FMultiplyMatrixVector(&vector, matrix);
-
-                                            for (int k = 0; k < MAX_VALUES; k++) nodes[i]->output.data[k].value = 0.0f;
-                                            nodes[i]->output.data[0].value = vector.x;
-                                            nodes[i]->output.data[1].value = vector.y;
-                                            nodes[i]->output.data[2].value = vector.z;
-                                            nodes[i]->output.data[3].value = vector.w;
-                                            nodes[i]->output.dataCount = 4;
-                                        }
-                                        else nodes[i]->output.data[j].value *= nodes[inputIndex]->output.data[j].value;
-                                    }
-                                }
-                            } break;
-                            case FNODE_DIVIDE:
-                            {
-                                if (nodes[inputIndex]->output.dataCount == 1)
-                                {
-                                    for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value /= nodes[inputIndex]->output.data[0].value;
-                                }
-                                else
-                                {
-                                    for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value /= nodes[inputIndex]->output.data[j].value;
-                                }
-                            } break;
-                            default: break;
-                        }
-                    }
-                }
-                else
-                {
-                    for (int k = 0; k < MAX_VALUES; k++) nodes[i]->output.data[k].value = 0.0f;
-                    nodes[i]->output.dataCount = 0;
-                }
-            }
-            else if (nodes[i]->type == FNODE_APPEND)
-            {
-                if (nodes[i]->inputsCount > 0)
-                {
-                    int valuesCount = 0;
-                    for (int k = 0; k < nodes[i]->inputsCount; k++)
-                    {
-                        int inputIndex = GetNodeIndex(nodes[i]->inputs[k]);
+// Calculates vertex output values (vec4) of every mesh vertex using worker threads
+FNODEDEF void EvaluateMeshVertices(FNodeContext context, Mesh mesh, float *positions, Image *images, int imagesCount, int workersCount)
+{
+    if ((mesh.vertexCount <= 0) || (mesh.vertices == NULL) || (positions == NULL))
+    {
+        TraceLogFNode(false, "error trying to calculate vertices values of an empty mesh");
+        return;
+    }
 
-                        for (int j = 0; j < nodes[inputIndex]->output.dataCount; j++)
-                        {
-                            nodes[i]->output.data[valuesCount].value = nodes[inputIndex]->output.data[j].value;
-                            valuesCount++;
-                        }
-                    }
+    // Nodes which are the same for every vertex keep current calculated values
+    CalculateValues(context);
 
-                    nodes[i]->output.dataCount = valuesCount;
-                }
-                else
-                {
-                    for (int k = 0; k < MAX_VALUES; k++) nodes[i]->output.data[k].value = 0.0f;
-                    nodes[i]->output.dataCount = 0;
-                }
-            }
-            else if (nodes[i]->type > FNODE_APPEND)
-            {
-                if (nodes[i]->inputsCount > 0)
-                {
-                    int index = GetNodeIndex(nodes[i]->inputs[0]);
+    FBatch batch = { 0 };
+    batch.mesh = mesh;
+    batch.positions = positions;
+    BuildBatch(context, &batch);
+    LoadBatchImages(&batch, images, imagesCount);
 
-                    nodes[i]->output.dataCount = nodes[index]->output.dataCount;
-                    for (int k = 0; k < nodes[i]->output.dataCount; k++) nodes[i]->output.data[k].value = nodes[index]->output.data[k].value;
+    int chunksCount = (mesh.vertexCount + BATCH_CHUNK_LENGTH - 1)/BATCH_CHUNK_LENGTH;
+    double elapsedTime = RunBatch(&batch, chunksCount, workersCount);
 
-                    switch (nodes[i]->type)
-                    {
-                        case FNODE_ONEMINUS:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = 1 - nodes[i]->output.data[j].value;
-                        } break;
-                        case FNODE_ABS:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++)
-                            {
-                                if (nodes[i]->output.data[j].value < 0) nodes[i]->output.data[j].value *= -1;
-                            }
-                        } break;
-                        case FNODE_COS:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = (float)FCos(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_SIN:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = (float)FSin(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_TAN:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = (float)FTan(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_DEG2RAD:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value *= DEG2RAD;
-                        } break;
-                        case FNODE_RAD2DEG:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value *= RAD2DEG;
-                        } break;
-                        case FNODE_NORMALIZE:
-                        {
-                            switch (nodes[i]->output.dataCount)
-                            {
-                                case 2:
-                                {
-                                    Vector2 temp = { nodes[i]->output.data[0].value, nodes[i]->output.data[1].value };
-                                    temp = FVector2Normalize(temp);
-                                    nodes[i]->output.data[0].value = temp.x;
-                                    nodes[i]->output.data[1].value = temp.y;
-                                } break;
-                                case 3:
-                                {
-                                    Vector3 temp = { nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value };
-                                    temp = FVector3Normalize(temp);
-                                    nodes[i]->output.data[0].value = temp.x;
-                                    nodes[i]->output.data[1].value = temp.y;
-                                    nodes[i]->output.data[2].value = temp.z;
-                                } break;
-                                case 4:
-                                {
-                                    Vector4 temp = { nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value, nodes[i]->output.data[3].value };
-                                    temp = FVector4Normalize(temp);
-                                    nodes[i]->output.data[0].value = temp.x;
-                                    nodes[i]->output.data[1].value = temp.y;
-                                    nodes[i]->output.data[2].value = temp.z;
-                                    nodes[i]->output.data[3].value = temp.w;
-                                } break;
-                                default: break;
-                            }
-                        } break;
-                        case FNODE_NEGATE:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value *= -1;
-                        } break;
-                        case FNODE_RECIPROCAL:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = 1/nodes[i]->output.data[j].value;
-                        } break;
-                        case FNODE_SQRT:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FSquareRoot(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_TRUNC:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FTrunc(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_ROUND:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FRound(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_VERTEXCOLOR:
-                        {
-                            if (nodes[i]->inputsCount == 1)
-                            {
-                                int index = GetNodeIndex(nodes[i]->inputs[0]);
-                                switch ((int)nodes[index]->output.data[0].value)
-                                {
-                                    case 0: nodes[i]->output.dataCount = 4; break;
-                                    case 1: nodes[i]->output.dataCount = 3; break;
-                                    default: nodes[i]->output.dataCount = 1; break;
-                                }
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        }
-                        case FNODE_CEIL:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FCeil(nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_CLAMP01:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FClamp(nodes[i]->output.data[j].value, 0.0f, 1.0f);
-                        } break;
-                        case FNODE_EXP2:
-                        {
-                            for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FPower(2.0f, nodes[i]->output.data[j].value);
-                        } break;
-                        case FNODE_POWER:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int expIndex = GetNodeIndex(nodes[i]->inputs[1]);
+    TraceLogFNode(false, "calculated %i vertices values with %i workers (%.0f vertices/s)", mesh.vertexCount, batch.workersCount, ((elapsedTime > 0) ? mesh.vertexCount/elapsedTime : 0.0));
 
-                                if (nodes[expIndex]->output.dataCount == 1)
-                                {
-                                    for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FPower(nodes[i]->output.data[j].value, nodes[expIndex]->output.data[0].value);
-                                }
-                                else TraceLogFNode(false, "values count of node %i should be 1 because it is an exponent (currently count: %i)", nodes[expIndex]->id, nodes[expIndex]->output.dataCount);
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_STEP:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
+    UnloadBatchImages(&batch);
+    FNODE_FREE(batch.program);
+    FNODE_FREE(batch.blocks);
+    FNODE_FREE(batch.slots);
+    FNODE_FREE(batch.invariants);
+    FNODE_FREE(batch.invariantSlots);
+}
 
-                                if (nodes[indexB]->output.dataCount == 1) nodes[i]->output.data[0].value = ((nodes[i]->output.data[0].value <= nodes[indexB]->output.data[0].value) ? 1.0f : 0.0f);
-                                else TraceLogFNode(false, "values count of node %i should be 1 because it is an exponent (currently count: %i)", nodes[indexB]->id, nodes[indexB]->output.dataCount);
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_POSTERIZE:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int expIndex = GetNodeIndex(nodes[i]->inputs[1]);
+// Calculates fragment output color of every texel of a grid using worker threads
+FNODEDEF Image BakeFragmentImage(FNodeContext context, int width, int height, Image *images, int imagesCount, int workersCount)
+{
+    if ((width <= 0) || (height <= 0))
+    {
+        TraceLogFNode(false, "error trying to bake an image with invalid size (%ix%i)", width, height);
+        return (Image){ 0 };
+    }
 
-                                if (nodes[expIndex]->output.dataCount == 1)
-                                {
-                                    for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FPosterize(nodes[i]->output.data[j].value, nodes[expIndex]->output.data[0].value);
-                                }
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_MAX:
-                        case FNODE_MIN:
-                        {
-                            for (int j = 1; j < nodes[i]->inputsCount; j++)
-                            {
-                                int inputIndex = GetNodeIndex(nodes[i]->inputs[j]);
+    // Nodes which are the same for every texel keep current calculated values
+    CalculateValues(context);
 
-                                for (int k = 0; k < nodes[i]->output.dataCount; k++)
-                                {
-                                    if ((nodes[inputIndex]->output.data[k].value > nodes[i]->output.data[k].value) && (nodes[i]->type == FNODE_MAX)) nodes[i]->output.data[k].value = nodes[inputIndex]->output.data[k].value;
-                                    else if ((nodes[inputIndex]->output.data[k].value < nodes[i]->output.data[k].value) && (nodes[i]->type == FNODE_MIN)) nodes[i]->output.data[k].value = nodes[inputIndex]->output.data[k].value;
-                                }
-                            }
-                        } break;
-                        case FNODE_LERP:
-                        {                                
-                            if (nodes[i]->inputsCount == 3)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
-                                int indexC = GetNodeIndex(nodes[i]->inputs[2]);
+    FBatch batch = { 0 };
+    batch.fragment = true;
+    batch.image = GenImageColor(width, height, BLANK);
+    BuildBatch(context, &batch);
+    LoadBatchImages(&batch, images, imagesCount);
 
-                                switch (nodes[i]->output.dataCount)
-                                {
-                                    case 1:
-                                    {
-                                        for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FLerp(nodes[indexA]->output.data[j].value, nodes[indexB]->output.data[j].value, nodes[indexC]->output.data[j].value);
-                                    } break;
-                                    case 2:
-                                    {
-                                        Vector2 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value };
-                                        Vector2 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value };
-                                        Vector2 lerp = FVector2Lerp(vectorA, vectorB, nodes[indexC]->output.data[0].value);
-
-                                        nodes[i]->output.dataCount = 2;
-                                        nodes[i]->output.data[0].value = lerp.x;
-                                        nodes[i]->output.data[1].value = lerp.y;
-                                    } break;
-                                    case 3:
-                                    {
-                                        Vector3 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value };
-                                        Vector3 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexA]->output.data[2].value };
-                                        Vector3 lerp = FVector3Lerp(vectorA, vectorB, nodes[indexC]->output.data[0].value);
-
-                                        nodes[i]->output.dataCount = 3;
-                                        nodes[i]->output.data[0].value = lerp.x;
-                                        nodes[i]->output.data[1].value = lerp.y;
-                                        nodes[i]->output.data[2].value = lerp.z;
-                                    } break;
-                                    case 4:
-                                    {
-                                        Vector4 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value, nodes[indexA]->output.data[3].value };
-                                        Vector4 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexA]->output.data[2].value, nodes[indexA]->output.data[3].value };
-                                        Vector4 lerp = FVector4Lerp(vectorA, vectorB, nodes[indexC]->output.data[0].value);
-
-                                        nodes[i]->output.dataCount = 4;
-                                        nodes[i]->output.data[0].value = lerp.x;
-                                        nodes[i]->output.data[1].value = lerp.y;
-                                        nodes[i]->output.data[2].value = lerp.z;
-                                        nodes[i]->output.data[3].value = lerp.w;
-                                    } break;
-                                    default: break;
-                                }
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_SMOOTHSTEP:
-                        {                                
-                            if (nodes[i]->inputsCount == 3)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
-                                int indexC = GetNodeIndex(nodes[i]->inputs[2]);
+    int tilesCount = ((width + BAKE_TILE_SIZE - 1)/BAKE_TILE_SIZE)*((height + BAKE_TILE_SIZE - 1)/BAKE_TILE_SIZE);
+    double elapsedTime = RunBatch(&batch, tilesCount, workersCount);
 
-                                for (int j = 0; j < nodes[i]->output.dataCount; j++) nodes[i]->output.data[j].value = FSmoothStep(nodes[indexA]->output.data[j].value, nodes[indexB]->output.data[j].value, nodes[indexC]->output.data[j].value);
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_CROSSPRODUCT:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
+    TraceLogFNode(false, "baked %ix%i texels with %i workers (%.0f texels/s)", width, height, batch.workersCount, ((elapsedTime > 0) ? width*height/elapsedTime : 0.0));
 
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
+    UnloadBatchImages(&batch);
+    FNODE_FREE(batch.program);
+    FNODE_FREE(batch.blocks);
+    FNODE_FREE(batch.slots);
+    FNODE_FREE(batch.invariants);
+    FNODE_FREE(batch.invariantSlots);
 
-                                Vector3 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value };
-                                Vector3 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value };
-                                Vector3 cross = FCrossProduct(vectorA, vectorB);
+    return batch.image;
+}
 
-                                nodes[i]->output.dataCount = 3;
-                                nodes[i]->output.data[0].value = cross.x;
-                                nodes[i]->output.data[1].value = cross.y;
-                                nodes[i]->output.data[2].value = cross.z;
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_DESATURATE:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int index = GetNodeIndex(nodes[i]->inputs[0]);
-                                int index1 = GetNodeIndex(nodes[i]->inputs[1]);
+// Loads nodes and lines from a serialized graph data file
+FNODEDEF bool LoadGraph(FNodeContext context, const char *fileName)
+{
+    FILE *dataFile = fopen(fileName, "r");
+    if (dataFile == NULL) return false;
+
+    float type = -1;
+    float inputs[MAX_INPUTS] = { -1, -1, -1, -1 };
+    float inputsCount = -1;
+    float inputsLimit = -1;
+    float dataCount = -1;
+    float property = -1;
+    float data[MAX_VALUES] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    float shapeX = -1;
+    float shapeY = -1;
+    int firstNode = context->nodesCount;
+    int valuesCount = 0;
+    bool valid = true;
+
+    while ((valuesCount = fscanf(dataFile, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n", &type, &property,
+    &inputs[0], &inputs[1], &inputs[2], &inputs[3], &inputsCount, &inputsLimit, &dataCount, &data[0], &data[1], &data[2],
+    &data[3], &data[4], &data[5], &data[6], &data[7], &data[8], &data[9], &data[10], &data[11], &data[12], &data[13], &data[14],
+    &data[15], &shapeX, &shapeY)) > 0)
+    {
+        // Nodes with unknown types or out of range counts would be read out of their values and inputs arrays
+        if ((valuesCount < 27) || (type != (int)type) || (type < FNODE_PI) || (type > FNODE_FRAGMENT) || (inputsLimit < 0) || (inputsLimit > MAX_INPUTS) || (dataCount < 0) || (dataCount > MAX_VALUES))
+        {
+            TraceLogFNode(false, "graph file %s node %i data is not valid", fileName, context->nodesCount - firstNode);
+            valid = false;
+            break;
+        }
 
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = nodes[index]->output.data[j].value;
-                                nodes[i]->output.dataCount = nodes[index]->output.dataCount;
+        FNode newNode = InitializeNode(context, true);
+        newNode->type = type;
+        newNode->property = property;
 
-                                float amount = FClamp(nodes[index1]->output.data[0].value, 0.0f, 1.0f);
-                                float luminance = 0.3f*nodes[i]->output.data[0].value + 0.6f*nodes[i]->output.data[1].value + 0.1f*nodes[i]->output.data[2].value;
+        if (type < FNODE_ADD) newNode->inputShape = (Rectangle){ 0, 0, 0, 0 };
 
-                                nodes[i]->output.data[0].value = nodes[i]->output.data[0].value + amount*(luminance - nodes[i]->output.data[0].value);
-                                nodes[i]->output.data[1].value = nodes[i]->output.data[1].value + amount*(luminance - nodes[i]->output.data[1].value);
-                                nodes[i]->output.data[2].value = nodes[i]->output.data[2].value + amount*(luminance - nodes[i]->output.data[2].value);
-                            }
-                            else
-                            {
-                                nodes[i]->output.dataCount = 0;
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            }
-                        } break;
-                        case FNODE_DISTANCE:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
+        switch ((int)type)
+        {
+            case FNODE_PI: newNode->name = "Pi"; break;
+            case FNODE_E: newNode->name = "e"; break;
+            case FNODE_TIME: newNode->name = "Current Time"; break;
+            case FNODE_VERTEXPOSITION: newNode->name = "Vertex Position"; break;
+            case FNODE_VERTEXNORMAL: newNode->name = "Normal Direction"; break;
+            case FNODE_FRESNEL: newNode->name = "Fresnel"; break;
+            case FNODE_VIEWDIRECTION: newNode->name = "View Direction"; break;
+            case FNODE_MVP: newNode->name = "MVP Matrix"; break;
+            case FNODE_MATRIX: newNode->name = "Matrix 4x4"; break;
+            case FNODE_VALUE: newNode->name = "Value"; break;
+            case FNODE_VECTOR2: newNode->name = "Vector 2"; break;
+            case FNODE_VECTOR3: newNode->name = "Vector 3"; break;
+            case FNODE_VECTOR4: newNode->name = "Vector 4"; break;
+            case FNODE_ADD: newNode->name = "Add"; break;
+            case FNODE_SUBTRACT: newNode->name = "Subtract"; break;
+            case FNODE_MULTIPLY: newNode->name = "Multiply"; break;
+            case FNODE_DIVIDE: newNode->name = "Divide"; break;
+            case FNODE_APPEND: newNode->name = "Append"; break;
+            case FNODE_ONEMINUS: newNode->name = "One Minus"; break;
+            case FNODE_ABS: newNode->name = "Abs"; break;
+            case FNODE_COS:newNode->name = "Cos"; break;
+            case FNODE_SIN: newNode->name = "Sin"; break;
+            case FNODE_TAN: newNode->name = "Tan"; break;
+            case FNODE_DEG2RAD: newNode->name = "Deg to Rad"; break;
+            case FNODE_RAD2DEG: newNode->name = "Rad to Deg"; break;
+            case FNODE_NORMALIZE: newNode->name = "Normalize"; break;
+            case FNODE_NEGATE: newNode->name = "Negate"; break;
+            case FNODE_RECIPROCAL: newNode->name = "Reciprocal"; break;
+            case FNODE_SQRT: newNode->name = "Square Root"; break;
+            case FNODE_TRUNC: newNode->name = "Trunc"; break;
+            case FNODE_ROUND: newNode->name = "Round"; break;
+            case FNODE_VERTEXCOLOR: newNode->name = "Vertex Color"; break;
+            case FNODE_CEIL: newNode->name = "Ceil"; break;
+            case FNODE_CLAMP01: newNode->name = "Clamp 0-1"; break;
+            case FNODE_EXP2: newNode->name = "Exp 2"; break;
+            case FNODE_POWER: newNode->name = "Power"; break;
+            case FNODE_STEP: newNode->name = "Step"; break;
+            case FNODE_POSTERIZE: newNode->name = "Posterize"; break;
+            case FNODE_MAX: newNode->name = "Max"; break;
+            case FNODE_MIN: newNode->name = "Min"; break;
+            case FNODE_LERP: newNode->name = "Lerp"; break;
+            case FNODE_SMOOTHSTEP: newNode->name = "Smooth Step"; break;
+            case FNODE_CROSSPRODUCT: newNode->name = "Cross Product"; break;
+            case FNODE_DESATURATE: newNode->name = "Desaturate"; break;
+            case FNODE_DISTANCE: newNode->name = "Distance"; break;
+            case FNODE_DOTPRODUCT: newNode->name = "Dot Product"; break;
+            case FNODE_LENGTH: newNode->name = "Length"; break;
+            case FNODE_MULTIPLYMATRIX: newNode->name = "Multiply Matrix"; break;
+            case FNODE_TRANSPOSE: newNode->name = "Transpose"; break;
+            case FNODE_PROJECTION: newNode->name = "Projection Vector"; break;
+            case FNODE_REJECTION: newNode->name = "Rejection Vector"; break;
+            case FNODE_HALFDIRECTION: newNode->name = "Half Direction"; break;
+            case FNODE_SAMPLER2D: newNode->name = "Sampler 2D"; break;
+            case FNODE_VERTEX: newNode->name = "[OUTPUT] Vertex Position"; break;
+            case FNODE_FRAGMENT: newNode->name = "[OUTPUT] Fragment Color"; break;
+            default: break;
+        }
 
-                                switch (nodes[i]->output.dataCount)
-                                {
-                                    case 1: nodes[i]->output.data[0].value = nodes[indexB]->output.data[0].value - nodes[indexA]->output.data[0].value; break;
-                                    case 2:
-                                    {
-                                        Vector2 direction = { 0, 0 };
-                                        direction.x = nodes[indexB]->output.data[0].value - nodes[indexA]->output.data[0].value;
-                                        direction.y = nodes[indexB]->output.data[1].value - nodes[indexA]->output.data[1].value;
-
-                                        nodes[i]->output.data[0].value = FVector2Length(direction);
-                                    } break;
-                                    case 3:
-                                    {
-                                        Vector3 direction = { 0, 0, 0 };
-                                        direction.x = nodes[indexB]->output.data[0].value - nodes[indexA]->output.data[0].value;
-                                        direction.y = nodes[indexB]->output.data[1].value - nodes[indexA]->output.data[1].value;
-                                        direction.z = nodes[indexB]->output.data[2].value - nodes[indexA]->output.data[2].value;
-
-                                        nodes[i]->output.data[0].value = FVector3Length(direction);
-                                    } break;
-                                    case 4:
-                                    {
-                                        Vector4 direction = { 0, 0, 0, 0 };
-                                        direction.x = nodes[indexB]->output.data[0].value - nodes[indexA]->output.data[0].value;
-                                        direction.y = nodes[indexB]->output.data[1].value - nodes[indexA]->output.data[1].value;
-                                        direction.z = nodes[indexB]->output.data[2].value - nodes[indexA]->output.data[2].value;
-                                        direction.w = nodes[indexB]->output.data[3].value - nodes[indexA]->output.data[3].value;
-
-                                        nodes[i]->output.data[0].value = FVector4Length(direction);
-                                    } break;
-                                    default: break;
-                                }
+        // Node inputs are assigned when its lines are created
+        newNode->inputsLimit = inputsLimit;
 
-                                for (int j = 1; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 1;
-                            }
-                            else
-                            {
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 0;
-                            }
-                        } break;
-                        case FNODE_DOTPRODUCT:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
+        for (int i = 0; i < MAX_VALUES; i++)
+        {
+            newNode->output.data[i] = data[i];
+            FFloatToString(newNode->outputView.texts[i], newNode->output.data[i]);
+        }
 
-                                switch (nodes[i]->output.dataCount)
-                                {
-                                    case 2:
-                                    {
-                                        Vector2 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value };
-                                        Vector2 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value };
-                                        nodes[i]->output.data[0].value = FVector2Dot(vectorA, vectorB);
-                                    } break;
-                                    case 3:
-                                    {
-                                        Vector3 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value };
-                                        Vector3 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value };
-                                        nodes[i]->output.data[0].value = FVector3Dot(vectorA, vectorB);
-                                    } break;
-                                    case 4:
-                                    {
-                                        Vector4 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value, nodes[indexA]->output.data[3].value };
-                                        Vector4 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value, nodes[indexB]->output.data[3].value };
-                                        nodes[i]->output.data[0].value = FVector4Dot(vectorA, vectorB);
-                                    } break;
-                                    default: break;
-                                }
+        newNode->output.dataCount = dataCount;
+        newNode->shape.x = shapeX;
+        newNode->shape.y = shapeY;
 
-                                for (int j = 1; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 1;
-                            }
-                            else
-                            {
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 0;
-                            }
-                        } break;
-                        case FNODE_LENGTH:
-                        {
-                            switch (nodes[i]->output.dataCount)
-                            {
-                                case 2: nodes[i]->output.data[0].value = FVector2Length((Vector2){ nodes[i]->output.data[0].value, nodes[i]->output.data[1].value }); break;
-                                case 3: nodes[i]->output.data[0].value = FVector3Length((Vector3){ nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value }); break;
-                                case 4: nodes[i]->output.data[0].value = FVector4Length((Vector4){ nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value, nodes[i]->output.data[3].value }); break;
-                                default: break;
-                            }
+        UpdateNodeShapes(newNode);
+    }
 
-                            for (int j = 1; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                            nodes[i]->output.dataCount = 1;
-                        } break;
-                        case FNODE_MULTIPLYMATRIX:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int index = GetNodeIndex(nodes[i]->inputs[1]);
-
-                                Matrix matrixA = { nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value, nodes[i]->output.data[3].value, 
-                                nodes[i]->output.data[4].value, nodes[i]->output.data[5].value, nodes[i]->output.data[6].value, nodes[i]->output.data[7].value, 
-                                nodes[i]->output.data[8].value, nodes[i]->output.data[9].value, nodes[i]->output.data[10].value, nodes[i]->output.data[11].value, 
-                                nodes[i]->output.data[12].value, nodes[i]->output.data[13].value, nodes[i]->output.data[14].value, nodes[i]->output.data[15].value, };
-                                Matrix matrixB = { nodes[index]->output.data[0].value, nodes[index]->output.data[1].value, nodes[index]->output.data[2].value, nodes[index]->output.data[3].value, 
-                                nodes[index]->output.data[4].value, nodes[index]->output.data[5].value, nodes[index]->output.data[6].value, nodes[index]->output.data[7].value, 
-                                nodes[index]->output.data[8].value, nodes[index]->output.data[9].value, nodes[index]->output.data[10].value, nodes[index]->output.data[11].value, 
-                                nodes[index]->output.data[12].value, nodes[index]->output.data[13].value, nodes[index]->output.data[14].value, nodes[index]->output.data[15].value, };
-                                Matrix matrixAB = FMatrixMultiply(matrixA, matrixB);
-
-                                nodes[i]->output.data[0].value = matrixAB.m0;
-                                nodes[i]->output.data[1].value = matrixAB.m1;
-                                nodes[i]->output.data[2].value = matrixAB.m2;
-                                nodes[i]->output.data[3].value = matrixAB.m3;
-                                nodes[i]->output.data[4].value = matrixAB.m4;
-                                nodes[i]->output.data[5].value = matrixAB.m5;
-                                nodes[i]->output.data[6].value = matrixAB.m6;
-                                nodes[i]->output.data[7].value = matrixAB.m7;
-                                nodes[i]->output.data[8].value = matrixAB.m8;
-                                nodes[i]->output.data[9].value = matrixAB.m9;
-                                nodes[i]->output.data[10].value = matrixAB.m10;
-                                nodes[i]->output.data[11].value = matrixAB.m11;
-                                nodes[i]->output.data[12].value = matrixAB.m12;
-                                nodes[i]->output.data[13].value = matrixAB.m13;
-                                nodes[i]->output.data[14].value = matrixAB.m14;
-                                nodes[i]->output.data[15].value = matrixAB.m15;
-                            }
-                        } break;
-                        case FNODE_TRANSPOSE:
-                        {
-                            Matrix matrix = { nodes[i]->output.data[0].value, nodes[i]->output.data[1].value, nodes[i]->output.data[2].value, nodes[i]->output.data[3].value, 
-                            nodes[i]->output.data[4].value, nodes[i]->output.data[5].value, nodes[i]->output.data[6].value, nodes[i]->output.data[7].value, 
-                            nodes[i]->output.data[8].value, nodes[i]->output.data[9].value, nodes[i]->output.data[10].value, nodes[i]->output.data[11].value, 
-                            nodes[i]->output.data[12].value, nodes[i]->output.data[13].value, nodes[i]->output.data[14].value, nodes[i]->output.data[15].value, };
-                            FMatrixTranspose(&matrix);
-
-                            nodes[i]->output.data[0].value = matrix.m0;
-                            nodes[i]->output.data[1].value = matrix.m1;
-                            nodes[i]->output.data[2].value = matrix.m2;
-                            nodes[i]->output.data[3].value = matrix.m3;
-                            nodes[i]->output.data[4].value = matrix.m4;
-                            nodes[i]->output.data[5].value = matrix.m5;
-                            nodes[i]->output.data[6].value = matrix.m6;
-                            nodes[i]->output.data[7].value = matrix.m7;
-                            nodes[i]->output.data[8].value = matrix.m8;
-                            nodes[i]->output.data[9].value = matrix.m9;
-                            nodes[i]->output.data[10].value = matrix.m10;
-                            nodes[i]->output.data[11].value = matrix.m11;
-                            nodes[i]->output.data[12].value = matrix.m12;
-                            nodes[i]->output.data[13].value = matrix.m13;
-                            nodes[i]->output.data[14].value = matrix.m14;
-                            nodes[i]->output.data[15].value = matrix.m15;
-                        } break;
-                        case FNODE_PROJECTION:
-                        case FNODE_REJECTION:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
+    int from = -1;
+    int to = -1;
 
-                                switch (nodes[i]->output.dataCount)
-                                {
-                                    case 2:
-                                    {
-                                        Vector2 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value };
-                                        Vector2 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value };
-                                        Vector2 newVector = ((nodes[i]->type == FNODE_PROJECTION) ? FVector2Projection(vectorA, vectorB) : FVector2Rejection(vectorA, vectorB));
-
-                                        nodes[i]->output.data[0].value = newVector.x;
-                                        nodes[i]->output.data[1].value = newVector.y;
-
-                                        for (int j = 2; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                        nodes[i]->output.dataCount = 2;
-                                    } break;
-                                    case 3:
-                                    {
-                                        Vector3 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value };
-                                        Vector3 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value };
-                                        Vector3 newVector = ((nodes[i]->type == FNODE_PROJECTION) ? FVector3Projection(vectorA, vectorB) : FVector3Rejection(vectorA, vectorB));
-
-                                        nodes[i]->output.data[0].value = newVector.x;
-                                        nodes[i]->output.data[1].value = newVector.y;
-                                        nodes[i]->output.data[2].value = newVector.z;
-
-                                        for (int j = 3; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                        nodes[i]->output.dataCount = 3;
-                                    } break;
-                                    case 4:
-                                    {
-                                        Vector4 vectorA = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value, nodes[indexA]->output.data[3].value };
-                                        Vector4 vectorB = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value, nodes[indexB]->output.data[3].value };
-                                        Vector4 newVector = ((nodes[i]->type == FNODE_PROJECTION) ? FVector4Projection(vectorA, vectorB) : FVector4Rejection(vectorA, vectorB));
-
-                                        nodes[i]->output.data[0].value = newVector.x;
-                                        nodes[i]->output.data[1].value = newVector.y;
-                                        nodes[i]->output.data[2].value = newVector.z;
-                                        nodes[i]->output.data[3].value = newVector.w;
-
-                                        for (int j = 4; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                        nodes[i]->output.dataCount = 4;
-                                    } break;
-                                    default: break;
-                                }
-                            }
-                            else
-                            {
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 0;
-                            }
-                        } break;
-                        case FNODE_HALFDIRECTION:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[0]);
-                                int indexB = GetNodeIndex(nodes[i]->inputs[1]);
+    while (valid && (fscanf(dataFile, "?%i?%i\n", &from, &to) > 0))
+    {
+        // Lines store nodes positions in file, so they can only link nodes loaded from the same file and their end node inputs limit is kept
+        int indexFrom = (((from >= 0) && (from < context->nodesCount - firstNode)) ? firstNode + from : -1);
+        int indexTo = (((to >= 0) && (to < context->nodesCount - firstNode)) ? firstNode + to : -1);
 
-                                bool check = true;
-                                check = ((nodes[indexA]->type <= FNODE_E) || (nodes[indexA]->type >= FNODE_MATRIX));
-                                if (check) check = ((nodes[indexB]->type <= FNODE_E) || (nodes[indexB]->type >= FNODE_MATRIX));
+        if ((indexFrom == -1) || (indexTo == -1) || (context->nodes[indexTo]->inputsCount >= context->nodes[indexTo]->inputsLimit))
+        {
+            TraceLogFNode(false, "graph file %s line from node %i to node %i is not valid", fileName, from, to);
+            valid = false;
+        }
+        else CreateNodeLine(context, context->nodes[indexFrom]->id, context->nodes[indexTo]->id);
+    }
 
-                                if (check)
-                                {
-                                    switch (nodes[i]->output.dataCount)
-                                    {
-                                        case 2:
-                                        {
-                                            Vector2 a = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value };
-                                            Vector2 b = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value };
-                                            Vector2 vectorA = FVector2Normalize(a);
-                                            Vector2 vectorB = FVector2Normalize(b);
-                                            Vector2 output = { vectorA.x + vectorB.x, vectorA.y + vectorB.y };
-
-                                            nodes[i]->output.data[0].value = output.x;
-                                            nodes[i]->output.data[1].value = output.y;
-
-                                            for (int j = 2; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                            nodes[i]->output.dataCount = 2;
-                                        } break;
-                                        case 3:
-                                        {
-                                            Vector3 a = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value };
-                                            Vector3 b = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value };
-                                            Vector3 vectorA = FVector3Normalize(a);
-                                            Vector3 vectorB = FVector3Normalize(b);
-                                            Vector3 output = { vectorA.x + vectorB.x, vectorA.y + vectorB.y, vectorA.z + vectorB.z };
-
-                                            nodes[i]->output.data[0].value = output.x;
-                                            nodes[i]->output.data[1].value = output.y;
-                                            nodes[i]->output.data[2].value = output.z;
-
-                                            for (int j = 3; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                            nodes[i]->output.dataCount = 3;
-                                        } break;
-                                        case 4:
-                                        {
-                                            Vector4 a = { nodes[indexA]->output.data[0].value, nodes[indexA]->output.data[1].value, nodes[indexA]->output.data[2].value, nodes[indexA]->output.data[3].value };
-                                            Vector4 b = { nodes[indexB]->output.data[0].value, nodes[indexB]->output.data[1].value, nodes[indexB]->output.data[2].value, nodes[indexB]->output.data[3].value };
-                                            Vector4 vectorA = FVector4Normalize(a);
-                                            Vector4 vectorB = FVector4Normalize(b);
-                                            Vector4 output = { vectorA.x + vectorB.x, vectorA.y + vectorB.y, vectorA.z + vectorB.z, vectorA.w + vectorB.w };
-
-                                            nodes[i]->output.data[0].value = output.x;
-                                            nodes[i]->output.data[1].value = output.y;
-                                            nodes[i]->output.data[2].value = output.z;
-                                            nodes[i]->output.data[3].value = output.w;
-
-                                            for (int j = 4; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                            nodes[i]->output.dataCount = 4;
-                                        } break;
-                                        default: break;
-                                    }
-                                }
-                                else
-                                {
-                                    for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                }
-                            }
-                            else
-                            {
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 0;
-                            }
-                        }
-                        case FNODE_SAMPLER2D:
-                        {
-                            if (nodes[i]->inputsCount == 2)
-                            {
-                                int indexA = GetNodeIndex(nodes[i]->inputs[1]);
-                                switch ((int)nodes[indexA]->output.data[0].value)
-                                {
-                                    case 0: nodes[i]->output.dataCount = 4; break;
-                                    case 1: nodes[i]->output.dataCount = 3; break;
-                                    default: nodes[i]->output.dataCount = 1; break;
-                                }
-                            }
-                            else
-                            {
-                                for (int j = 0; j < MAX_VALUES; j++) nodes[i]->output.data[j].value = 0.0f;
-                                nodes[i]->output.dataCount = 0;
-                            }
-                        } break;
-                        default: break;
-                    }
-                }
-                else
-                {
-                    for (int k = 0; k < MAX_VALUES; k++) nodes[i]->output.data[k].value = 0.0f;
-                    nodes[i]->output.dataCount = 0;
-                }
-            }
+    if (!valid)
+    {
+        // Nodes loaded from a not valid file are destroyed with their lines
+        while (context->nodesCount > firstNode) RemoveNode(context, context->nodes[context->nodesCount - 1]);
 
-            if (nodes[i]->type > FNODE_VECTOR4)
-            {
-                for (int k = 0; k < nodes[i]->output.dataCount; k++) FFloatToString(nodes[i]->output.data[k].valueText, nodes[i]->output.data[k].value);
-            }
+        CalculateValues(context);
+
+        fclose(dataFile);
+
+        return false;
+    }
+
+    for (int i = 0; i < context->nodesCount; i++) UpdateNodeShapes(context->nodes[i]);
+
+    CalculateValues(context);
+
+    for (int i = 0; i < context->nodesCount; i++) UpdateNodeShapes(context->nodes[i]);
+
+    fclose(dataFile);
+
+    return true;
+}
+
+// Serializes nodes and lines to a graph data file
+FNODEDEF bool SaveGraph(FNodeContext context, const char *fileName)
+{
+    FILE *dataFile = fopen(fileName, "w");
+    if (dataFile == NULL) return false;
+
+    // Nodes data writing, nodes are loaded again in the same order so links are stored as nodes indexes
+    for (int k = 0; k < context->nodesCount; k++)
+    {
+        float type = (float)context->nodes[k]->type;
+        float property = (float)context->nodes[k]->property;
+        float inputs[MAX_INPUTS] = { -1, -1, -1, -1 };
+        for (int i = 0; i < context->nodes[k]->inputsCount; i++) inputs[i] = (float)GetNodeIndex(context, context->nodes[k]->inputs[i]);
+        float inputsCount = (float)context->nodes[k]->inputsCount;
+        float inputsLimit = (float)context->nodes[k]->inputsLimit;
+        float dataCount = (float)context->nodes[k]->output.dataCount;
+        float data[MAX_VALUES] = { context->nodes[k]->output.data[0], context->nodes[k]->output.data[1], context->nodes[k]->output.data[2], context->nodes[k]->output.data[3], context->nodes[k]->output.data[4],
+        context->nodes[k]->output.data[5], context->nodes[k]->output.data[6], context->nodes[k]->output.data[7], context->nodes[k]->output.data[8], context->nodes[k]->output.data[9], context->nodes[k]->output.data[10],
+        context->nodes[k]->output.data[11], context->nodes[k]->output.data[12], context->nodes[k]->output.data[13], context->nodes[k]->output.data[14], context->nodes[k]->output.data[15] };
+        float shapeX = (float)context->nodes[k]->shape.x;
+        float shapeY = (float)context->nodes[k]->shape.y;
+
+        fprintf(dataFile, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n", type, property,
+        inputs[0], inputs[1], inputs[2], inputs[3], inputsCount, inputsLimit, dataCount, data[0], data[1], data[2],
+        data[3], data[4], data[5], data[6], data[7], data[8], data[9], data[10], data[11], data[12], data[13], data[14],
+        data[15], shapeX, shapeY);
+    }
+
+    // Lines data writing in every node inputs order, so inputs are linked again in the same order (lines being linked are skipped)
+    for (int k = 0; k < context->nodesCount; k++)
+    {
+        for (int i = 0; i < context->nodes[k]->inputsCount; i++) fprintf(dataFile, "?%i?%i\n", GetNodeIndex(context, context->nodes[k]->inputs[i]), k);
+    }
+
+    fclose(dataFile);
+
+    return true;
+}
+
+// Generates vertex and fragment shaders code of current nodes
+FNODEDEF void GenerateShader(FNodeContext context, ShaderVersion version, bool hoistVertex, FString *vertexCode, FString *fragmentCode)
+{
+    const char *varyingTypes[4] = { "vec3", "vec3", "vec2", "vec4" };
+    const char *varyingNames[4] = { "fragPosition", "fragNormal", "fragTexCoord", "fragColor" };
+    const char *attributeNames[4] = { "vertexPosition", "vertexNormal", "vertexTexCoord", "vertexColor" };
+    const char *valueTypes[4] = { "float", "vec2", "vec3", "vec4" };
+
+    context->shaderVersion = version;
+
+    // Per stage node ids bitsets of live and declared variables
+    unsigned int *live = (unsigned int *)FNODE_MALLOC(BITSET_WORDS(context->nodesLimit)*sizeof(unsigned int));
+    unsigned int *declared = (unsigned int *)FNODE_MALLOC(BITSET_WORDS(context->nodesLimit)*sizeof(unsigned int));
+    int *vertexLive = (int *)FNODE_MALLOC(context->nodesCount*sizeof(int));
+    int *fragmentLive = (int *)FNODE_MALLOC(context->nodesCount*sizeof(int));
+
+    // Structurally identical nodes are emitted once and constant subgraphs are folded into literals
+    FindExpressions(context);
+    FindConstants(context);
+
+    int vertexIndex = GetNodeIndex(context, context->expressionIds[context->nodes[0]->inputs[0]]);
+    int fragmentIndex = GetNodeIndex(context, context->expressionIds[context->nodes[1]->inputs[0]]);
+
+    // Linearly interpolable fragment values are optionally computed per vertex
+    context->hoistedCount = 0;
+
+    if (hoistVertex)
+    {
+        context->interpolations = (signed char *)FNODE_MALLOC(context->nodesLimit*sizeof(signed char));
+        memset(context->interpolations, -1, context->nodesLimit*sizeof(signed char));
+        memset(live, 0, BITSET_WORDS(context->nodesLimit)*sizeof(unsigned int));
+
+        FindHoistedNodes(context, context->nodes[fragmentIndex], live);
+
+        FNODE_FREE(context->interpolations);
+        context->interpolations = NULL;
+    }
+
+    // Only nodes reachable from each stage output generated code are declared in that stage
+    memset(live, 0, BITSET_WORDS(context->nodesLimit)*sizeof(unsigned int));
+    int vertexLiveCount = MarkLiveNodes(context, context->nodes[vertexIndex], live, vertexLive, 0, false);
+    for (int i = 0; i < context->hoistedCount; i++) vertexLiveCount = MarkLiveNodes(context, context->nodes[GetNodeIndex(context, context->hoistedNodes[i])], live, vertexLive, vertexLiveCount, false);
+
+    memset(live, 0, BITSET_WORDS(context->nodesLimit)*sizeof(unsigned int));
+    int fragmentLiveCount = MarkLiveNodes(context, context->nodes[fragmentIndex], live, fragmentLive, 0, true);
+
+    // Attributes are interpolated only when read by fragment stage (vertex stage samplers and fresnel read them too)
+    bool varyings[4] = {
+        IsNodeLive(context, fragmentLive, fragmentLiveCount, FNODE_VERTEXPOSITION),
+        (IsNodeLive(context, fragmentLive, fragmentLiveCount, FNODE_VERTEXNORMAL) || IsNodeLive(context, fragmentLive, fragmentLiveCount, FNODE_FRESNEL) || IsNodeLive(context, vertexLive, vertexLiveCount, FNODE_FRESNEL)),
+        (IsNodeLive(context, fragmentLive, fragmentLiveCount, FNODE_SAMPLER2D) || IsNodeLive(context, vertexLive, vertexLiveCount, FNODE_SAMPLER2D)),
+        IsNodeLive(context, fragmentLive, fragmentLiveCount, FNODE_VERTEXCOLOR)
+    };
+    bool anyVarying = (varyings[0] || varyings[1] || varyings[2] || varyings[3] || (context->hoistedCount > 0));
+
+    const char vCredits[] = "// Shader created with FNode 1.0 - Credits: Victor Fisac\n\n";
+    AppendString(vertexCode, vCredits);
+
+    // Vertex shader definition to embed, no external file required
+    switch (version)
+    {
+        case GLSL_330:
+        {
+            const char vHeader[] = "#version 330\n\n";
+            AppendString(vertexCode, vHeader);
+        } break;
+        case GLSL_100:
+        {
+            const char vHeader[] = "#version 100\n\n";
+            AppendString(vertexCode, vHeader);
+        } break;
+        default: break;
+    }
+
+    switch (version)
+    {
+        case GLSL_330:
+        {
+            const char vIn[] = 
+            "in vec3 vertexPosition;\n"
+            "in vec3 vertexNormal;\n"
+            "in vec2 vertexTexCoord;\n"
+            "in vec4 vertexColor;\n\n";
+            AppendString(vertexCode, vIn);
+        } break;
+        case GLSL_100:
+        {
+            const char vIn[] = 
+            "attribute vec3 vertexPosition;\n"
+            "attribute vec3 vertexNormal;\n"
+            "attribute vec2 vertexTexCoord;\n"
+            "attribute vec4 vertexColor;\n\n";
+            AppendString(vertexCode, vIn);
+        } break;
+        default: break;
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (varyings[i]) AppendString(vertexCode, "%s %s %s;\n", ((version == GLSL_330) ? "out" : "varying"), varyingTypes[i], varyingNames[i]);
+    }
+
+    for (int i = 0; i < context->hoistedCount; i++) AppendString(vertexCode, "%s %s fragNode_%02i;\n", ((version == GLSL_330) ? "out" : "varying"), valueTypes[context->nodes[GetNodeIndex(context, context->hoistedNodes[i])]->output.dataCount - 1], context->hoistedNodes[i]);
+
+    if (anyVarying) AppendString(vertexCode, "\n");
+
+    // Built-in uniforms are declared only when a live node reads them
+    if (IsNodeLive(context, vertexLive, vertexLiveCount, FNODE_MVP)) AppendString(vertexCode, "uniform mat4 mvp;\n");
+    if (IsNodeLive(context, vertexLive, vertexLiveCount, FNODE_TIME)) AppendString(vertexCode, "uniform float vertCurrentTime;\n");
+    if (IsNodeLive(context, vertexLive, vertexLiveCount, FNODE_FRESNEL) || IsNodeLive(context, vertexLive, vertexLiveCount, FNODE_VIEWDIRECTION)) AppendString(vertexCode, "uniform vec3 viewDirection;\n");
+    AppendString(vertexCode, "\n");
+
+    AppendString(vertexCode, "// Constant and uniform values\n");
+    for (int i = 0; i < MAX_TEXTURES; i++) context->usedUnits[i] = false;
+    for (int i = 0; i < vertexLiveCount; i++) CheckConstant(context, context->nodes[GetNodeIndex(context, vertexLive[i])], vertexCode);
+
+    const char vMain[] = 
+    "\nvoid main()\n"
+    "{\n";
+    AppendString(vertexCode, vMain);
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (varyings[i]) AppendString(vertexCode, "    %s = %s;\n", varyingNames[i], attributeNames[i]);
+    }
+
+    if (anyVarying) AppendString(vertexCode, "\n");
+
+    memset(declared, 0, BITSET_WORDS(context->nodesLimit)*sizeof(unsigned int));
+    for (int i = 0; i < MAX_TEXTURES; i++) context->fetchedUnits[i] = false;
+    CompileNode(context, context->nodes[vertexIndex], vertexCode, declared, false);
+
+    for (int i = 0; i < context->hoistedCount; i++)
+    {
+        CompileNode(context, context->nodes[GetNodeIndex(context, context->hoistedNodes[i])], vertexCode, declared, false);
+        AppendString(vertexCode, "    fragNode_%02i = node_%02i;\n", context->hoistedNodes[i], context->hoistedNodes[i]);
+    }
+
+    switch (context->nodes[vertexIndex]->output.dataCount)
+    {
+        case 1: AppendString(vertexCode, "\n    gl_Position = vec4(node_%02i, node_%02i, node_%02i, 1.0);\n}", context->nodes[vertexIndex]->id, context->nodes[vertexIndex]->id, context->nodes[vertexIndex]->id); break;
+        case 2: AppendString(vertexCode, "\n    gl_Position = vec4(node_%02i.xy, 0.0, 1.0);\n}", context->nodes[vertexIndex]->id); break;
+        case 3: AppendString(vertexCode, "\n    gl_Position = vec4(node_%02i.xyz, 1.0);\n}", context->nodes[vertexIndex]->id); break;
+        case 4: AppendString(vertexCode, "\n    gl_Position = node_%02i;\n}", context->nodes[vertexIndex]->id); break;
+        case 16: AppendString(vertexCode, "\n    gl_Position = node_%02i;\n}", context->nodes[vertexIndex]->id); break;
+        default: break;
+    }
+
+    const char fCredits[] = "// Shader created with FNode 1.0 - Credits: Victor Fisac\n\n";
+    AppendString(fragmentCode, fCredits);
+
+    // Fragment shader definition to embed, no external file required
+    switch (version)
+    {
+        case GLSL_330:
+        {
+            const char fHeader[] = "#version 330\n\n";
+            AppendString(fragmentCode, fHeader);
+        } break;
+        case GLSL_100:
+        {
+            const char fHeader[] = "#version 100\n"
+            "precision mediump float;\n\n";
+            AppendString(fragmentCode, fHeader);
+        } break;
+        default: break;
+    }
 
-            UpdateNodeShapes(nodes[i]);
+    if (anyVarying)
+    {
+        AppendString(fragmentCode, "// Input attributes\n");
+
+        for (int i = 0; i < 4; i++)
+        {
+            if (varyings[i]) AppendString(fragmentCode, "%s %s %s;\n", ((version == GLSL_330) ? "in" : "varying"), varyingTypes[i], varyingNames[i]);
         }
-        else TraceLogFNode(true, "error trying to calculate values for a null referenced node");
+
+        for (int i = 0; i < context->hoistedCount; i++) AppendString(fragmentCode, "%s %s fragNode_%02i;\n", ((version == GLSL_330) ? "in" : "varying"), valueTypes[context->nodes[GetNodeIndex(context, context->hoistedNodes[i])]->output.dataCount - 1], context->hoistedNodes[i]);
+
+        AppendString(fragmentCode, "\n");
+    }
+
+    bool fragmentView = (IsNodeLive(context, fragmentLive, fragmentLiveCount, FNODE_FRESNEL) || IsNodeLive(context, fragmentLive, fragmentLiveCount, FNODE_VIEWDIRECTION));
+    bool fragmentTime = IsNodeLive(context, fragmentLive, fragmentLiveCount, FNODE_TIME);
+    bool fragmentMvp = IsNodeLive(context, fragmentLive, fragmentLiveCount, FNODE_MVP);
+
+    if (fragmentView || fragmentTime || fragmentMvp)
+    {
+        AppendString(fragmentCode, "// Uniform attributes\n");
+        if (fragmentView) AppendString(fragmentCode, "uniform vec3 viewDirection;\n");
+        if (fragmentMvp) AppendString(fragmentCode, "uniform mat4 mvp;\n");
+        if (fragmentTime) AppendString(fragmentCode, "uniform float fragCurrentTime;\n");
+        AppendString(fragmentCode, "\n");
+    }
+
+    if (version == GLSL_330)
+    {
+        AppendString(fragmentCode, "// Output attributes\n");
+        const char fOut[] = 
+        "out vec4 finalColor;\n\n";
+        AppendString(fragmentCode, fOut);
+    }
+
+    AppendString(fragmentCode, "// Constant and uniform values\n");
+    for (int i = 0; i < MAX_TEXTURES; i++) context->usedUnits[i] = false;
+    for (int i = 0; i < fragmentLiveCount; i++) CheckConstant(context, context->nodes[GetNodeIndex(context, fragmentLive[i])], fragmentCode);
+
+    const char fMain[] = 
+    "\nvoid main()\n"
+    "{\n";
+    AppendString(fragmentCode, fMain);
+
+    memset(declared, 0, BITSET_WORDS(context->nodesLimit)*sizeof(unsigned int));
+    for (int i = 0; i < MAX_TEXTURES; i++) context->fetchedUnits[i] = false;
+    CompileNode(context, context->nodes[fragmentIndex], fragmentCode, declared, true);
+
+    switch (version)
+    {
+        case GLSL_330:
+        {
+            switch (context->nodes[fragmentIndex]->output.dataCount)
+            {
+                case 1: AppendString(fragmentCode, "\n    finalColor = vec4(node_%02i, node_%02i, node_%02i, 1.0);\n}", context->nodes[fragmentIndex]->id, context->nodes[fragmentIndex]->id, context->nodes[fragmentIndex]->id); break;
+                case 2: AppendString(fragmentCode, "\n    finalColor = vec4(node_%02i.xy, 0.0, 1.0);\n}", context->nodes[fragmentIndex]->id); break;
+                case 3: AppendString(fragmentCode, "\n    finalColor = vec4(node_%02i.xyz, 1.0);\n}", context->nodes[fragmentIndex]->id); break;
+                case 4: AppendString(fragmentCode, "\n    finalColor = node_%02i;\n}", context->nodes[fragmentIndex]->id); break;
+                default: break;
+            }
+        } break;
+        case GLSL_100:
+        {
+            switch (context->nodes[fragmentIndex]->output.dataCount)
+            {
+                case 1: AppendString(fragmentCode, "\n    gl_FragColor = vec4(node_%02i, node_%02i, node_%02i, 1.0);\n}", context->nodes[fragmentIndex]->id, context->nodes[fragmentIndex]->id, context->nodes[fragmentIndex]->id); break;
+                case 2: AppendString(fragmentCode, "\n    gl_FragColor = vec4(node_%02i.xy, 0.0, 1.0);\n}", context->nodes[fragmentIndex]->id); break;
+                case 3: AppendString(fragmentCode, "\n    gl_FragColor = vec4(node_%02i.xyz, 1.0);\n}", context->nodes[fragmentIndex]->id); break;
+                case 4: AppendString(fragmentCode, "\n    gl_FragColor = node_%02i;\n}", context->nodes[fragmentIndex]->id); break;
+                default: break;
+            }
+        } break;
+        default: break;
     }
+
+    FNODE_FREE(live);
+    FNODE_FREE(declared);
+    FNODE_FREE(vertexLive);
+    FNODE_FREE(fragmentLive);
+    FNODE_FREE(context->expressionIds);
+    FNODE_FREE(context->foldStates);
+    context->expressionIds = NULL;
+    context->foldStates = NULL;
 }
 
+#if !defined(FNODE_NO_EDITOR)
 // Draws a previously created node
-FNODEDEF void DrawNode(FNode node)
+FNODEDEF void DrawNode(FNodeContext context, FNode node)
 {
     if (node != NULL)
     {
-        if (node->property) DrawRectangleRec(node->shape, ((node->id == selectedNode) ? (Color){ 128, 204, 139, 255 } : (Color){ 173, 225, 181, 255 }));
-        else DrawRectangleRec(node->shape, ((node->id == selectedNode) ? GRAY : LIGHTGRAY));
+        if (node->outputView.stale && IsNodeVisible(context, node)) UpdateNodeView(node);
+
+        if (node->property) DrawRectangleRec(node->shape, ((node->id == context->selectedNode) ? (Color){ 128, 204, 139, 255 } : (Color){ 173, 225, 181, 255 }));
+        else DrawRectangleRec(node->shape, ((node->id == context->selectedNode) ? GRAY : LIGHTGRAY));
 
         DrawRectangleLines(node->shape.x, node->shape.y, node->shape.width, node->shape.height, BLACK);
         DrawText(FormatText("%s [ID: %i]", node->name, node->id), node->shape.x + node->shape.width/2 - MeasureText(node->name, 10)/2, node->shape.y - 15, 10, BLACK);
 
         if ((node->type >= FNODE_MATRIX) && (node->type <= FNODE_VECTOR4))
         {
-            if ((node->id == editNode) && interact)
+            if ((node->id == context->editNode) && context->interact)
             {
                 int charac = -1;
                 charac = GetKeyPressed();
@@ -1723,40 +1861,41 @@ FNODEDEF void DrawNode(FNode node)
                     {
                         for (int i = 0; i < MAX_NODE_LENGTH; i++)
                         {
-                            if ((node->output.data[editNodeType].valueText[i] == '\0'))
+                            if ((node->outputView.texts[context->editNodeType][i] == '\0'))
                             {
-                                node->output.data[editNodeType].valueText[i - 1] = '\0';
+                                node->outputView.texts[context->editNodeType][i - 1] = '\0';
                                 break;
                             }
                         }
 
-                        node->output.data[editNodeType].valueText[MAX_NODE_LENGTH - 1] = '\0';
+                        node->outputView.texts[context->editNodeType][MAX_NODE_LENGTH - 1] = '\0';
 
                         UpdateNodeShapes(node);
                     }
                     else if (charac == KEY_ENTER)
                     {
                         // Check new node value requeriments (cannot be empty, ...)
-                        bool valuesCheck = (node->output.data[editNodeType].valueText[0] != '\0');
+                        bool valuesCheck = (node->outputView.texts[context->editNodeType][0] != '\0');
                         if (valuesCheck)
                         {
-                            FStringToFloat(&node->output.data[editNodeType].value, (const char*)node->output.data[editNodeType].valueText);
-                            FFloatToString(node->output.data[editNodeType].valueText, node->output.data[editNodeType].value);
+                            FStringToFloat(&node->output.data[context->editNodeType], (const char*)node->outputView.texts[context->editNodeType]);
+                            FFloatToString(node->outputView.texts[context->editNodeType], node->output.data[context->editNodeType]);
 
-                            CalculateValues();
+                            SetNodeDirty(node);
+                            CalculateValues(context);
                         }
                         else
                         {
-                            TraceLogFNode(false, "error when trying to change node id %i value due to invalid characters (%s)", node->id, node->output.data[editNodeType].valueText);
-                            for (int i = 0; i < MAX_NODE_LENGTH; i++) node->output.data[editNodeType].valueText[i] = editNodeText[i];
+                            TraceLogFNode(false, "error when trying to change node id %i value due to invalid characters (%s)", node->id, node->outputView.texts[context->editNodeType]);
+                            for (int i = 0; i < MAX_NODE_LENGTH; i++) node->outputView.texts[context->editNodeType][i] = context->editNodeText[i];
                         }
 
                         UpdateNodeShapes(node);
-                        editNode = -1;
-                        editNodeType = -1;
-                        FNODE_FREE(editNodeText);
-                        usedMemory -= MAX_NODE_LENGTH;
-                        editNodeText = NULL;
+                        context->editNode = -1;
+                        context->editNodeType = -1;
+                        FNODE_FREE(context->editNodeText);
+                        context->usedMemory -= MAX_NODE_LENGTH;
+                        context->editNodeText = NULL;
                     }
                     else
                     {
@@ -1765,9 +1904,9 @@ FNODEDEF void DrawNode(FNode node)
                         {
                             for (int i = 0; i < MAX_NODE_LENGTH; i++)
                             {
-                                if (node->output.data[editNodeType].valueText[i] == '\0')
+                                if (node->outputView.texts[context->editNodeType][i] == '\0')
                                 {
-                                    node->output.data[editNodeType].valueText[i] = (char)charac;
+                                    node->outputView.texts[context->editNodeType][i] = (char)charac;
                                     UpdateNodeShapes(node);
                                     break;
                                 }
@@ -1782,10 +1921,10 @@ FNODEDEF void DrawNode(FNode node)
         {
             for (int i = 0; i < node->output.dataCount; i++)
             {
-                if ((node->type >= FNODE_MATRIX) && (node->type <= FNODE_VECTOR4)) DrawRectangleLines(node->output.data[i].shape.x,node->output.data[i].shape.y, node->output.data[i].shape.width, node->output.data[i].shape.height, (((editNode == node->id) && (editNodeType == i)) ? BLACK : GRAY));
-                DrawText(node->output.data[i].valueText, node->output.data[i].shape.x + (node->output.data[i].shape.width - 
-                         MeasureText(node->output.data[i].valueText, 20))/2, node->output.data[i].shape.y + 
-                         node->output.data[i].shape.height/2 - 9, 20, DARKGRAY);
+                if ((node->type >= FNODE_MATRIX) && (node->type <= FNODE_VECTOR4)) DrawRectangleLines(node->outputView.shapes[i].x,node->outputView.shapes[i].y, node->outputView.shapes[i].width, node->outputView.shapes[i].height, (((context->editNode == node->id) && (context->editNodeType == i)) ? BLACK : GRAY));
+                DrawText(node->outputView.texts[i], node->outputView.shapes[i].x + (node->outputView.shapes[i].width - 
+                         MeasureText(node->outputView.texts[i], 20))/2, node->outputView.shapes[i].y + 
+                         node->outputView.shapes[i].height/2 - 9, 20, DARKGRAY);
             }
         }
 
@@ -1802,17 +1941,17 @@ FNODEDEF void DrawNode(FNode node)
                 DrawRectangleLines(node->inputShape.x, node->inputShape.y, node->inputShape.width, node->inputShape.height, COLOR_INPUT_DISABLED_BORDER);
             }
             
-            if(CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(node->inputShape, camera)))
+            if(CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(node->inputShape, context->camera)))
                 DrawRectangleRec(node->inputShape, COLOR_INPUT_ADDITIVE);
         }
 
         if (node->outputShape.width > 0)
         {
-            DrawRectangleRec(node->outputShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(node->outputShape, camera)) ? LIGHTGRAY : GRAY)));
+            DrawRectangleRec(node->outputShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(node->outputShape, context->camera)) ? LIGHTGRAY : GRAY)));
             DrawRectangleLines(node->outputShape.x, node->outputShape.y, node->outputShape.width, node->outputShape.height, BLACK);
         }
 
-        if (debugMode)
+        if (context->debugMode)
         {
             const char *string =
             "id: %i\n"
@@ -1821,14 +1960,14 @@ FNODEDEF void DrawNode(FNode node)
             "output(%i): %.02f, %.02f, %.02f, %.02f";
 
             DrawText(FormatText(string, node->id, node->name, node->inputsCount, node->inputsLimit, node->inputs[0], node->inputs[1], node->inputs[2], 
-            node->inputs[3], node->output.dataCount, node->output.data[0].value, node->output.data[1].value, node->output.data[2].value, node->output.data[3].value), node->shape.x, node->shape.y + node->shape.height + 5, 10, BLACK);
+            node->inputs[3], node->output.dataCount, node->output.data[0], node->output.data[1], node->output.data[2], node->output.data[3]), node->shape.x, node->shape.y + node->shape.height + 5, 10, BLACK);
         }
     }
     else TraceLogFNode(true, "error trying to draw a null referenced node");
 }
 
 // Draws a previously created node line
-FNODEDEF void DrawNodeLine(FLine line)
+FNODEDEF void DrawNodeLine(FNodeContext context, FLine line)
 {
     if (line != NULL)
     {
@@ -1838,20 +1977,23 @@ FNODEDEF void DrawNodeLine(FLine line)
         int indexTo = -1;        
         if (line->to != -1)
         {
-            indexTo = GetNodeIndex(line->to);
+            indexTo = GetNodeIndex(context, line->to);
             
-            to.x = nodes[indexTo]->inputShape.x + nodes[indexTo]->inputShape.width/2;
-            to.y = nodes[indexTo]->inputShape.y + nodes[indexTo]->inputShape.height/2;
+            to.x = context->nodes[indexTo]->inputShape.x + context->nodes[indexTo]->inputShape.width/2;
+            to.y = context->nodes[indexTo]->inputShape.y + context->nodes[indexTo]->inputShape.height/2;
         }
-        else to = CameraToViewVector2(GetMousePosition(), camera);
+        else to = CameraToViewVector2(GetMousePosition(), context->camera);
 
-        int indexFrom = GetNodeIndex(line->from);
+        int indexFrom = GetNodeIndex(context, line->from);
 
-        from.x = nodes[indexFrom]->outputShape.x + nodes[indexFrom]->outputShape.width/2;
-        from.y = nodes[indexFrom]->outputShape.y + nodes[indexFrom]->outputShape.height/2;
+        // Line start depends on node width, so values texts of nodes out of view are formatted before
+        if (context->nodes[indexFrom]->outputView.stale) UpdateNodeView(context->nodes[indexFrom]);
 
-        DrawCircle(from.x, from.y, 5, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
-        DrawCircle(to.x, to.y, 5, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+        from.x = context->nodes[indexFrom]->outputShape.x + context->nodes[indexFrom]->outputShape.width/2;
+        from.y = context->nodes[indexFrom]->outputShape.y + context->nodes[indexFrom]->outputShape.height/2;
+
+        DrawCircle(from.x, from.y, 5, ((context->tempLine->id == line->id && context->tempLine->to == -1) ? DARKGRAY : BLACK));
+        DrawCircle(to.x, to.y, 5, ((context->tempLine->id == line->id && context->tempLine->to == -1) ? DARKGRAY : BLACK));
 
         if (from.x <= to.x)
         {
@@ -1867,7 +2009,7 @@ FNODEDEF void DrawNodeLine(FLine line)
                 toCurve.x = FEaseLinear(current, from.x, to.x - from.x, NODE_LINE_DIVISIONS);
                 toCurve.y = FEaseInOutQuad(current, from.y, to.y - from.y, NODE_LINE_DIVISIONS);
 
-                DrawLine(fromCurve.x, fromCurve.y, toCurve.x, toCurve.y, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+                DrawLine(fromCurve.x, fromCurve.y, toCurve.x, toCurve.y, ((context->tempLine->id == line->id && context->tempLine->to == -1) ? DARKGRAY : BLACK));
             }
         }
         else
@@ -1877,73 +2019,73 @@ FNODEDEF void DrawNodeLine(FLine line)
             float radius = (fabs(to.y - from.y)/4 + 0.02f)*multiplier;
             float distance = FClamp(fabs(to.x - from.x)/100, 0.0f, 1.0f);
 
-            DrawLine(from.x, from.y, from.x, from.y, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+            DrawLine(from.x, from.y, from.x, from.y, ((context->tempLine->id == line->id && context->tempLine->to == -1) ? DARKGRAY : BLACK));
 
             while (angle < 90)
             {
-                DrawLine(from.x + FCos(angle*DEG2RAD)*radius*multiplier*distance, from.y + radius + FSin(angle*DEG2RAD)*radius, from.x + FCos((angle + 10)*DEG2RAD)*radius*multiplier*distance, from.y + radius + FSin((angle + 10)*DEG2RAD)*radius, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+                DrawLine(from.x + FCos(angle*DEG2RAD)*radius*multiplier*distance, from.y + radius + FSin(angle*DEG2RAD)*radius, from.x + FCos((angle + 10)*DEG2RAD)*radius*multiplier*distance, from.y + radius + FSin((angle + 10)*DEG2RAD)*radius, ((context->tempLine->id == line->id && context->tempLine->to == -1) ? DARKGRAY : BLACK));
                 angle += 10;
             }
 
             Vector2 lastPosition = { from.x, from.y + radius*2 };
-            DrawLine(lastPosition.x, lastPosition.y, to.x + FCos(270*DEG2RAD)*radius*multiplier, to.y - radius + FSin(270*DEG2RAD)*radius, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+            DrawLine(lastPosition.x, lastPosition.y, to.x + FCos(270*DEG2RAD)*radius*multiplier, to.y - radius + FSin(270*DEG2RAD)*radius, ((context->tempLine->id == line->id && context->tempLine->to == -1) ? DARKGRAY : BLACK));
             lastPosition.x = to.x;
 
             while (angle < 270)
             {
-                DrawLine(to.x + FCos(angle*DEG2RAD)*radius*multiplier*distance, to.y - radius + FSin(angle*DEG2RAD)*radius, to.x + FCos((angle + 10)*DEG2RAD)*radius*multiplier*distance, to.y - radius + FSin((angle + 10)*DEG2RAD)*radius, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+                DrawLine(to.x + FCos(angle*DEG2RAD)*radius*multiplier*distance, to.y - radius + FSin(angle*DEG2RAD)*radius, to.x + FCos((angle + 10)*DEG2RAD)*radius*multiplier*distance, to.y - radius + FSin((angle + 10)*DEG2RAD)*radius, ((context->tempLine->id == line->id && context->tempLine->to == -1) ? DARKGRAY : BLACK));
                 angle += 10;
             }
 
             lastPosition.y = lastPosition.y + radius*2;
-            DrawLine(to.x, to.y, to.x, to.y, ((tempLine->id == line->id && tempLine->to == -1) ? DARKGRAY : BLACK));
+            DrawLine(to.x, to.y, to.x, to.y, ((context->tempLine->id == line->id && context->tempLine->to == -1) ? DARKGRAY : BLACK));
         }
 
         if (indexFrom != -1 && indexTo != -1)
         {
-            switch (nodes[indexTo]->type)
+            switch (context->nodes[indexTo]->type)
             {
                 case FNODE_POWER:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Input", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Exponent", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((context->nodes[indexTo]->inputsCount > 0) && (context->nodes[indexTo]->inputs[0] == context->nodes[indexFrom]->id)) DrawText("Input", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((context->nodes[indexTo]->inputsCount > 1) && (context->nodes[indexTo]->inputs[1] == context->nodes[indexFrom]->id)) DrawText("Exponent", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_STEP:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Value A", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Value B", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((context->nodes[indexTo]->inputsCount > 0) && (context->nodes[indexTo]->inputs[0] == context->nodes[indexFrom]->id)) DrawText("Value A", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((context->nodes[indexTo]->inputsCount > 1) && (context->nodes[indexTo]->inputs[1] == context->nodes[indexFrom]->id)) DrawText("Value B", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_POSTERIZE:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Input", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Samples", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((context->nodes[indexTo]->inputsCount > 0) && (context->nodes[indexTo]->inputs[0] == context->nodes[indexFrom]->id)) DrawText("Input", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((context->nodes[indexTo]->inputsCount > 1) && (context->nodes[indexTo]->inputs[1] == context->nodes[indexFrom]->id)) DrawText("Samples", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_LERP:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Value A", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Value B", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 2) && (nodes[indexTo]->inputs[2] == nodes[indexFrom]->id)) DrawText("Time", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((context->nodes[indexTo]->inputsCount > 0) && (context->nodes[indexTo]->inputs[0] == context->nodes[indexFrom]->id)) DrawText("Value A", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((context->nodes[indexTo]->inputsCount > 1) && (context->nodes[indexTo]->inputs[1] == context->nodes[indexFrom]->id)) DrawText("Value B", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((context->nodes[indexTo]->inputsCount > 2) && (context->nodes[indexTo]->inputs[2] == context->nodes[indexFrom]->id)) DrawText("Time", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_SMOOTHSTEP:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Min", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Max", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 2) && (nodes[indexTo]->inputs[2] == nodes[indexFrom]->id)) DrawText("Value", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((context->nodes[indexTo]->inputsCount > 0) && (context->nodes[indexTo]->inputs[0] == context->nodes[indexFrom]->id)) DrawText("Min", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((context->nodes[indexTo]->inputsCount > 1) && (context->nodes[indexTo]->inputs[1] == context->nodes[indexFrom]->id)) DrawText("Max", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((context->nodes[indexTo]->inputsCount > 2) && (context->nodes[indexTo]->inputs[2] == context->nodes[indexFrom]->id)) DrawText("Value", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_DESATURATE:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Value", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Amount (0-1)", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((context->nodes[indexTo]->inputsCount > 0) && (context->nodes[indexTo]->inputs[0] == context->nodes[indexFrom]->id)) DrawText("Value", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((context->nodes[indexTo]->inputsCount > 1) && (context->nodes[indexTo]->inputs[1] == context->nodes[indexFrom]->id)) DrawText("Amount (0-1)", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_MULTIPLYMATRIX:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Left", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Right", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((context->nodes[indexTo]->inputsCount > 0) && (context->nodes[indexTo]->inputs[0] == context->nodes[indexFrom]->id)) DrawText("Left", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((context->nodes[indexTo]->inputsCount > 1) && (context->nodes[indexTo]->inputs[1] == context->nodes[indexFrom]->id)) DrawText("Right", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 case FNODE_SAMPLER2D:
                 {
-                    if ((nodes[indexTo]->inputsCount > 0) && (nodes[indexTo]->inputs[0] == nodes[indexFrom]->id)) DrawText("Unit", from.x + 5, from.y - 30, 10, BLACK);
-                    else if ((nodes[indexTo]->inputsCount > 1) && (nodes[indexTo]->inputs[1] == nodes[indexFrom]->id)) DrawText("Type", from.x + 5, from.y - 30, 10, BLACK);
+                    if ((context->nodes[indexTo]->inputsCount > 0) && (context->nodes[indexTo]->inputs[0] == context->nodes[indexFrom]->id)) DrawText("Unit", from.x + 5, from.y - 30, 10, BLACK);
+                    else if ((context->nodes[indexTo]->inputsCount > 1) && (context->nodes[indexTo]->inputs[1] == context->nodes[indexFrom]->id)) DrawText("Type", from.x + 5, from.y - 30, 10, BLACK);
                 } break;
                 default: break;
             }
@@ -1953,35 +2095,35 @@ FNODEDEF void DrawNodeLine(FLine line)
 }
 
 // Draws a previously created comment
-FNODEDEF void DrawComment(FComment comment)
+FNODEDEF void DrawComment(FNodeContext context, FComment comment)
 {
     if (comment != NULL)
     {
-        if ((commentState == 0) || ((commentState == 1) && (tempComment->id != comment->id)) || ((commentState == 1) && editSize != -1)) DrawRectangleRec(comment->shape, Fade(YELLOW, 0.2f));
+        if ((context->commentState == 0) || ((context->commentState == 1) && (context->tempComment->id != comment->id)) || ((context->commentState == 1) && context->editSize != -1)) DrawRectangleRec(comment->shape, Fade(YELLOW, 0.2f));
 
         DrawRectangleLines(comment->shape.x, comment->shape.y, comment->shape.width, comment->shape.height, BLACK);
 
-        if ((commentState == 0) || ((commentState == 1) && (tempComment->id != comment->id)) || ((commentState == 1) && editSize != -1))
+        if ((context->commentState == 0) || ((context->commentState == 1) && (context->tempComment->id != comment->id)) || ((context->commentState == 1) && context->editSize != -1))
         {
-            DrawRectangleRec(comment->sizeTShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeTShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeTShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeTShape, context->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeTShape.x, comment->sizeTShape.y, comment->sizeTShape.width, comment->sizeTShape.height, BLACK);
-            DrawRectangleRec(comment->sizeBShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeBShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeBShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeBShape, context->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeBShape.x, comment->sizeBShape.y, comment->sizeBShape.width, comment->sizeBShape.height, BLACK);
-            DrawRectangleRec(comment->sizeLShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeLShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeLShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeLShape, context->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeLShape.x, comment->sizeLShape.y, comment->sizeLShape.width, comment->sizeLShape.height, BLACK);
-            DrawRectangleRec(comment->sizeRShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeRShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeRShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeRShape, context->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeRShape.x, comment->sizeRShape.y, comment->sizeRShape.width, comment->sizeRShape.height, BLACK);
-            DrawRectangleRec(comment->sizeTlShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeTlShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeTlShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeTlShape, context->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeTlShape.x, comment->sizeTlShape.y, comment->sizeTlShape.width, comment->sizeTlShape.height, BLACK);
-            DrawRectangleRec(comment->sizeTrShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeTrShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeTrShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeTrShape, context->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeTrShape.x, comment->sizeTrShape.y, comment->sizeTrShape.width, comment->sizeTrShape.height, BLACK);
-            DrawRectangleRec(comment->sizeBlShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeBlShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeBlShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeBlShape, context->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeBlShape.x, comment->sizeBlShape.y, comment->sizeBlShape.width, comment->sizeBlShape.height, BLACK);
-            DrawRectangleRec(comment->sizeBrShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeBrShape, camera))) ? LIGHTGRAY : GRAY));
+            DrawRectangleRec(comment->sizeBrShape, ((CheckCollisionPointRec(GetMousePosition(), CameraToViewRec(comment->sizeBrShape, context->camera))) ? LIGHTGRAY : GRAY));
             DrawRectangleLines(comment->sizeBrShape.x, comment->sizeBrShape.y, comment->sizeBrShape.width, comment->sizeBrShape.height, BLACK);
         }
 
-        if ((comment->id == editComment) && interact)
+        if ((comment->id == context->editComment) && context->interact)
         {
             int letter = -1;
             letter = GetKeyPressed();
@@ -2001,7 +2143,7 @@ FNODEDEF void DrawComment(FComment comment)
 
                     comment->value[MAX_COMMENT_LENGTH - 1] = '\0';
                 }
-                else if (letter == KEY_ENTER) editComment = -1;
+                else if (letter == KEY_ENTER) context->editComment = -1;
                 else
                 {
                     if ((letter >= 32) && (letter < 127))
@@ -2019,7 +2161,7 @@ FNODEDEF void DrawComment(FComment comment)
             }
         }
 
-        DrawRectangleLines(comment->valueShape.x, comment->valueShape.y, comment->valueShape.width, comment->valueShape.height, ((editComment == comment->id) ? BLACK : LIGHTGRAY));
+        DrawRectangleLines(comment->valueShape.x, comment->valueShape.y, comment->valueShape.width, comment->valueShape.height, ((context->editComment == comment->id) ? BLACK : LIGHTGRAY));
 
         int initPos = comment->shape.x + 14;
         for (int i = 0; i < MAX_COMMENT_LENGTH; i++)
@@ -2032,91 +2174,68 @@ FNODEDEF void DrawComment(FComment comment)
     }
     else TraceLogFNode(true, "error trying to draw a null referenced line");
 }
+#endif
 
 // Destroys a node and its linked lines
-FNODEDEF void DestroyNode(FNode node)
+FNODEDEF void DestroyNode(FNodeContext context, FNode node)
 {
     if (node != NULL)
     {
-        int id = node->id;
-        int index = GetNodeIndex(id);
-
-        for (int i = linesCount - 1; i >= 0; i--)
-        {
-            if (lines[i]->from == node->id || lines[i]->to == node->id) DestroyNodeLine(lines[i]);
-        }
-
-        for (int i = 0; i < MAX_VALUES; i++)
-        {
-           FNODE_FREE(nodes[index]->output.data[i].valueText);
-           usedMemory -= MAX_NODE_LENGTH;
-           nodes[index]->output.data[i].valueText = NULL;
-        }
+        RemoveNode(context, node);
+        CalculateValues(context);
+    }
+    else TraceLogFNode(true, "error trying to destroy a null referenced node");
+}
 
-        FNODE_FREE(nodes[index]);
-        usedMemory -= sizeof(FNodeData);
-        nodes[index] = NULL;
+// Destroys a list of nodes and their linked lines, calculating nodes values once
+FNODEDEF void DestroyNodes(FNodeContext context, FNode *nodes, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (nodes[i] != NULL) RemoveNode(context, nodes[i]);
+        else TraceLogFNode(true, "error trying to destroy a null referenced node");
+    }
 
-        for (int i = index; i < nodesCount; i++)
-        {
-            if ((i + 1) < nodesCount) nodes[i] = nodes[i + 1];
-        }
+    if (count > 0) CalculateValues(context);
+}
 
-        nodesCount--;
-        TraceLogFNode(false, "destroyed node id %i (index: %i) [USED RAM: %i bytes]", id, index, usedMemory);
-        CalculateValues();
+// Destroys a node input and output lines, calculating nodes values once
+FNODEDEF void DestroyNodeLinks(FNodeContext context, FNode node, bool inputs, bool outputs)
+{
+    if (node != NULL)
+    {
+        RemoveNodeLinks(context, node, inputs, outputs);
+        CalculateValues(context);
     }
-    else TraceLogFNode(true, "error trying to destroy a null referenced node");
+    else TraceLogFNode(true, "error trying to destroy lines of a null referenced node");
 }
 
 // Destroys a node line
-FNODEDEF void DestroyNodeLine(FLine line)
+FNODEDEF void DestroyNodeLine(FNodeContext context, FLine line)
 {
     if (line != NULL)
     {
-        int id = line->id;
-        int index = -1;
-
-        for (int i = 0; i < linesCount; i++)
-        {
-            if (lines[i]->id == id)
-            {
-                index = i;
-                break;
-            }
-        }
-
-        if (index != -1)
-        {        
-            FNODE_FREE(lines[index]);
-            usedMemory -= sizeof(FLineData);
-            lines[index] = NULL;
+        // Lines being linked do not change any node values
+        bool linked = ((int)line->to != -1);
 
-            for (int i = index; i < linesCount; i++)
-            {
-                if ((i + 1) < linesCount) lines[i] = lines[i + 1];
-            }
+        RemoveNodeLine(context, line);
 
-            linesCount--;
-            TraceLogFNode(false, "destroyed line id %i (index: %i) [USED RAM: %i bytes]", id, index, usedMemory);
-            CalculateValues();
-        }
-        else TraceLogFNode(true, "error when trying to destroy line id %i due to index is out of bounds %i", id, index);
+        if (linked) CalculateValues(context);
     }
     else TraceLogFNode(true, "error trying to destroy a null referenced line");
 }
 
 // Destroys a comment
-FNODEDEF void DestroyComment(FComment comment)
+FNODEDEF void DestroyComment(FNodeContext context, FComment comment)
 {
     if (comment != NULL)
     {
         int id = comment->id;
         int index = -1;
 
-        for (int i = 0; i < commentsCount; i++)
+        for (int i = 0; i < context->commentsCount; i++)
         {
-            if (comments[i]->id == id)
+            if (context->comments[i]->id == id)
             {
                 index = i;
                 break;
@@ -2125,131 +2244,143 @@ FNODEDEF void DestroyComment(FComment comment)
 
         if (index != -1)
         {
-            FNODE_FREE(comments[index]->value);
-            usedMemory -= MAX_COMMENT_LENGTH;
-            comments[index]->value = NULL;
-
-            FNODE_FREE(comments[index]);
-            usedMemory -= sizeof(FCommentData);
-            comments[index] = NULL;
+            ArenaRelease(&context->commentsArena, context->comments[index]);
+            context->comments[index] = NULL;
 
-            for (int i = index; i < commentsCount; i++)
+            for (int i = index; i < context->commentsCount; i++)
             {
-                if ((i + 1) < commentsCount) comments[i] = comments[i + 1];
+                if ((i + 1) < context->commentsCount) context->comments[i] = context->comments[i + 1];
             }
 
-            commentsCount--;
+            ReleaseId(context, &context->commentsIds, id);
+            context->commentsCount--;
 
-            TraceLogFNode(false, "destroyed comment id %i (index: %i) [USED RAM: %i bytes]", id, index, usedMemory);
+            TraceLogFNode(false, "destroyed comment id %i (index: %i) [USED RAM: %i bytes]", id, index, context->usedMemory);
         }
         else TraceLogFNode(true, "error when trying to destroy comment id %i due to index is out of bounds %i", id, index);
     }
     else TraceLogFNode(true, "error trying to destroy a null referenced comment");
 }
 
-// Unitializes FNode global variables
-FNODEDEF void CloseFNode()
+// Unitializes a context releasing all its memory
+FNODEDEF void CloseFNode(FNodeContext context)
 {
-    for (int i = 0; i < nodesCount; i++)
+    for (int i = 0; i < context->nodesCount; i++)
     {
-        if (nodes[i] != NULL)
+        if ((context->nodes[i] != NULL) && (context->nodes[i]->outputs != NULL))
         {
-            for (int k = 0; k < MAX_VALUES; k++)
-            {
-                if (nodes[i]->output.data[k].valueText != NULL)
-                {
-                    FNODE_FREE(nodes[i]->output.data[k].valueText);
-                    usedMemory -= MAX_NODE_LENGTH;
-                    nodes[i]->output.data[k].valueText = NULL;
-                }
-            }
-
-            FNODE_FREE(nodes[i]);
-            usedMemory -= sizeof(FNodeData);
-            nodes[i] = NULL;
+            FNODE_FREE(context->nodes[i]->outputs);
+            context->usedMemory -= context->nodes[i]->outputsLimit*sizeof(int);
         }
     }
 
-    for (int i = 0; i < linesCount; i++)
+    // Release nodes, lines and comments memory blocks at once
+    ResetArena(context, &context->nodesArena);
+    ResetArena(context, &context->linesArena);
+    ResetArena(context, &context->commentsArena);
+
+    if (context->editNodeText != NULL)
     {
-        if (lines[i] != NULL)
-        {
-            FNODE_FREE(lines[i]);
-            usedMemory -= sizeof(FLineData);
-            lines[i] = NULL;
-        }
+        FNODE_FREE(context->editNodeText);
+        context->usedMemory -= MAX_NODE_LENGTH;
     }
 
-    for (int i = 0; i < commentsCount; i++)
+    ResetIdPool(context, &context->nodesIds);
+    ResetIdPool(context, &context->linesIds);
+    ResetIdPool(context, &context->commentsIds);
+
+    // Release pools memory
+    if (context->nodes != NULL)
     {
-        if ((comments[i] != NULL) && (comments[i]->value != NULL))
-        {
-            FNODE_FREE(comments[i]->value);
-            usedMemory -= MAX_COMMENT_LENGTH;
-            comments[i]->value = NULL;
+        FNODE_FREE(context->nodes);
+        FNODE_FREE(context->nodesIndex);
+        FNODE_FREE(context->nodesChanged);
+        FNODE_FREE(context->evaluationOrder);
+        FNODE_FREE(context->selectedCommentNodes);
+        context->usedMemory -= context->nodesLimit*(sizeof(FNode) + sizeof(bool) + 3*sizeof(int));
+    }
 
-            FNODE_FREE(comments[i]);
-            usedMemory -= sizeof(FCommentData);
-            comments[i] = NULL;
-        }
+    if (context->lines != NULL)
+    {
+        FNODE_FREE(context->lines);
+        context->usedMemory -= context->linesLimit*sizeof(FLine);
+    }
+
+    if (context->comments != NULL)
+    {
+        FNODE_FREE(context->comments);
+        context->usedMemory -= context->commentsLimit*sizeof(FComment);
     }
 
-    if (editNodeText != NULL)
+    if (context->programBlocks != NULL)
     {
-        FNODE_FREE(editNodeText);
-        usedMemory -= MAX_NODE_LENGTH;
-        editNodeText = NULL;
+        FNODE_FREE(context->programBlocks);
+        FNODE_FREE(context->registers);
+        FNODE_FREE(context->programWidths);
+        context->usedMemory -= context->programBlocksLimit*(sizeof(FProgramBlock) + MAX_VALUES*sizeof(float) + sizeof(int));
     }
 
-    nodesCount = 0;
-    linesCount = 0;
-    commentsCount = 0;
-    selectedCommentNodesCount = 0;
+    if (context->program != NULL)
+    {
+        FNODE_FREE(context->program);
+        context->usedMemory -= context->programLimit*sizeof(FInstruction);
+    }
 
-    for (int i = 0; i < MAX_NODES; i++) selectedCommentNodes[i] = -1;
+    TraceLogFNode(false, "unitialization complete [USED RAM: %i bytes]", context->usedMemory);
 
-    TraceLogFNode(false, "unitialization complete [USED RAM: %i bytes]", usedMemory);
+    FNODE_FREE(context);
 }
 
 // Outputs a trace log message
 FNODEDEF void TraceLogFNode(bool error, const char *text, ...)
 {
+    char message[STRING_LENGTH] = { 0 };
     va_list args;
 
-    fprintf(stdout, "FNode: ");
     va_start(args, text);
-    vfprintf(stdout, text, args);
+    vsnprintf(message, STRING_LENGTH, text, args);
     va_end(args);
 
-    fprintf(stdout, "\n");
+    // Message is written at once so lines of concurrent threads are not mixed
+    fprintf(stdout, "FNode: %s\n", message);
 
     if (error) exit(1);
 }
 
-// Returns 1 if a specific string is found in a text file
-FNODEDEF int FSearch(char *filename, char *string)
+// Appends formatted text to a growable string
+FNODEDEF void AppendString(FString *string, const char *text, ...)
 {
-	FILE *file;
-	int found = 0;
-	char temp[512];
+    va_list args;
+
+    va_start(args, text);
+    int length = vsnprintf(NULL, 0, text, args);
+    va_end(args);
 
-	file = fopen(filename, "r");
+    if (length < 0) return;
 
-    if (file != NULL)
+    // Grow string until appended text fits
+    if ((string->length + length + 1) > string->capacity)
     {
-        while (fgets(temp, 512, file) != NULL) 
-        {
-            if ((strstr(temp, string)) != NULL)
-            {
-                found = 1;
-                break;
-            }
-        }
+        int capacity = ((string->capacity > 0) ? string->capacity : STRING_LENGTH);
+        while ((string->length + length + 1) > capacity) capacity *= 2;
 
-        fclose(file);
+        string->text = (char *)FNODE_REALLOC(string->text, capacity);
+        string->capacity = capacity;
     }
 
-   	return found;
+    va_start(args, text);
+    vsnprintf(string->text + string->length, length + 1, text, args);
+    va_end(args);
+
+    string->length += length;
+}
+
+// Releases a growable string memory
+FNODEDEF void UnloadString(FString *string)
+{
+    if (string->text != NULL) FNODE_FREE(string->text);
+
+    *string = (FString){ 0 };
 }
 
 //----------------------------------------------------------------------------------
@@ -2399,6 +2530,7 @@ static Vector3 FCrossProduct(Vector3 a, Vector3 b)
     return (Vector3){ a.y*b.z - a.z*b.y, a.z*b.x - a.x*b.z, a.x*b.y - a.y*b.x };
 }
 
+#if !defined(FNODE_NO_EDITOR)
 // Returns identity matrix
 static Matrix FMatrixIdentity()
 {
@@ -2409,6 +2541,7 @@ static Matrix FMatrixIdentity()
 
     return result;
 }
+#endif
 
 // Returns the result of multiply two matrices
 static Matrix FMatrixMultiply(Matrix left, Matrix right)
@@ -2435,80 +2568,6 @@ static Matrix FMatrixMultiply(Matrix left, Matrix right)
     return result;
 }
 
-// Returns translation matrix
-static Matrix FMatrixTranslate(float x, float y, float z)
-{
-    Matrix result = { 1.0f, 0.0f, 0.0f, 0.0f, 
-                      0.0f, 1.0f, 0.0f, 0.0f, 
-                      0.0f, 0.0f, 1.0f, 0.0f, 
-                      x, y, z, 1.0f };
-
-    return result;
-}
-
-// Create rotation matrix from axis and angle provided in radians
-static Matrix FMatrixRotate(Vector3 axis, float angle)
-{
-    Matrix result;
-
-    Matrix mat = FMatrixIdentity();
-    float x = axis.x, y = axis.y, z = axis.z;
-    float length = sqrt(x*x + y*y + z*z);
-
-    if ((length != 1.0f) && (length != 0.0f))
-    {
-        length = 1.0f/length;
-        x *= length;
-        y *= length;
-        z *= length;
-    }
-
-    float sinres = sinf(angle);
-    float cosres = cosf(angle);
-    float t = 1.0f - cosres;
-
-    // Cache some matrix values (speed optimization)
-    float a00 = mat.m0, a01 = mat.m1, a02 = mat.m2, a03 = mat.m3;
-    float a10 = mat.m4, a11 = mat.m5, a12 = mat.m6, a13 = mat.m7;
-    float a20 = mat.m8, a21 = mat.m9, a22 = mat.m10, a23 = mat.m11;
-
-    // Construct the elements of the rotation matrix
-    float b00 = x*x*t + cosres, b01 = y*x*t + z*sinres, b02 = z*x*t - y*sinres;
-    float b10 = x*y*t - z*sinres, b11 = y*y*t + cosres, b12 = z*y*t + x*sinres;
-    float b20 = x*z*t + y*sinres, b21 = y*z*t - x*sinres, b22 = z*z*t + cosres;
-
-    // Perform rotation-specific matrix multiplication
-    result.m0 = a00*b00 + a10*b01 + a20*b02;
-    result.m1 = a01*b00 + a11*b01 + a21*b02;
-    result.m2 = a02*b00 + a12*b01 + a22*b02;
-    result.m3 = a03*b00 + a13*b01 + a23*b02;
-    result.m4 = a00*b10 + a10*b11 + a20*b12;
-    result.m5 = a01*b10 + a11*b11 + a21*b12;
-    result.m6 = a02*b10 + a12*b11 + a22*b12;
-    result.m7 = a03*b10 + a13*b11 + a23*b12;
-    result.m8 = a00*b20 + a10*b21 + a20*b22;
-    result.m9 = a01*b20 + a11*b21 + a21*b22;
-    result.m10 = a02*b20 + a12*b21 + a22*b22;
-    result.m11 = a03*b20 + a13*b21 + a23*b22;
-    result.m12 = mat.m12;
-    result.m13 = mat.m13;
-    result.m14 = mat.m14;
-    result.m15 = mat.m15;
-
-    return result;
-}
-
-// Returns scaling matrix
-static Matrix FMatrixScale(float x, float y, float z)
-{
-    Matrix result = { x, 0.0f, 0.0f, 0.0f, 
-                      0.0f, y, 0.0f, 0.0f, 
-                      0.0f, 0.0f, z, 0.0f, 
-                      0.0f, 0.0f, 0.0f, 1.0f };
-
-    return result;
-}
-
 // Transposes provided matrix
 static void FMatrixTranspose(Matrix *mat)
 {
@@ -2642,24 +2701,6 @@ static float FLerp(float valueA, float valueB, float time)
     return (float)(valueA + (valueB - valueA)*time);
 }
 
-// Returns the interpolation between two Vector2 values
-static Vector2 FVector2Lerp(Vector2 valueA, Vector2 valueB, float time)
-{
-    return (Vector2){ (float)(valueA.x + (valueB.x - valueA.x)*time), (float)(valueA.y + (valueB.y - valueA.y)*time) };
-}
-
-// Returns the interpolation between two Vector3 values
-static Vector3 FVector3Lerp(Vector3 valueA, Vector3 valueB, float time)
-{
-    return (Vector3){ (float)(valueA.x + (valueB.x - valueA.x)*time), (float)(valueA.y + (valueB.y - valueA.y)*time), (float)(valueA.z + (valueB.z - valueA.z)*time) };
-}
-
-// Returns the interpolation between two Vector4 values
-static Vector4 FVector4Lerp(Vector4 valueA, Vector4 valueB, float time)
-{
-    return (Vector4){ (float)(valueA.x + (valueB.x - valueA.x)*time), (float)(valueA.y + (valueB.y - valueA.y)*time), (float)(valueA.z + (valueB.z - valueA.z)*time), (float)(valueA.w + (valueB.w - valueA.w)*time) };
-}
-
 // Returns the interpolate of a value in a range
 static float FSmoothStep(float min, float max, float value)
 {
@@ -2671,6 +2712,7 @@ static float FSmoothStep(float min, float max, float value)
     return output;
 }
 
+#if !defined(FNODE_NO_EDITOR)
 // Returns an ease linear value between two parameters
 static float FEaseLinear(float t, float b, float c, float d)
 { 
@@ -2692,17 +2734,2706 @@ static float FEaseInOutQuad(float t, float b, float c, float d)
 
 	return output;
 }
+#endif
 
-// Sends a float conversion value of a string to an initialized float pointer
-static void FStringToFloat(float *pointer, const char *string)
+// Returns an unused id from a pool
+static int AllocateId(FIdPool *pool)
 {
-    *pointer = (float)atof(string);
-}
+    int id = -1;
 
-// Sends formatted output to an initialized string pointer
-static void FFloatToString(char *buffer, float value)
+    if (pool->freeCount > 0)
+    {
+        pool->freeCount--;
+        id = pool->freeIds[pool->freeCount];
+    }
+    else
+    {
+        id = pool->nextId;
+        pool->nextId++;
+    }
+
+    return id;
+}
+
+// Returns an id to a pool to be used again
+static void ReleaseId(FNodeContext context, FIdPool *pool, int id)
+{
+    // Grow released ids array when it is full
+    if (pool->freeCount == pool->freeLimit)
+    {
+        int limit = ((pool->freeLimit > 0) ? pool->freeLimit*2 : 16);
+
+        pool->freeIds = (int *)FNODE_REALLOC(pool->freeIds, limit*sizeof(int));
+        context->usedMemory += (limit - pool->freeLimit)*sizeof(int);
+        pool->freeLimit = limit;
+    }
+
+    pool->freeIds[pool->freeCount] = id;
+    pool->freeCount++;
+}
+
+// Releases all ids of a pool and its allocated memory
+static void ResetIdPool(FNodeContext context, FIdPool *pool)
+{
+    if (pool->freeIds != NULL)
+    {
+        FNODE_FREE(pool->freeIds);
+        context->usedMemory -= pool->freeLimit*sizeof(int);
+    }
+
+    pool->freeIds = NULL;
+    pool->freeCount = 0;
+    pool->freeLimit = 0;
+    pool->nextId = 0;
+}
+
+// Returns an unused slot from an arena
+static void *ArenaAlloc(FNodeContext context, FArena *arena)
+{
+    void *slot = NULL;
+
+    if (arena->freeSlots != NULL)
+    {
+        // Reuse last released slot
+        slot = arena->freeSlots;
+        arena->freeSlots = *(void **)slot;
+    }
+    else
+    {
+        // Allocate a new block when last one is full
+        if ((arena->blocks == NULL) || (arena->blockUsed == ARENA_BLOCK_LENGTH))
+        {
+            int size = ARENA_ALIGN(sizeof(void *)) + ARENA_BLOCK_LENGTH*arena->slotSize;
+            void *block = FNODE_MALLOC(size);
+
+            if (block == NULL) TraceLogFNode(true, "error when trying to allocate a new arena block of %i bytes", size);
+
+            *(void **)block = arena->blocks;
+            arena->blocks = block;
+            arena->blockUsed = 0;
+            arena->usedMemory += size;
+            context->usedMemory += size;
+        }
+
+        slot = (char *)arena->blocks + ARENA_ALIGN(sizeof(void *)) + arena->blockUsed*arena->slotSize;
+        arena->blockUsed++;
+    }
+
+    return slot;
+}
+
+// Returns a slot to an arena to be used again
+static void ArenaRelease(FArena *arena, void *slot)
+{
+    *(void **)slot = arena->freeSlots;
+    arena->freeSlots = slot;
+}
+
+// Releases all slots of an arena and its allocated memory
+static void ResetArena(FNodeContext context, FArena *arena)
+{
+    while (arena->blocks != NULL)
+    {
+        void *previous = *(void **)arena->blocks;
+
+        FNODE_FREE(arena->blocks);
+        arena->blocks = previous;
+    }
+
+    context->usedMemory -= arena->usedMemory;
+    arena->usedMemory = 0;
+    arena->blockUsed = 0;
+    arena->freeSlots = NULL;
+}
+
+// Doubles nodes pool length and its related arrays
+static void GrowNodesPool(FNodeContext context)
+{
+    int limit = ((context->nodesLimit > 0) ? context->nodesLimit*2 : NODES_POOL_LENGTH);
+
+    context->nodes = (FNode *)FNODE_REALLOC(context->nodes, limit*sizeof(FNode));
+    context->nodesIndex = (int *)FNODE_REALLOC(context->nodesIndex, limit*sizeof(int));
+    context->nodesChanged = (bool *)FNODE_REALLOC(context->nodesChanged, limit*sizeof(bool));
+    context->evaluationOrder = (int *)FNODE_REALLOC(context->evaluationOrder, limit*sizeof(int));
+    context->selectedCommentNodes = (int *)FNODE_REALLOC(context->selectedCommentNodes, limit*sizeof(int));
+    context->usedMemory += (limit - context->nodesLimit)*(sizeof(FNode) + sizeof(bool) + 3*sizeof(int));
+
+    for (int i = context->nodesLimit; i < limit; i++)
+    {
+        context->nodes[i] = NULL;
+        context->nodesIndex[i] = -1;
+        context->nodesChanged[i] = false;
+        context->selectedCommentNodes[i] = -1;
+    }
+
+    context->nodesLimit = limit;
+}
+
+// Adds a line to its end node inputs and its start node outputs (false if inputs are full)
+static bool AddNodeLink(FNodeContext context, FLine line)
+{
+    int indexFrom = GetNodeIndex(context, line->from);
+    int indexTo = GetNodeIndex(context, line->to);
+
+    if (context->nodes[indexTo]->inputsCount >= MAX_INPUTS)
+    {
+        TraceLogFNode(false, "line id %i exceeds node id %i inputs limit", line->id, context->nodes[indexTo]->id);
+        return false;
+    }
+
+    context->nodes[indexTo]->inputs[context->nodes[indexTo]->inputsCount] = line->from;
+    context->nodes[indexTo]->inputLines[context->nodes[indexTo]->inputsCount] = line;
+    context->nodes[indexTo]->inputsCount++;
+    context->nodes[indexTo]->dirty = true;
+
+    // Grow start node outputs array when it is full
+    if (context->nodes[indexFrom]->outputsCount == context->nodes[indexFrom]->outputsLimit)
+    {
+        int limit = ((context->nodes[indexFrom]->outputsLimit > 0) ? context->nodes[indexFrom]->outputsLimit*2 : MAX_INPUTS);
+
+        context->nodes[indexFrom]->outputs = (int *)FNODE_REALLOC(context->nodes[indexFrom]->outputs, limit*sizeof(int));
+        context->usedMemory += (limit - context->nodes[indexFrom]->outputsLimit)*sizeof(int);
+        context->nodes[indexFrom]->outputsLimit = limit;
+    }
+
+    context->nodes[indexFrom]->outputs[context->nodes[indexFrom]->outputsCount] = line->to;
+    context->nodes[indexFrom]->outputsCount++;
+
+    return true;
+}
+
+// Removes a line from its end node inputs and its start node outputs
+static void RemoveNodeLink(FNodeContext context, FLine line)
+{
+    FNode nodeFrom = context->nodes[GetNodeIndex(context, line->from)];
+    FNode nodeTo = context->nodes[GetNodeIndex(context, line->to)];
+
+    for (int i = 0; i < nodeTo->inputsCount; i++)
+    {
+        if (nodeTo->inputLines[i] == line)
+        {
+            for (int k = i; k < nodeTo->inputsCount - 1; k++)
+            {
+                nodeTo->inputs[k] = nodeTo->inputs[k + 1];
+                nodeTo->inputLines[k] = nodeTo->inputLines[k + 1];
+            }
+
+            nodeTo->inputsCount--;
+            nodeTo->inputs[nodeTo->inputsCount] = -1;
+            nodeTo->inputLines[nodeTo->inputsCount] = NULL;
+            nodeTo->dirty = true;
+
+            // Start node outputs only contain lines that were added to inputs
+            for (int k = 0; k < nodeFrom->outputsCount; k++)
+            {
+                if (nodeFrom->outputs[k] == line->to)
+                {
+                    for (int j = k; j < nodeFrom->outputsCount - 1; j++) nodeFrom->outputs[j] = nodeFrom->outputs[j + 1];
+                    nodeFrom->outputsCount--;
+                    break;
+                }
+            }
+
+            break;
+        }
+    }
+}
+
+// Removes a node and its linked lines without calculating nodes values
+static void RemoveNode(FNodeContext context, FNode node)
+{
+    int id = node->id;
+
+    RemoveNodeLinks(context, node, true, true);
+
+    // Remove lines being linked from the node
+    for (int i = context->linesCount - 1; (i >= 0) && (context->pendingLinesCount > 0); i--)
+    {
+        if (((int)context->lines[i]->to == -1) && (context->lines[i]->from == id)) RemoveNodeLine(context, context->lines[i]);
+    }
+
+    int index = GetNodeIndex(context, id);
+
+    if (context->nodes[index]->outputs != NULL)
+    {
+        FNODE_FREE(context->nodes[index]->outputs);
+        context->usedMemory -= context->nodes[index]->outputsLimit*sizeof(int);
+        context->nodes[index]->outputs = NULL;
+    }
+
+    ArenaRelease(&context->nodesArena, context->nodes[index]);
+    context->nodes[index] = NULL;
+
+    for (int i = index; i < context->nodesCount; i++)
+    {
+        if ((i + 1) < context->nodesCount)
+        {
+            context->nodes[i] = context->nodes[i + 1];
+            context->nodesIndex[context->nodes[i]->id] = i;
+        }
+    }
+
+    context->nodesIndex[id] = -1;
+    ReleaseId(context, &context->nodesIds, id);
+    context->nodesCount--;
+    context->topologyChanged = true;
+    TraceLogFNode(false, "destroyed node id %i (index: %i) [USED RAM: %i bytes]", id, index, context->usedMemory);
+}
+
+// Removes a node input and output lines without calculating nodes values
+static void RemoveNodeLinks(FNodeContext context, FNode node, bool inputs, bool outputs)
+{
+    while (inputs && (node->inputsCount > 0)) RemoveNodeLine(context, node->inputLines[node->inputsCount - 1]);
+
+    // Output lines are found in the inputs lines of every output node
+    while (outputs && (node->outputsCount > 0))
+    {
+        FNode output = context->nodes[GetNodeIndex(context, node->outputs[node->outputsCount - 1])];
+
+        for (int i = output->inputsCount - 1; i >= 0; i--)
+        {
+            if (output->inputs[i] == (int)node->id)
+            {
+                RemoveNodeLine(context, output->inputLines[i]);
+                break;
+            }
+        }
+    }
+}
+
+// Removes a line from its nodes and lines pool without calculating nodes values
+static void RemoveNodeLine(FNodeContext context, FLine line)
+{
+    int id = line->id;
+    int index = line->index;
+
+    if ((index >= 0) && (index < context->linesCount) && (context->lines[index] == line))
+    {
+        if ((int)line->to != -1)
+        {
+            RemoveNodeLink(context, line);
+            context->topologyChanged = true;
+        }
+        else context->pendingLinesCount--;
+
+        // Last line fills the released pool index, lines order does not change nodes inputs order
+        context->linesCount--;
+
+        if (index < context->linesCount)
+        {
+            context->lines[index] = context->lines[context->linesCount];
+            context->lines[index]->index = index;
+        }
+
+        context->lines[context->linesCount] = NULL;
+        ArenaRelease(&context->linesArena, line);
+
+        ReleaseId(context, &context->linesIds, id);
+        TraceLogFNode(false, "destroyed line id %i (index: %i) [USED RAM: %i bytes]", id, index, context->usedMemory);
+    }
+    else TraceLogFNode(true, "error when trying to destroy line id %i due to index is out of bounds %i", id, index);
+}
+
+// Sorts nodes by their inputs dependencies
+static void UpdateEvaluationOrder(FNodeContext context)
+{
+    int *stack = (int *)FNODE_MALLOC(context->nodesCount*sizeof(int));            // Depth-first search nodes indexes stack
+    int *stackInput = (int *)FNODE_MALLOC(context->nodesCount*sizeof(int));       // Next input to visit of every stacked node
+    int *state = (int *)FNODE_MALLOC(context->nodesCount*sizeof(int));            // Node visit state (0 = not visited, 1 = in stack, 2 = sorted)
+    bool *skipped = (bool *)FNODE_MALLOC(context->nodesCount*sizeof(bool));       // Node is part of a cycle or depends on one
+    int stackCount = 0;
+
+    for (int i = 0; i < context->nodesCount; i++)
+    {
+        state[i] = 0;
+        skipped[i] = false;
+    }
+
+    // Sort nodes in depth-first post order so every node is placed after all its inputs
+    context->evaluationOrderCount = 0;
+    context->cycleDetected = false;
+
+    for (int i = 0; i < context->nodesCount; i++)
+    {
+        if (state[i] != 0) continue;
+
+        stack[0] = i;
+        stackInput[0] = 0;
+        stackCount = 1;
+        state[i] = 1;
+
+        while (stackCount > 0)
+        {
+            int current = stack[stackCount - 1];
+
+            if (stackInput[stackCount - 1] < context->nodes[current]->inputsCount)
+            {
+                int input = GetNodeIndex(context, context->nodes[current]->inputs[stackInput[stackCount - 1]]);
+                stackInput[stackCount - 1]++;
+
+                if (state[input] == 0)
+                {
+                    stack[stackCount] = input;
+                    stackInput[stackCount] = 0;
+                    stackCount++;
+                    state[input] = 1;
+                }
+                else if (state[input] == 1)
+                {
+                    // Input is still in stack, so every node between it and current node is part of a cycle
+                    for (int k = stackCount - 1; k >= 0; k--)
+                    {
+                        skipped[stack[k]] = true;
+                        if (stack[k] == input) break;
+                    }
+
+                    context->cycleDetected = true;
+                    TraceLogFNode(false, "cycle detected linking node id %i with node id %i, its values will not be calculated", context->nodes[input]->id, context->nodes[current]->id);
+                }
+                else if (skipped[input]) skipped[current] = true;
+            }
+            else
+            {
+                if (!skipped[current])
+                {
+                    context->evaluationOrder[context->evaluationOrderCount] = current;
+                    context->evaluationOrderCount++;
+                }
+
+                state[current] = 2;
+                stackCount--;
+
+                if ((stackCount > 0) && skipped[current]) skipped[stack[stackCount - 1]] = true;
+            }
+        }
+    }
+
+    FNODE_FREE(stack);
+    FNODE_FREE(stackInput);
+    FNODE_FREE(state);
+    FNODE_FREE(skipped);
+
+    context->topologyChanged = false;
+}
+
+// Adds an instruction to the lowered program
+static void EmitInstruction(FNodeContext context, FOpcode opcode, int width, int dst, int a, int b, int c, float value)
+{
+    // Grow program when it is full
+    if (context->programCount == context->programLimit)
+    {
+        int limit = ((context->programLimit > 0) ? context->programLimit*2 : NODES_POOL_LENGTH);
+
+        context->program = (FInstruction *)FNODE_REALLOC(context->program, limit*sizeof(FInstruction));
+        context->usedMemory += (limit - context->programLimit)*sizeof(FInstruction);
+        context->programLimit = limit;
+    }
+
+    context->program[context->programCount] = (FInstruction){ (unsigned char)opcode, (unsigned char)width, dst, a, b, c, value };
+    context->programCount++;
+}
+
+// Returns the output values count selected by a vertex color or sampler type value
+static int SelectorWidth(float value)
+{
+    int width = 1;
+
+    switch ((int)value)
+    {
+        case 0: width = 4; break;
+        case 1: width = 3; break;
+        default: break;
+    }
+
+    return width;
+}
+
+// Lowers nodes in evaluation order into a linear instructions program with resolved widths
+static void LowerProgram(FNodeContext context)
+{
+    // Grow program blocks and registers to fit all nodes
+    if (context->programBlocksLimit < context->nodesLimit)
+    {
+        context->programBlocks = (FProgramBlock *)FNODE_REALLOC(context->programBlocks, context->nodesLimit*sizeof(FProgramBlock));
+        context->registers = (float *)FNODE_REALLOC(context->registers, context->nodesLimit*MAX_VALUES*sizeof(float));
+        context->programWidths = (int *)FNODE_REALLOC(context->programWidths, context->nodesLimit*sizeof(int));
+        context->usedMemory += (context->nodesLimit - context->programBlocksLimit)*(sizeof(FProgramBlock) + MAX_VALUES*sizeof(float) + sizeof(int));
+        context->programBlocksLimit = context->nodesLimit;
+    }
+
+    // Registers start with current node values, nodes not lowered (linked to a cycle) keep them
+    for (int i = 0; i < context->nodesCount; i++)
+    {
+        context->programWidths[i] = context->nodes[i]->output.dataCount;
+        memcpy(context->registers + i*MAX_VALUES, context->nodes[i]->output.data, MAX_VALUES*sizeof(float));
+    }
+
+    context->programCount = 0;
+    context->programBlocksCount = 0;
+    context->programStale = false;
+
+    for (int o = 0; o < context->evaluationOrderCount; o++)
+    {
+        int i = context->evaluationOrder[o];
+        FNode node = context->nodes[i];
+        FProgramBlock *block = &context->programBlocks[context->programBlocksCount];
+        int in[MAX_INPUTS] = { 0 };
+        int n = node->inputsCount;
+        int dst = i*MAX_VALUES;
+        int width = 0;
+
+        block->node = i;
+        block->first = context->programCount;
+        block->inputsCount = n;
+        memset(context->registers + dst, 0, MAX_VALUES*sizeof(float));
+
+        for (int k = 0; k < n; k++)
+        {
+            in[k] = GetNodeIndex(context, node->inputs[k]);
+            block->inputs[k] = in[k];
+        }
+
+        #define REGISTER(k)     (in[k]*MAX_VALUES)
+        #define INPUT_WIDTH(k)  (context->programWidths[in[k]])
+
+        if (node->type <= FNODE_VECTOR4)
+        {
+            width = node->output.dataCount;
+            EmitInstruction(context, FOP_LOAD, width, dst, i, 0, 0, 0.0f);
+        }
+        else if (n == 0) width = 0;
+        else if (node->type < FNODE_APPEND)
+        {
+            // Operators fold every input into the first input values
+            width = INPUT_WIDTH(0);
+            EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+
+            for (int k = 1; k < n; k++)
+            {
+                switch (node->type)
+                {
+                    case FNODE_ADD: EmitInstruction(context, FOP_ADD, width, dst, REGISTER(k), 0, 0, 0.0f); break;
+                    case FNODE_SUBTRACT: EmitInstruction(context, FOP_SUBTRACT, width, dst, REGISTER(k), 0, 0, 0.0f); break;
+                    case FNODE_MULTIPLY:
+                    {
+                        if (INPUT_WIDTH(k) == 1) EmitInstruction(context, FOP_SCALE, width, dst, REGISTER(k), 0, 0, 0.0f);
+                        else if ((INPUT_WIDTH(k) == 16) && (width == 4)) EmitInstruction(context, FOP_MATRIXVECTOR, 4, dst, REGISTER(k), 0, 0, 0.0f);
+                        else if ((INPUT_WIDTH(k) == 4) && (width == 16))
+                        {
+                            EmitInstruction(context, FOP_VECTORMATRIX, 16, dst, REGISTER(k), 0, 0, 0.0f);
+                            width = 4;
+                        }
+                        else EmitInstruction(context, FOP_MULTIPLY, width, dst, REGISTER(k), 0, 0, 0.0f);
+                    } break;
+                    case FNODE_DIVIDE:
+                    {
+                        if (INPUT_WIDTH(k) == 1) EmitInstruction(context, FOP_DIVIDEBY, width, dst, REGISTER(k), 0, 0, 0.0f);
+                        else EmitInstruction(context, FOP_DIVIDE, width, dst, REGISTER(k), 0, 0, 0.0f);
+                    } break;
+                    default: break;
+                }
+            }
+        }
+        else if (node->type == FNODE_APPEND)
+        {
+            // Append inputs values one after another until output values are full
+            for (int k = 0; k < n; k++)
+            {
+                int count = INPUT_WIDTH(k);
+                if ((width + count) > MAX_VALUES) count = MAX_VALUES - width;
+
+                EmitInstruction(context, FOP_COPY, count, dst + width, REGISTER(k), 0, 0, 0.0f);
+                width += count;
+            }
+        }
+        else
+        {
+            width = INPUT_WIDTH(0);
+
+            switch (node->type)
+            {
+                case FNODE_ONEMINUS:
+                case FNODE_ABS:
+                case FNODE_COS:
+                case FNODE_SIN:
+                case FNODE_TAN:
+                case FNODE_RECIPROCAL:
+                case FNODE_SQRT:
+                case FNODE_TRUNC:
+                case FNODE_ROUND:
+                case FNODE_CEIL:
+                case FNODE_CLAMP01:
+                case FNODE_EXP2:
+                {
+                    FOpcode opcode = FOP_ONEMINUS;
+
+                    switch (node->type)
+                    {
+                        case FNODE_ABS: opcode = FOP_ABS; break;
+                        case FNODE_COS: opcode = FOP_COS; break;
+                        case FNODE_SIN: opcode = FOP_SIN; break;
+                        case FNODE_TAN: opcode = FOP_TAN; break;
+                        case FNODE_RECIPROCAL: opcode = FOP_RECIPROCAL; break;
+                        case FNODE_SQRT: opcode = FOP_SQRT; break;
+                        case FNODE_TRUNC: opcode = FOP_TRUNC; break;
+                        case FNODE_ROUND: opcode = FOP_ROUND; break;
+                        case FNODE_CEIL: opcode = FOP_CEIL; break;
+                        case FNODE_CLAMP01: opcode = FOP_CLAMP01; break;
+                        case FNODE_EXP2: opcode = FOP_EXP2; break;
+                        default: break;
+                    }
+
+                    EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+                    EmitInstruction(context, opcode, width, dst, 0, 0, 0, 0.0f);
+                } break;
+                case FNODE_DEG2RAD:
+                case FNODE_RAD2DEG:
+                case FNODE_NEGATE:
+                {
+                    float value = ((node->type == FNODE_DEG2RAD) ? DEG2RAD : ((node->type == FNODE_RAD2DEG) ? RAD2DEG : -1.0f));
+
+                    EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+                    EmitInstruction(context, FOP_SCALEVALUE, width, dst, 0, 0, 0, value);
+                } break;
+                case FNODE_NORMALIZE:
+                {
+                    EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+                    if ((width >= 2) && (width <= 4)) EmitInstruction(context, FOP_NORMALIZE, width, dst, 0, 0, 0, 0.0f);
+                } break;
+                case FNODE_VERTEXCOLOR:
+                {
+                    if (n == 1)
+                    {
+                        // Output width depends on input value, program is lowered again if it changes
+                        EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+                        width = SelectorWidth(context->nodes[in[0]]->output.data[0]);
+                        EmitInstruction(context, FOP_SELECT, width, dst, REGISTER(0), 0, 0, 0.0f);
+                    }
+                    else width = 0;
+                } break;
+                case FNODE_POWER:
+                case FNODE_STEP:
+                case FNODE_POSTERIZE:
+                {
+                    if (n == 2)
+                    {
+                        EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+
+                        if (INPUT_WIDTH(1) == 1)
+                        {
+                            if (node->type == FNODE_POWER) EmitInstruction(context, FOP_POWER, width, dst, REGISTER(1), 0, 0, 0.0f);
+                            else if (node->type == FNODE_STEP) EmitInstruction(context, FOP_STEP, 1, dst, REGISTER(1), 0, 0, 0.0f);
+                            else EmitInstruction(context, FOP_POSTERIZE, width, dst, REGISTER(1), 0, 0, 0.0f);
+                        }
+                        else if (node->type != FNODE_POSTERIZE) TraceLogFNode(false, "values count of node %i should be 1 because it is an exponent (currently count: %i)", context->nodes[in[1]]->id, INPUT_WIDTH(1));
+                    }
+                    else width = 0;
+                } break;
+                case FNODE_MAX:
+                case FNODE_MIN:
+                {
+                    EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+                    for (int k = 1; k < n; k++) EmitInstruction(context, ((node->type == FNODE_MAX) ? FOP_MAX : FOP_MIN), width, dst, REGISTER(k), 0, 0, 0.0f);
+                } break;
+                case FNODE_LERP:
+                {
+                    if (n == 3)
+                    {
+                        if ((width >= 1) && (width <= 4)) EmitInstruction(context, FOP_LERP, width, dst, REGISTER(0), REGISTER(1), REGISTER(2), 0.0f);
+                        else EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+                    }
+                    else width = 0;
+                } break;
+                case FNODE_SMOOTHSTEP:
+                {
+                    if (n == 3) EmitInstruction(context, FOP_SMOOTHSTEP, width, dst, REGISTER(0), REGISTER(1), REGISTER(2), 0.0f);
+                    else width = 0;
+                } break;
+                case FNODE_CROSSPRODUCT:
+                {
+                    if (n == 2)
+                    {
+                        width = 3;
+                        EmitInstruction(context, FOP_CROSSPRODUCT, width, dst, REGISTER(0), REGISTER(1), 0, 0.0f);
+                    }
+                    else width = 0;
+                } break;
+                case FNODE_DESATURATE:
+                {
+                    if (n == 2)
+                    {
+                        EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+                        EmitInstruction(context, FOP_DESATURATE, width, dst, REGISTER(1), 0, 0, 0.0f);
+                    }
+                    else width = 0;
+                } break;
+                case FNODE_DISTANCE:
+                case FNODE_DOTPRODUCT:
+                {
+                    if (n == 2)
+                    {
+                        EmitInstruction(context, ((node->type == FNODE_DISTANCE) ? FOP_DISTANCE : FOP_DOTPRODUCT), width, dst, REGISTER(0), REGISTER(1), 0, 0.0f);
+                        width = 1;
+                    }
+                    else width = 0;
+                } break;
+                case FNODE_LENGTH:
+                {
+                    EmitInstruction(context, FOP_LENGTH, width, dst, REGISTER(0), 0, 0, 0.0f);
+                    width = 1;
+                } break;
+                case FNODE_MULTIPLYMATRIX:
+                {
+                    EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+                    if ((n == 2) && (width == 16) && (INPUT_WIDTH(1) == 16)) EmitInstruction(context, FOP_MATRIXMULTIPLY, width, dst, REGISTER(1), 0, 0, 0.0f);
+                } break;
+                case FNODE_TRANSPOSE:
+                {
+                    EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+                    if (width == 16) EmitInstruction(context, FOP_TRANSPOSE, width, dst, 0, 0, 0, 0.0f);
+                } break;
+                case FNODE_PROJECTION:
+                case FNODE_REJECTION:
+                {
+                    if (n == 2)
+                    {
+                        EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+                        if ((width >= 2) && (width <= 4)) EmitInstruction(context, ((node->type == FNODE_PROJECTION) ? FOP_PROJECTION : FOP_REJECTION), width, dst, REGISTER(0), REGISTER(1), 0, 0.0f);
+                    }
+                    else width = 0;
+                } break;
+                case FNODE_HALFDIRECTION:
+                {
+                    if (n == 2)
+                    {
+                        bool check = ((context->nodes[in[0]]->type <= FNODE_E) || (context->nodes[in[0]]->type >= FNODE_MATRIX));
+                        if (check) check = ((context->nodes[in[1]]->type <= FNODE_E) || (context->nodes[in[1]]->type >= FNODE_MATRIX));
+
+                        // Values stay cleared when any input is not a valid direction
+                        if (check)
+                        {
+                            EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+                            if ((width >= 2) && (width <= 4)) EmitInstruction(context, FOP_HALFDIRECTION, width, dst, REGISTER(0), REGISTER(1), 0, 0.0f);
+                        }
+                    }
+                    else width = 0;
+                } break;
+                case FNODE_SAMPLER2D:
+                {
+                    if (n == 2)
+                    {
+                        // Output width depends on sampler type value, program is lowered again if it changes
+                        EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f);
+                        width = SelectorWidth(context->nodes[in[1]]->output.data[0]);
+                        EmitInstruction(context, FOP_SELECT, width, dst, REGISTER(1), 0, 0, 0.0f);
+                    }
+                    else width = 0;
+                } break;
+                default: EmitInstruction(context, FOP_COPY, width, dst, REGISTER(0), 0, 0, 0.0f); break;
+            }
+        }
+
+        #undef REGISTER
+        #undef INPUT_WIDTH
+
+        context->programWidths[i] = width;
+        block->width = width;
+        block->count = context->programCount - block->first;
+        block->written = width;
+
+        for (int pc = block->first; pc < context->programCount; pc++)
+        {
+            int end = context->program[pc].dst - dst + ((context->program[pc].opcode == FOP_VECTORMATRIX) ? MAX_VALUES : context->program[pc].width);
+            if (end > block->written) block->written = end;
+        }
+        context->programBlocksCount++;
+    }
+}
+
+// Executes a lowered instruction over registers values (except loads and width selectors)
+static void ExecuteInstruction(const FInstruction *ins, float *d, const float *a, const float *b, const float *c)
+{
+    int w = ins->width;
+
+    switch (ins->opcode)
+    {
+        case FOP_COPY: for (int j = 0; j < w; j++) d[j] = a[j]; break;
+        case FOP_ADD: kernels.add(d, a, w); break;
+        case FOP_SUBTRACT: kernels.subtract(d, a, w); break;
+        case FOP_MULTIPLY: kernels.multiply(d, a, w); break;
+        case FOP_DIVIDE: kernels.divide(d, a, w); break;
+        case FOP_SCALE: kernels.scale(d, a[0], w); break;
+        case FOP_SCALEVALUE: kernels.scale(d, ins->value, w); break;
+        case FOP_DIVIDEBY: kernels.divideBy(d, a[0], w); break;
+        case FOP_MIN: kernels.min(d, a, w); break;
+        case FOP_MAX: kernels.max(d, a, w); break;
+        case FOP_CLAMP01: kernels.clamp(d, 0.0f, 1.0f, w); break;
+        case FOP_MATRIXVECTOR: kernels.matrixVector(d, a); break;
+        case FOP_VECTORMATRIX:
+        {
+            float vector[4] = { a[0], a[1], a[2], a[3] };
+            kernels.matrixVector(vector, d);
+
+            for (int j = 0; j < MAX_VALUES; j++) d[j] = ((j < 4) ? vector[j] : 0.0f);
+        } break;
+        case FOP_MATRIXMULTIPLY: kernels.matrixMultiply(d, d, a); break;
+        case FOP_ONEMINUS: for (int j = 0; j < w; j++) d[j] = 1 - d[j]; break;
+        case FOP_ABS: for (int j = 0; j < w; j++) { if (d[j] < 0) d[j] *= -1; } break;
+        case FOP_COS: for (int j = 0; j < w; j++) d[j] = FCos(d[j]); break;
+        case FOP_SIN: for (int j = 0; j < w; j++) d[j] = FSin(d[j]); break;
+        case FOP_TAN: for (int j = 0; j < w; j++) d[j] = FTan(d[j]); break;
+        case FOP_RECIPROCAL: for (int j = 0; j < w; j++) d[j] = 1/d[j]; break;
+        case FOP_SQRT: for (int j = 0; j < w; j++) d[j] = FSquareRoot(d[j]); break;
+        case FOP_TRUNC: for (int j = 0; j < w; j++) d[j] = FTrunc(d[j]); break;
+        case FOP_ROUND: for (int j = 0; j < w; j++) d[j] = FRound(d[j]); break;
+        case FOP_CEIL: for (int j = 0; j < w; j++) d[j] = FCeil(d[j]); break;
+        case FOP_EXP2: for (int j = 0; j < w; j++) d[j] = FPower(2.0f, d[j]); break;
+        case FOP_POWER: for (int j = 0; j < w; j++) d[j] = FPower(d[j], a[0]); break;
+        case FOP_POSTERIZE: for (int j = 0; j < w; j++) d[j] = FPosterize(d[j], a[0]); break;
+        case FOP_STEP: d[0] = ((d[0] <= a[0]) ? 1.0f : 0.0f); break;
+        case FOP_LERP: for (int j = 0; j < w; j++) d[j] = FLerp(a[j], b[j], c[0]); break;
+        case FOP_SMOOTHSTEP: for (int j = 0; j < w; j++) d[j] = FSmoothStep(a[j], b[j], c[j]); break;
+        case FOP_NORMALIZE:
+        {
+            if (w == 2)
+            {
+                Vector2 vector = FVector2Normalize((Vector2){ d[0], d[1] });
+                d[0] = vector.x; d[1] = vector.y;
+            }
+            else if (w == 3)
+            {
+                Vector3 vector = FVector3Normalize((Vector3){ d[0], d[1], d[2] });
+                d[0] = vector.x; d[1] = vector.y; d[2] = vector.z;
+            }
+            else
+            {
+                Vector4 vector = FVector4Normalize((Vector4){ d[0], d[1], d[2], d[3] });
+                d[0] = vector.x; d[1] = vector.y; d[2] = vector.z; d[3] = vector.w;
+            }
+        } break;
+        case FOP_CROSSPRODUCT:
+        {
+            Vector3 cross = FCrossProduct((Vector3){ a[0], a[1], a[2] }, (Vector3){ b[0], b[1], b[2] });
+            d[0] = cross.x; d[1] = cross.y; d[2] = cross.z;
+        } break;
+        case FOP_DESATURATE:
+        {
+            float amount = FClamp(a[0], 0.0f, 1.0f);
+            float luminance = 0.3f*d[0] + 0.6f*d[1] + 0.1f*d[2];
+
+            for (int j = 0; (j < 3) && (j < w); j++) d[j] = d[j] + amount*(luminance - d[j]);
+        } break;
+        case FOP_DISTANCE:
+        {
+            switch (w)
+            {
+                case 1: d[0] = b[0] - a[0]; break;
+                case 2: d[0] = FVector2Length((Vector2){ b[0] - a[0], b[1] - a[1] }); break;
+                case 3: d[0] = FVector3Length((Vector3){ b[0] - a[0], b[1] - a[1], b[2] - a[2] }); break;
+                case 4: d[0] = FVector4Length((Vector4){ b[0] - a[0], b[1] - a[1], b[2] - a[2], b[3] - a[3] }); break;
+                default: d[0] = a[0]; break;
+            }
+        } break;
+        case FOP_DOTPRODUCT:
+        {
+            switch (w)
+            {
+                case 2: d[0] = FVector2Dot((Vector2){ a[0], a[1] }, (Vector2){ b[0], b[1] }); break;
+                case 3: d[0] = FVector3Dot((Vector3){ a[0], a[1], a[2] }, (Vector3){ b[0], b[1], b[2] }); break;
+                case 4: d[0] = FVector4Dot((Vector4){ a[0], a[1], a[2], a[3] }, (Vector4){ b[0], b[1], b[2], b[3] }); break;
+                default: d[0] = a[0]; break;
+            }
+        } break;
+        case FOP_LENGTH:
+        {
+            switch (w)
+            {
+                case 2: d[0] = FVector2Length((Vector2){ a[0], a[1] }); break;
+                case 3: d[0] = FVector3Length((Vector3){ a[0], a[1], a[2] }); break;
+                case 4: d[0] = FVector4Length((Vector4){ a[0], a[1], a[2], a[3] }); break;
+                default: d[0] = a[0]; break;
+            }
+        } break;
+        case FOP_TRANSPOSE:
+        {
+            Matrix matrix;
+            memcpy(&matrix, d, sizeof(Matrix));
+            FMatrixTranspose(&matrix);
+            memcpy(d, &matrix, sizeof(Matrix));
+        } break;
+        case FOP_PROJECTION:
+        case FOP_REJECTION:
+        case FOP_HALFDIRECTION:
+        {
+            float output[4] = { 0 };
+
+            if (w == 2)
+            {
+                Vector2 vectorA = { a[0], a[1] };
+                Vector2 vectorB = { b[0], b[1] };
+                Vector2 vector = { 0 };
+
+                if (ins->opcode == FOP_PROJECTION) vector = FVector2Projection(vectorA, vectorB);
+                else if (ins->opcode == FOP_REJECTION) vector = FVector2Rejection(vectorA, vectorB);
+                else
+                {
+                    vectorA = FVector2Normalize(vectorA);
+                    vectorB = FVector2Normalize(vectorB);
+                    vector = (Vector2){ vectorA.x + vectorB.x, vectorA.y + vectorB.y };
+                }
+
+                memcpy(output, &vector, sizeof(Vector2));
+            }
+            else if (w == 3)
+            {
+                Vector3 vectorA = { a[0], a[1], a[2] };
+                Vector3 vectorB = { b[0], b[1], b[2] };
+                Vector3 vector = { 0 };
+
+                if (ins->opcode == FOP_PROJECTION) vector = FVector3Projection(vectorA, vectorB);
+                else if (ins->opcode == FOP_REJECTION) vector = FVector3Rejection(vectorA, vectorB);
+                else
+                {
+                    vectorA = FVector3Normalize(vectorA);
+                    vectorB = FVector3Normalize(vectorB);
+                    vector = (Vector3){ vectorA.x + vectorB.x, vectorA.y + vectorB.y, vectorA.z + vectorB.z };
+                }
+
+                memcpy(output, &vector, sizeof(Vector3));
+            }
+            else
+            {
+                Vector4 vectorA = { a[0], a[1], a[2], a[3] };
+                Vector4 vectorB = { b[0], b[1], b[2], b[3] };
+                Vector4 vector = { 0 };
+
+                if (ins->opcode == FOP_PROJECTION) vector = FVector4Projection(vectorA, vectorB);
+                else if (ins->opcode == FOP_REJECTION) vector = FVector4Rejection(vectorA, vectorB);
+                else
+                {
+                    vectorA = FVector4Normalize(vectorA);
+                    vectorB = FVector4Normalize(vectorB);
+                    vector = (Vector4){ vectorA.x + vectorB.x, vectorA.y + vectorB.y, vectorA.z + vectorB.z, vectorA.w + vectorB.w };
+                }
+
+                memcpy(output, &vector, sizeof(Vector4));
+            }
+
+            memcpy(d, output, w*sizeof(float));
+        } break;
+        default: break;
+    }
+}
+
+// Executes lowered program blocks whose node or inputs changed, or all of them
+static void RunProgram(FNodeContext context, bool all)
+{
+    float *r = context->registers;
+
+    for (int p = 0; p < context->programBlocksCount; p++)
+    {
+        FProgramBlock *block = &context->programBlocks[p];
+        int i = block->node;
+
+        // Skip nodes without pending changes whose inputs kept the same values
+        bool update = (all || context->nodes[i]->dirty);
+        for (int k = 0; (k < block->inputsCount) && !update; k++) update = context->nodesChanged[block->inputs[k]];
+
+        if (!update) continue;
+
+        for (int pc = block->first; pc < (block->first + block->count); pc++)
+        {
+            const FInstruction *ins = &context->program[pc];
+            float *d = r + ins->dst;
+            const float *a = r + ins->a;
+            const float *b = r + ins->b;
+            const float *c = r + ins->c;
+            int w = ins->width;
+
+            switch (ins->opcode)
+            {
+                case FOP_LOAD: memcpy(d, context->nodes[ins->a]->output.data, w*sizeof(float)); break;
+                case FOP_COPY: for (int j = 0; j < w; j++) d[j] = a[j]; break;
+
+                // Vectors are too short to pay for a kernel call, only matrices use operator kernels
+                case FOP_ADD: if (w > 4) kernels.add(d, a, w); else { for (int j = 0; j < w; j++) d[j] += a[j]; } break;
+                case FOP_SUBTRACT: if (w > 4) kernels.subtract(d, a, w); else { for (int j = 0; j < w; j++) d[j] -= a[j]; } break;
+                case FOP_MULTIPLY: if (w > 4) kernels.multiply(d, a, w); else { for (int j = 0; j < w; j++) d[j] *= a[j]; } break;
+                case FOP_DIVIDE: if (w > 4) kernels.divide(d, a, w); else { for (int j = 0; j < w; j++) d[j] /= a[j]; } break;
+                case FOP_SCALE: if (w > 4) kernels.scale(d, a[0], w); else { for (int j = 0; j < w; j++) d[j] *= a[0]; } break;
+                case FOP_SELECT:
+                {
+                    if (SelectorWidth(a[0]) != w) context->programStale = true;
+                    for (int j = w; j < MAX_VALUES; j++) d[j] = 0.0f;
+                } break;
+                default: ExecuteInstruction(ins, d, a, b, c); break;
+            }
+        }
+
+        // Stop when output widths changed, the program is lowered again and executed from the start
+        if (context->programStale) return;
+
+        // Keep register values beyond output width cleared
+        float *values = r + i*MAX_VALUES;
+        if (block->written > block->width) memset(values + block->width, 0, (block->written - block->width)*sizeof(float));
+
+        // Propagate changes only when output values are different from previous calculation
+        FNode node = context->nodes[i];
+        bool resized = (node->output.dataCount != block->width);
+        bool changed = (node->dirty || resized);
+        for (int k = 0; (k < block->width) && !changed; k++) changed = (node->output.data[k] != values[k]);
+        context->nodesChanged[i] = changed;
+        node->dirty = false;
+
+        if (changed)
+        {
+            for (int k = 0; k < (resized ? MAX_VALUES : block->width); k++) node->output.data[k] = values[k];
+            node->output.dataCount = block->width;
+
+            // Values texts are only formatted for nodes in view, the other nodes are formatted when they or their output lines are drawn
+            if (node->type <= FNODE_VECTOR4) UpdateNodeShapes(node);
+            else if (IsNodeVisible(context, node)) UpdateNodeView(node);
+            else
+            {
+                node->outputView.stale = true;
+
+                // Shapes always follow output values count, so lines and view checks use current node size
+                if (resized) UpdateNodeShapes(node);
+            }
+        }
+    }
+}
+
+// Check if a node shape is inside nodes area camera view
+static bool IsNodeVisible(FNodeContext context, FNode node)
+{
+    float x = node->shape.x + context->camera.offset.x;
+    float y = node->shape.y + context->camera.offset.y;
+
+    return ((x + node->shape.width >= 0) && (x <= context->screenSize.x) && (y + node->shape.height >= 0) && (y <= context->screenSize.y));
+}
+
+// Formats node output values texts and updates its shapes
+static void UpdateNodeView(FNode node)
+{
+    for (int k = 0; k < node->output.dataCount; k++) FFloatToString(node->outputView.texts[k], node->output.data[k]);
+
+    node->outputView.stale = false;
+    UpdateNodeShapes(node);
+}
+
+// Remaps output node instructions to batch slots and splits per-item nodes from invariant ones
+static void BuildBatch(FNodeContext context, FBatch *batch)
+{
+    int length = ((context->nodesCount > 0) ? context->nodesCount : 1);
+    bool *varying = (bool *)FNODE_MALLOC(length*sizeof(bool));     // Node values change from an item to another state
+    int *stack = (int *)FNODE_MALLOC(length*sizeof(int));          // Nodes pending to visit their inputs
+
+    batch->slots = (int *)FNODE_MALLOC(length*sizeof(int));
+    batch->invariants = (int *)FNODE_MALLOC(length*sizeof(int));
+    batch->invariantSlots = (int *)FNODE_MALLOC(length*sizeof(int));
+    batch->blocks = (FProgramBlock *)FNODE_MALLOC(((context->programBlocksCount > 0) ? context->programBlocksCount : 1)*sizeof(FProgramBlock));
+    batch->program = (FInstruction *)FNODE_MALLOC(((context->programCount > 0) ? context->programCount : 1)*sizeof(FInstruction));
+    batch->nodes = context->nodes;
+    batch->outputSlot = -1;
+
+    for (int i = 0; i < context->nodesCount; i++)
+    {
+        batch->slots[i] = -1;
+        varying[i] = false;
+    }
+
+    // Assign a slot to every node linked directly or indirectly to vertex or fragment output node
+    FNodeType outputType = (batch->fragment ? FNODE_FRAGMENT : FNODE_VERTEX);
+    int output = -1;
+
+    for (int i = 0; (i < context->nodesCount) && (output == -1); i++)
+    {
+        if ((context->nodes[i]->type == outputType) && (context->nodes[i]->inputsCount > 0)) output = GetNodeIndex(context, context->nodes[i]->inputs[0]);
+    }
+
+    if (output != -1)
+    {
+        int stackCount = 0;
+        batch->slots[output] = batch->slotsCount++;
+        stack[stackCount++] = output;
+
+        while (stackCount > 0)
+        {
+            int current = stack[--stackCount];
+
+            for (int k = 0; k < context->nodes[current]->inputsCount; k++)
+            {
+                int input = GetNodeIndex(context, context->nodes[current]->inputs[k]);
+
+                if ((input != -1) && (batch->slots[input] == -1))
+                {
+                    batch->slots[input] = batch->slotsCount++;
+                    stack[stackCount++] = input;
+                }
+            }
+        }
+
+        batch->outputSlot = batch->slots[output];
+        batch->outputWidth = context->nodes[output]->output.dataCount;
+    }
+
+    // Copy blocks of nodes which depend on vertex attributes or sampled texels, in evaluation order
+    for (int p = 0; p < context->programBlocksCount; p++)
+    {
+        const FProgramBlock *block = &context->programBlocks[p];
+        int i = block->node;
+
+        if (batch->slots[i] == -1) continue;
+
+        if (batch->fragment) varying[i] = ((context->nodes[i]->type == FNODE_SAMPLER2D) || (context->nodes[i]->type == FNODE_VERTEXCOLOR));
+        else varying[i] = ((context->nodes[i]->type == FNODE_VERTEXPOSITION) || (context->nodes[i]->type == FNODE_VERTEXNORMAL) || (context->nodes[i]->type == FNODE_VERTEXCOLOR) || (context->nodes[i]->type == FNODE_SAMPLER2D));
+        for (int k = 0; k < block->inputsCount; k++) varying[i] |= varying[block->inputs[k]];
+
+        if (!varying[i]) continue;
+
+        FProgramBlock *batchBlock = &batch->blocks[batch->blocksCount];
+        *batchBlock = *block;
+        batchBlock->first = batch->programCount;
+
+        #define REMAP(offset)   ((batch->slots[(offset)/MAX_VALUES] != -1) ? (batch->slots[(offset)/MAX_VALUES]*MAX_VALUES + (offset)%MAX_VALUES) : 0)
+
+        for (int pc = block->first; pc < (block->first + block->count); pc++)
+        {
+            FInstruction instruction = context->program[pc];
+
+            instruction.dst = REMAP(instruction.dst);
+            instruction.a = REMAP(instruction.a);
+            instruction.b = REMAP(instruction.b);
+            instruction.c = REMAP(instruction.c);
+
+            batch->program[batch->programCount] = instruction;
+            batch->programCount++;
+        }
+
+        #undef REMAP
+
+        batch->blocksCount++;
+    }
+
+    // Remaining nodes values are the same for every item
+    for (int i = 0; i < context->nodesCount; i++)
+    {
+        if ((batch->slots[i] != -1) && !varying[i])
+        {
+            batch->invariants[batch->invariantsCount] = i;
+            batch->invariantSlots[batch->invariantsCount] = batch->slots[i];
+            batch->invariantsCount++;
+        }
+    }
+
+    FNODE_FREE(varying);
+    FNODE_FREE(stack);
+}
+
+// Runs batch tasks on worker threads and returns elapsed time
+static double RunBatch(FBatch *batch, int tasksCount, int workersCount)
+{
+#if defined(FNODE_THREADS)
+    // Use a worker per CPU core when workers count is not specified
+    if (workersCount <= 0) workersCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (workersCount > MAX_WORKERS) workersCount = MAX_WORKERS;
+    if (workersCount > tasksCount) workersCount = tasksCount;
+    if (workersCount < 1) workersCount = 1;
+
+    // Every worker starts with a contiguous range of tasks and its own registers
+    FBatchWorker workers[MAX_WORKERS] = { 0 };
+    int lanesSize = ((batch->slotsCount > 0) ? batch->slotsCount : 1)*MAX_VALUES*BATCH_CHUNK_LENGTH*sizeof(float);
+
+    batch->workers = workers;
+    batch->workersCount = workersCount;
+
+    for (int i = 0; i < workersCount; i++)
+    {
+        workers[i].batch = batch;
+        workers[i].lanes = (float *)FNODE_MALLOC(lanesSize);
+        workers[i].next = tasksCount*i/workersCount;
+        workers[i].last = tasksCount*(i + 1)/workersCount;
+    }
+
+    double startTime = GetTime();
+
+#if defined(FNODE_THREADS)
+    pthread_t threads[MAX_WORKERS];
+    bool started[MAX_WORKERS] = { 0 };
+
+    // First worker runs on current thread, tasks of workers which could not be started are stolen
+    for (int i = 1; i < workersCount; i++) started[i] = (pthread_create(&threads[i], NULL, RunBatchWorker, &workers[i]) == 0);
+
+    RunBatchWorker(&workers[0]);
+
+    for (int i = 1; i < workersCount; i++)
+    {
+        if (started[i]) pthread_join(threads[i], NULL);
+    }
+#else
+    RunBatchWorker(&workers[0]);
+#endif
+
+    double elapsedTime = GetTime() - startTime;
+
+    for (int i = 0; i < workersCount; i++) FNODE_FREE(workers[i].lanes);
+    batch->workers = NULL;
+
+    return elapsedTime;
+}
+
+// Runs worker range tasks and then steals remaining tasks from other workers
+static void *RunBatchWorker(void *data)
+{
+    FBatchWorker *worker = (FBatchWorker *)data;
+    FBatch *batch = worker->batch;
+    int index = (int)(worker - batch->workers);
+
+    memset(worker->lanes, 0, ((batch->slotsCount > 0) ? batch->slotsCount : 1)*MAX_VALUES*BATCH_CHUNK_LENGTH*sizeof(float));
+
+    // Invariant nodes lanes are filled once because no instruction writes them
+    for (int k = 0; k < batch->invariantsCount; k++)
+    {
+        const float *values = batch->nodes[batch->invariants[k]]->output.data;
+        float *lanes = worker->lanes + batch->invariantSlots[k]*MAX_VALUES*BATCH_CHUNK_LENGTH;
+
+        for (int j = 0; j < MAX_VALUES; j++)
+        {
+            for (int l = 0; l < BATCH_CHUNK_LENGTH; l++) lanes[j*BATCH_CHUNK_LENGTH + l] = values[j];
+        }
+    }
+
+    // Tasks are taken one by one from the front of a range, so a worker that finishes early takes the rest of slower ranges
+    for (int k = 0; k < batch->workersCount; k++)
+    {
+        FBatchWorker *victim = &batch->workers[(index + k)%batch->workersCount];
+
+        for (int task = FETCH_ADD(&victim->next, 1); task < victim->last; task = FETCH_ADD(&victim->next, 1)) RunBatchTask(batch, worker->lanes, task);
+    }
+
+    return NULL;
+}
+
+// Calculates output values of a chunk of vertices or a tile of texels
+static void RunBatchTask(FBatch *batch, float *lanes, int task)
+{
+    if (!batch->fragment)
+    {
+        const Mesh *mesh = &batch->mesh;
+        int first = task*BATCH_CHUNK_LENGTH;
+        int count = mesh->vertexCount - first;
+        if (count > BATCH_CHUNK_LENGTH) count = BATCH_CHUNK_LENGTH;
+        float texcoords[2*BATCH_CHUNK_LENGTH] = { 0 };
+
+        // Vertex samplers read texels at vertex texture coordinates
+        if (mesh->texcoords != NULL)
+        {
+            for (int l = 0; l < count; l++)
+            {
+                texcoords[l] = mesh->texcoords[(first + l)*2];
+                texcoords[BATCH_CHUNK_LENGTH + l] = mesh->texcoords[(first + l)*2 + 1];
+            }
+        }
+
+        RunBatchChunk(batch, lanes, first, count, texcoords, NULL);
+
+        // Vertices keep their position when vertex output node is not linked
+        for (int l = 0; l < count; l++)
+        {
+            float *position = batch->positions + (first + l)*4;
+
+            if (batch->outputSlot != -1) GetBatchOutput(batch, lanes, l, position);
+            else
+            {
+                position[0] = mesh->vertices[(first + l)*3];
+                position[1] = mesh->vertices[(first + l)*3 + 1];
+                position[2] = mesh->vertices[(first + l)*3 + 2];
+                position[3] = 1.0f;
+            }
+        }
+    }
+    else
+    {
+        int width = batch->image.width;
+        int height = batch->image.height;
+        int tileX = (task%((width + BAKE_TILE_SIZE - 1)/BAKE_TILE_SIZE))*BAKE_TILE_SIZE;
+        int tileY = (task/((width + BAKE_TILE_SIZE - 1)/BAKE_TILE_SIZE))*BAKE_TILE_SIZE;
+        int tileWidth = (((width - tileX) < BAKE_TILE_SIZE) ? (width - tileX) : BAKE_TILE_SIZE);
+        int tileHeight = (((height - tileY) < BAKE_TILE_SIZE) ? (height - tileY) : BAKE_TILE_SIZE);
+        int count = tileWidth*tileHeight;
+        float texcoords[2*BATCH_CHUNK_LENGTH] = { 0 };
+        bool discarded[BATCH_CHUNK_LENGTH] = { 0 };
+
+        // Texels are sampled at their centers
+        for (int l = 0; l < count; l++)
+        {
+            texcoords[l] = (tileX + l%tileWidth + 0.5f)/width;
+            texcoords[BATCH_CHUNK_LENGTH + l] = (tileY + l/tileWidth + 0.5f)/height;
+        }
+
+        RunBatchChunk(batch, lanes, 0, count, texcoords, discarded);
+
+        // Texels stay transparent when fragment output node is not linked or they were discarded
+        Color *pixels = (Color *)batch->image.data;
+
+        for (int l = 0; l < count; l++)
+        {
+            float color[4] = { 0 };
+            unsigned char channels[4] = { 0 };
+
+            if ((batch->outputSlot != -1) && !discarded[l]) GetBatchOutput(batch, lanes, l, color);
+
+            for (int k = 0; k < 4; k++)
+            {
+                float value = FClamp(color[k], 0.0f, 1.0f);
+                channels[k] = ((value == value) ? (unsigned char)(value*255.0f + 0.5f) : 0);
+            }
+
+            pixels[(tileY + l/tileWidth)*width + tileX + l%tileWidth] = (Color){ channels[0], channels[1], channels[2], channels[3] };
+        }
+    }
+}
+
+// Calculates nodes values of a chunk of items
+static void RunBatchChunk(const FBatch *batch, float *lanes, int first, int count, const float *texcoords, bool *discarded)
+{
+    const Mesh *mesh = &batch->mesh;
+
+    // Every register value is stored as an array with a lane per chunk vertex
+    #define LANES(offset)   (lanes + (offset)*BATCH_CHUNK_LENGTH)
+
+    for (int p = 0; p < batch->blocksCount; p++)
+    {
+        const FProgramBlock *block = &batch->blocks[p];
+        FNode node = batch->nodes[block->node];
+        int base = batch->slots[block->node]*MAX_VALUES;
+
+        if ((node->type == FNODE_VERTEXPOSITION) || (node->type == FNODE_VERTEXNORMAL))
+        {
+            const float *attribute = ((node->type == FNODE_VERTEXPOSITION) ? mesh->vertices : mesh->normals);
+
+            for (int j = 0; j < block->width; j++)
+            {
+                float *d = LANES(base + j);
+
+                if ((attribute != NULL) && (j < 3)) for (int l = 0; l < count; l++) d[l] = attribute[(first + l)*3 + j];
+                else for (int l = 0; l < count; l++) d[l] = 0.0f;
+            }
+        }
+        else if (node->type == FNODE_SAMPLER2D)
+        {
+            if (block->inputsCount == 2)
+            {
+                int unit = (int)batch->nodes[block->inputs[0]]->output.data[0];
+                int selector = (int)batch->nodes[block->inputs[1]]->output.data[0];
+
+                for (int l = 0; l < count; l++)
+                {
+                    float color[4] = { 0 };
+                    SampleImage(batch, unit, texcoords[l], texcoords[BATCH_CHUNK_LENGTH + l], color);
+
+                    for (int j = 0; j < block->width; j++) LANES(base + j)[l] = color[((selector >= 2) ? (selector - 2) : j)];
+
+                    // Generated fragment shader discards texels whose sampled alpha is zero
+                    if ((discarded != NULL) && ((selector == 0) || (selector == 5)) && (color[3] == 0.0f)) discarded[l] = true;
+                }
+            }
+        }
+        else if (node->type == FNODE_VERTEXCOLOR)
+        {
+            // Selector value chooses all color channels, rgb channels or a single channel
+            int selector = ((block->inputsCount > 0) ? (int)batch->nodes[block->inputs[0]]->output.data[0] : 0);
+
+            for (int j = 0; j < block->width; j++)
+            {
+                int channel = ((selector >= 2) ? (selector - 2) : j);
+                float *d = LANES(base + j);
+
+                if (mesh->colors != NULL) for (int l = 0; l < count; l++) d[l] = mesh->colors[(first + l)*4 + channel]/255.0f;
+                else for (int l = 0; l < count; l++) d[l] = 1.0f;
+            }
+        }
+        else
+        {
+            for (int pc = block->first; pc < (block->first + block->count); pc++)
+            {
+                const FInstruction *ins = &batch->program[pc];
+                int w = ins->width;
+
+                switch (ins->opcode)
+                {
+                    case FOP_COPY: for (int j = 0; j < w; j++) memcpy(LANES(ins->dst + j), LANES(ins->a + j), count*sizeof(float)); break;
+                    case FOP_ADD: for (int j = 0; j < w; j++) kernels.add(LANES(ins->dst + j), LANES(ins->a + j), count); break;
+                    case FOP_SUBTRACT: for (int j = 0; j < w; j++) kernels.subtract(LANES(ins->dst + j), LANES(ins->a + j), count); break;
+                    case FOP_MULTIPLY: for (int j = 0; j < w; j++) kernels.multiply(LANES(ins->dst + j), LANES(ins->a + j), count); break;
+                    case FOP_DIVIDE: for (int j = 0; j < w; j++) kernels.divide(LANES(ins->dst + j), LANES(ins->a + j), count); break;
+                    case FOP_SCALE: for (int j = 0; j < w; j++) kernels.multiply(LANES(ins->dst + j), LANES(ins->a), count); break;
+                    case FOP_SCALEVALUE: for (int j = 0; j < w; j++) kernels.scale(LANES(ins->dst + j), ins->value, count); break;
+                    case FOP_DIVIDEBY: for (int j = 0; j < w; j++) kernels.divide(LANES(ins->dst + j), LANES(ins->a), count); break;
+                    case FOP_MIN: for (int j = 0; j < w; j++) kernels.min(LANES(ins->dst + j), LANES(ins->a + j), count); break;
+                    case FOP_MAX: for (int j = 0; j < w; j++) kernels.max(LANES(ins->dst + j), LANES(ins->a + j), count); break;
+                    case FOP_CLAMP01: for (int j = 0; j < w; j++) kernels.clamp(LANES(ins->dst + j), 0.0f, 1.0f, count); break;
+                    case FOP_SELECT: for (int j = w; j < MAX_VALUES; j++) memset(LANES(ins->dst + j), 0, count*sizeof(float)); break;
+                    default:
+                    {
+                        // Remaining operations combine values of a vertex, so they are calculated vertex by vertex
+                        bool matrix = ((ins->opcode == FOP_MATRIXVECTOR) || (ins->opcode == FOP_VECTORMATRIX) || (ins->opcode == FOP_MATRIXMULTIPLY) || (ins->opcode == FOP_TRANSPOSE));
+                        int span = (((w > 4) || matrix) ? MAX_VALUES : 4);
+
+                        for (int l = 0; l < count; l++)
+                        {
+                            float d[MAX_VALUES], a[MAX_VALUES], b[MAX_VALUES], c[MAX_VALUES];
+
+                            for (int j = 0; j < span; j++)
+                            {
+                                d[j] = LANES(ins->dst + j)[l];
+                                a[j] = LANES(ins->a + j)[l];
+                                b[j] = LANES(ins->b + j)[l];
+                                c[j] = LANES(ins->c + j)[l];
+                            }
+
+                            ExecuteInstruction(ins, d, a, b, c);
+
+                            for (int j = 0; j < span; j++) LANES(ins->dst + j)[l] = d[j];
+                        }
+                    } break;
+                }
+            }
+        }
+
+        // Keep register values beyond output width cleared
+        for (int j = block->width; j < block->written; j++) memset(LANES(base + j), 0, count*sizeof(float));
+    }
+
+    #undef LANES
+}
+
+// Returns output node values of a chunk item converted to a vec4
+static void GetBatchOutput(const FBatch *batch, const float *lanes, int lane, float *values)
+{
+    // Output values are converted the same way generated shaders build their output vectors
+    const float *output = lanes + batch->outputSlot*MAX_VALUES*BATCH_CHUNK_LENGTH + lane;
+    float x = output[0];
+    float y = output[BATCH_CHUNK_LENGTH];
+    float z = output[2*BATCH_CHUNK_LENGTH];
+    float w = output[3*BATCH_CHUNK_LENGTH];
+
+    switch (batch->outputWidth)
+    {
+        case 1: values[0] = x; values[1] = x; values[2] = x; values[3] = 1.0f; break;
+        case 2: values[0] = x; values[1] = y; values[2] = 0.0f; values[3] = 1.0f; break;
+        case 3: values[0] = x; values[1] = y; values[2] = z; values[3] = 1.0f; break;
+        default: values[0] = x; values[1] = y; values[2] = z; values[3] = w; break;
+    }
+}
+
+// Returns a bilinear filtered color of a sampler image with repeat wrapping
+static void SampleImage(const FBatch *batch, int unit, float u, float v, float *color)
+{
+    // Texture units without image return opaque black like unbound textures
+    if ((unit < 0) || (unit >= batch->pixelsCount) || (batch->pixels[unit] == NULL))
+    {
+        color[0] = 0.0f; color[1] = 0.0f; color[2] = 0.0f; color[3] = 1.0f;
+        return;
+    }
+
+    const Color *pixels = batch->pixels[unit];
+    int width = batch->pixelsWidths[unit];
+    int height = batch->pixelsHeights[unit];
+    float x = u*width - 0.5f;
+    float y = v*height - 0.5f;
+    int x0 = (int)floorf(x);
+    int y0 = (int)floorf(y);
+    float fx = FRound((x - x0)*256.0f)/256.0f;      // Weights use 8 bits of subtexel precision like texture units do
+    float fy = FRound((y - y0)*256.0f)/256.0f;
+    int x1 = (((x0 + 1)%width) + width)%width;
+    int y1 = (((y0 + 1)%height) + height)%height;
+    x0 = ((x0%width) + width)%width;
+    y0 = ((y0%height) + height)%height;
+
+    const unsigned char *c00 = (const unsigned char *)&pixels[y0*width + x0];
+    const unsigned char *c10 = (const unsigned char *)&pixels[y0*width + x1];
+    const unsigned char *c01 = (const unsigned char *)&pixels[y1*width + x0];
+    const unsigned char *c11 = (const unsigned char *)&pixels[y1*width + x1];
+
+    for (int k = 0; k < 4; k++)
+    {
+        float top = c00[k] + (c10[k] - c00[k])*fx;
+        float bottom = c01[k] + (c11[k] - c01[k])*fx;
+        color[k] = (top + (bottom - top)*fy)/255.0f;
+    }
+}
+
+// Copies sampler images converted to 8 bits per channel so workers can read their pixels
+static void LoadBatchImages(FBatch *batch, Image *images, int imagesCount)
+{
+    if (imagesCount <= 0) return;
+
+    batch->copies = (Image *)FNODE_MALLOC(imagesCount*sizeof(Image));
+    batch->pixels = (Color **)FNODE_MALLOC(imagesCount*sizeof(Color *));
+    batch->pixelsWidths = (int *)FNODE_MALLOC(imagesCount*sizeof(int));
+    batch->pixelsHeights = (int *)FNODE_MALLOC(imagesCount*sizeof(int));
+    batch->pixelsCount = imagesCount;
+
+    for (int i = 0; i < imagesCount; i++)
+    {
+        batch->copies[i] = (Image){ 0 };
+        batch->pixels[i] = NULL;
+
+        if ((images != NULL) && (images[i].data != NULL) && (images[i].width > 0) && (images[i].height > 0))
+        {
+            batch->copies[i] = ImageCopy(images[i]);
+            ImageFormat(&batch->copies[i], UNCOMPRESSED_R8G8B8A8);
+
+            batch->pixels[i] = (Color *)batch->copies[i].data;
+            batch->pixelsWidths[i] = batch->copies[i].width;
+            batch->pixelsHeights[i] = batch->copies[i].height;
+        }
+    }
+}
+
+// Releases sampler images copies of a batch
+static void UnloadBatchImages(FBatch *batch)
+{
+    for (int i = 0; i < batch->pixelsCount; i++)
+    {
+        if (batch->copies[i].data != NULL) UnloadImage(batch->copies[i]);
+    }
+
+    FNODE_FREE(batch->copies);
+    FNODE_FREE(batch->pixels);
+    FNODE_FREE(batch->pixelsWidths);
+    FNODE_FREE(batch->pixelsHeights);
+}
+
+// Selects the fastest operator kernels supported by current CPU
+static void SelectKernels()
+{
+    // Kernels are shared by all contexts, so they are selected only once by the first initialized context
+    kernels = scalarKernels;
+
+#if defined(FNODE_SIMD_X86)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx")) kernels = avxKernels;
+    else if (__builtin_cpu_supports("sse")) kernels = sseKernels;
+#endif
+
+    TraceLogFNode(false, "using %s operator kernels", kernels.name);
+}
+
+// Adds source values to destination values
+static void AddScalar(float *dst, const float *src, int count)
+{
+    for (int i = 0; i < count; i++) dst[i] += src[i];
+}
+
+// Subtracts source values from destination values
+static void SubtractScalar(float *dst, const float *src, int count)
+{
+    for (int i = 0; i < count; i++) dst[i] -= src[i];
+}
+
+// Multiplies destination values by source values
+static void MultiplyScalar(float *dst, const float *src, int count)
+{
+    for (int i = 0; i < count; i++) dst[i] *= src[i];
+}
+
+// Divides destination values by source values
+static void DivideScalar(float *dst, const float *src, int count)
+{
+    for (int i = 0; i < count; i++) dst[i] /= src[i];
+}
+
+// Multiplies destination values by a value
+static void ScaleScalar(float *dst, float value, int count)
+{
+    for (int i = 0; i < count; i++) dst[i] *= value;
+}
+
+// Divides destination values by a value
+static void DivideByScalar(float *dst, float value, int count)
+{
+    for (int i = 0; i < count; i++) dst[i] /= value;
+}
+
+// Keeps the minimum between destination and source values
+static void MinScalar(float *dst, const float *src, int count)
+{
+    for (int i = 0; i < count; i++) dst[i] = ((src[i] < dst[i]) ? src[i] : dst[i]);
+}
+
+// Keeps the maximum between destination and source values
+static void MaxScalar(float *dst, const float *src, int count)
+{
+    for (int i = 0; i < count; i++) dst[i] = ((src[i] > dst[i]) ? src[i] : dst[i]);
+}
+
+// Clamps destination values by a min and max values
+static void ClampScalar(float *dst, float min, float max, int count)
+{
+    for (int i = 0; i < count; i++) dst[i] = FClamp(dst[i], min, max);
+}
+
+// Multiplies two matrices (destination can be one of them)
+static void MatrixMultiplyScalar(float *dst, const float *left, const float *right)
+{
+    Matrix matrixA, matrixB;
+    memcpy(&matrixA, left, sizeof(Matrix));
+    memcpy(&matrixB, right, sizeof(Matrix));
+
+    Matrix result = FMatrixMultiply(matrixA, matrixB);
+    memcpy(dst, &result, sizeof(Matrix));
+}
+
+// Transforms a vector by a matrix
+static void MatrixVectorScalar(float *vector, const float *matrix)
+{
+    Vector4 result = { vector[0], vector[1], vector[2], vector[3] };
+    Matrix mat;
+    memcpy(&mat, matrix, sizeof(Matrix));
+
+    FMultiplyMatrixVector(&result, mat);
+
+    vector[0] = result.x;
+    vector[1] = result.y;
+    vector[2] = result.z;
+    vector[3] = result.w;
+}
+
+#if defined(FNODE_SIMD_X86)
+// Adds source values to destination values (SSE)
+__attribute__((target("sse"))) static void AddSSE(float *dst, const float *src, int count)
+{
+    int i = 0;
+    for (; (i + 4) <= count; i += 4) _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+    for (; i < count; i++) dst[i] += src[i];
+}
+
+// Subtracts source values from destination values (SSE)
+__attribute__((target("sse"))) static void SubtractSSE(float *dst, const float *src, int count)
+{
+    int i = 0;
+    for (; (i + 4) <= count; i += 4) _mm_storeu_ps(dst + i, _mm_sub_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+    for (; i < count; i++) dst[i] -= src[i];
+}
+
+// Multiplies destination values by source values (SSE)
+__attribute__((target("sse"))) static void MultiplySSE(float *dst, const float *src, int count)
+{
+    int i = 0;
+    for (; (i + 4) <= count; i += 4) _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+    for (; i < count; i++) dst[i] *= src[i];
+}
+
+// Divides destination values by source values (SSE)
+__attribute__((target("sse"))) static void DivideSSE(float *dst, const float *src, int count)
+{
+    int i = 0;
+    for (; (i + 4) <= count; i += 4) _mm_storeu_ps(dst + i, _mm_div_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+    for (; i < count; i++) dst[i] /= src[i];
+}
+
+// Multiplies destination values by a value (SSE)
+__attribute__((target("sse"))) static void ScaleSSE(float *dst, float value, int count)
+{
+    __m128 scale = _mm_set1_ps(value);
+    int i = 0;
+    for (; (i + 4) <= count; i += 4) _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), scale));
+    for (; i < count; i++) dst[i] *= value;
+}
+
+// Divides destination values by a value (SSE)
+__attribute__((target("sse"))) static void DivideBySSE(float *dst, float value, int count)
+{
+    __m128 divisor = _mm_set1_ps(value);
+    int i = 0;
+    for (; (i + 4) <= count; i += 4) _mm_storeu_ps(dst + i, _mm_div_ps(_mm_loadu_ps(dst + i), divisor));
+    for (; i < count; i++) dst[i] /= value;
+}
+
+// Keeps the minimum between destination and source values (SSE)
+__attribute__((target("sse"))) static void MinSSE(float *dst, const float *src, int count)
+{
+    int i = 0;
+    for (; (i + 4) <= count; i += 4) _mm_storeu_ps(dst + i, _mm_min_ps(_mm_loadu_ps(src + i), _mm_loadu_ps(dst + i)));
+    for (; i < count; i++) dst[i] = ((src[i] < dst[i]) ? src[i] : dst[i]);
+}
+
+// Keeps the maximum between destination and source values (SSE)
+__attribute__((target("sse"))) static void MaxSSE(float *dst, const float *src, int count)
+{
+    int i = 0;
+    for (; (i + 4) <= count; i += 4) _mm_storeu_ps(dst + i, _mm_max_ps(_mm_loadu_ps(src + i), _mm_loadu_ps(dst + i)));
+    for (; i < count; i++) dst[i] = ((src[i] > dst[i]) ? src[i] : dst[i]);
+}
+
+// Clamps destination values by a min and max values (SSE)
+__attribute__((target("sse"))) static void ClampSSE(float *dst, float min, float max, int count)
+{
+    __m128 low = _mm_set1_ps(min);
+    __m128 high = _mm_set1_ps(max);
+    int i = 0;
+    for (; (i + 4) <= count; i += 4) _mm_storeu_ps(dst + i, _mm_min_ps(high, _mm_max_ps(low, _mm_loadu_ps(dst + i))));
+    for (; i < count; i++) dst[i] = FClamp(dst[i], min, max);
+}
+
+// Multiplies two matrices, one result row per iteration (SSE)
+__attribute__((target("sse"))) static void MatrixMultiplySSE(float *dst, const float *left, const float *right)
+{
+    __m128 rows[4] = { _mm_loadu_ps(right), _mm_loadu_ps(right + 4), _mm_loadu_ps(right + 8), _mm_loadu_ps(right + 12) };
+    __m128 result[4];
+
+    for (int i = 0; i < 4; i++)
+    {
+        result[i] = _mm_mul_ps(_mm_set1_ps(left[i*4]), rows[0]);
+        result[i] = _mm_add_ps(result[i], _mm_mul_ps(_mm_set1_ps(left[i*4 + 1]), rows[1]));
+        result[i] = _mm_add_ps(result[i], _mm_mul_ps(_mm_set1_ps(left[i*4 + 2]), rows[2]));
+        result[i] = _mm_add_ps(result[i], _mm_mul_ps(_mm_set1_ps(left[i*4 + 3]), rows[3]));
+    }
+
+    for (int i = 0; i < 4; i++) _mm_storeu_ps(dst + i*4, result[i]);
+}
+
+// Transforms a vector by a matrix using its transposed rows (SSE)
+__attribute__((target("sse"))) static void MatrixVectorSSE(float *vector, const float *matrix)
+{
+    __m128 column0 = _mm_loadu_ps(matrix);
+    __m128 column1 = _mm_loadu_ps(matrix + 4);
+    __m128 column2 = _mm_loadu_ps(matrix + 8);
+    __m128 column3 = _mm_loadu_ps(matrix + 12);
+    _MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+
+    __m128 result = _mm_mul_ps(column0, _mm_set1_ps(vector[0]));
+    result = _mm_add_ps(result, _mm_mul_ps(column1, _mm_set1_ps(vector[1])));
+    result = _mm_add_ps(result, _mm_mul_ps(column2, _mm_set1_ps(vector[2])));
+    result = _mm_add_ps(result, _mm_mul_ps(column3, _mm_set1_ps(vector[3])));
+
+    _mm_storeu_ps(vector, result);
+}
+
+// Adds source values to destination values (AVX)
+__attribute__((target("avx"))) static void AddAVX(float *dst, const float *src, int count)
+{
+    int i = 0;
+    for (; (i + 8) <= count; i += 8) _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+
+    // Upper halves of AVX registers are cleared before remaining values use SSE code (avoids AVX to SSE transition penalties)
+    _mm256_zeroupper();
+    AddSSE(dst + i, src + i, count - i);
+}
+
+// Subtracts source values from destination values (AVX)
+__attribute__((target("avx"))) static void SubtractAVX(float *dst, const float *src, int count)
+{
+    int i = 0;
+    for (; (i + 8) <= count; i += 8) _mm256_storeu_ps(dst + i, _mm256_sub_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+    _mm256_zeroupper();
+    SubtractSSE(dst + i, src + i, count - i);
+}
+
+// Multiplies destination values by source values (AVX)
+__attribute__((target("avx"))) static void MultiplyAVX(float *dst, const float *src, int count)
+{
+    int i = 0;
+    for (; (i + 8) <= count; i += 8) _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+    _mm256_zeroupper();
+    MultiplySSE(dst + i, src + i, count - i);
+}
+
+// Divides destination values by source values (AVX)
+__attribute__((target("avx"))) static void DivideAVX(float *dst, const float *src, int count)
+{
+    int i = 0;
+    for (; (i + 8) <= count; i += 8) _mm256_storeu_ps(dst + i, _mm256_div_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+    _mm256_zeroupper();
+    DivideSSE(dst + i, src + i, count - i);
+}
+
+// Multiplies destination values by a value (AVX)
+__attribute__((target("avx"))) static void ScaleAVX(float *dst, float value, int count)
+{
+    __m256 scale = _mm256_set1_ps(value);
+    int i = 0;
+    for (; (i + 8) <= count; i += 8) _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), scale));
+    _mm256_zeroupper();
+    ScaleSSE(dst + i, value, count - i);
+}
+
+// Divides destination values by a value (AVX)
+__attribute__((target("avx"))) static void DivideByAVX(float *dst, float value, int count)
+{
+    __m256 divisor = _mm256_set1_ps(value);
+    int i = 0;
+    for (; (i + 8) <= count; i += 8) _mm256_storeu_ps(dst + i, _mm256_div_ps(_mm256_loadu_ps(dst + i), divisor));
+    _mm256_zeroupper();
+    DivideBySSE(dst + i, value, count - i);
+}
+
+// Keeps the minimum between destination and source values (AVX)
+__attribute__((target("avx"))) static void MinAVX(float *dst, const float *src, int count)
+{
+    int i = 0;
+    for (; (i + 8) <= count; i += 8) _mm256_storeu_ps(dst + i, _mm256_min_ps(_mm256_loadu_ps(src + i), _mm256_loadu_ps(dst + i)));
+    _mm256_zeroupper();
+    MinSSE(dst + i, src + i, count - i);
+}
+
+// Keeps the maximum between destination and source values (AVX)
+__attribute__((target("avx"))) static void MaxAVX(float *dst, const float *src, int count)
+{
+    int i = 0;
+    for (; (i + 8) <= count; i += 8) _mm256_storeu_ps(dst + i, _mm256_max_ps(_mm256_loadu_ps(src + i), _mm256_loadu_ps(dst + i)));
+    _mm256_zeroupper();
+    MaxSSE(dst + i, src + i, count - i);
+}
+
+// Clamps destination values by a min and max values (AVX)
+__attribute__((target("avx"))) static void ClampAVX(float *dst, float min, float max, int count)
+{
+    __m256 low = _mm256_set1_ps(min);
+    __m256 high = _mm256_set1_ps(max);
+    int i = 0;
+    for (; (i + 8) <= count; i += 8) _mm256_storeu_ps(dst + i, _mm256_min_ps(high, _mm256_max_ps(low, _mm256_loadu_ps(dst + i))));
+    _mm256_zeroupper();
+    ClampSSE(dst + i, min, max, count - i);
+}
+
+// Multiplies two matrices, two result rows per iteration (AVX)
+__attribute__((target("avx"))) static void MatrixMultiplyAVX(float *dst, const float *left, const float *right)
+{
+    __m256 rows[4] = { _mm256_broadcast_ps((const __m128 *)right), _mm256_broadcast_ps((const __m128 *)(right + 4)),
+                       _mm256_broadcast_ps((const __m128 *)(right + 8)), _mm256_broadcast_ps((const __m128 *)(right + 12)) };
+    __m256 result[2];
+
+    for (int i = 0; i < 2; i++)
+    {
+        const float *a = left + i*8;        // First row of the result rows pair
+        const float *b = left + i*8 + 4;    // Second row of the result rows pair
+
+        result[i] = _mm256_mul_ps(_mm256_setr_ps(a[0], a[0], a[0], a[0], b[0], b[0], b[0], b[0]), rows[0]);
+        result[i] = _mm256_add_ps(result[i], _mm256_mul_ps(_mm256_setr_ps(a[1], a[1], a[1], a[1], b[1], b[1], b[1], b[1]), rows[1]));
+        result[i] = _mm256_add_ps(result[i], _mm256_mul_ps(_mm256_setr_ps(a[2], a[2], a[2], a[2], b[2], b[2], b[2], b[2]), rows[2]));
+        result[i] = _mm256_add_ps(result[i], _mm256_mul_ps(_mm256_setr_ps(a[3], a[3], a[3], a[3], b[3], b[3], b[3], b[3]), rows[3]));
+    }
+
+    _mm256_storeu_ps(dst, result[0]);
+    _mm256_storeu_ps(dst + 8, result[1]);
+}
+#endif
+
+// Maps each node id to its first structurally identical node id (common subexpressions)
+static void FindExpressions(FNodeContext context)
+{
+    int tableSize = 1;
+    while (tableSize < context->nodesCount*2) tableSize *= 2;
+
+    // Open addressing hash table of resolved node ids
+    int *table = (int *)FNODE_MALLOC(tableSize*sizeof(int));
+    for (int i = 0; i < tableSize; i++) table[i] = -1;
+
+    context->expressionIds = (int *)FNODE_REALLOC(context->expressionIds, context->nodesLimit*sizeof(int));
+    for (int i = 0; i < context->nodesLimit; i++) context->expressionIds[i] = -1;
+
+    for (int i = 0; i < context->nodesCount; i++) ResolveExpression(context, context->nodes[i], table, tableSize);
+
+    FNODE_FREE(table);
+}
+
+// Returns first structurally identical node id of a node, resolving its inputs first
+static int ResolveExpression(FNodeContext context, FNode node, int *table, int tableSize)
+{
+    if (context->expressionIds[node->id] != -1) return context->expressionIds[node->id];
+
+    // Node represents itself until an identical expression is found
+    context->expressionIds[node->id] = node->id;
+
+    // Property values are uniforms and output nodes are unique, so they are never shared
+    if (node->property || (node->type >= FNODE_VERTEX)) return node->id;
+
+    int inputs[MAX_INPUTS] = { 0 };
+    for (int i = 0; i < node->inputsCount; i++) inputs[i] = ResolveExpression(context, context->nodes[GetNodeIndex(context, node->inputs[i])], table, tableSize);
+
+    int slot = HashExpression(node, inputs) & (tableSize - 1);
+
+    while (table[slot] != -1)
+    {
+        FNode other = context->nodes[GetNodeIndex(context, table[slot])];
+
+        if (SameExpression(context, node, inputs, other))
+        {
+            context->expressionIds[node->id] = other->id;
+            return other->id;
+        }
+
+        slot = (slot + 1) & (tableSize - 1);
+    }
+
+    table[slot] = node->id;
+
+    return node->id;
+}
+
+// Returns hash of a node expression key (type, resolved inputs and constant values)
+static unsigned int HashExpression(FNode node, const int *inputs)
+{
+    unsigned int hash = 2166136261u;
+
+    hash = (hash ^ (unsigned int)node->type)*16777619u;
+    hash = (hash ^ (unsigned int)node->output.dataCount)*16777619u;
+    for (int i = 0; i < node->inputsCount; i++) hash = (hash ^ (unsigned int)inputs[i])*16777619u;
+
+    // Constant nodes without inputs are identified by their values
+    if ((node->inputsCount == 0) && ((node->type <= FNODE_E) || (node->type >= FNODE_MATRIX)))
+    {
+        for (int i = 0; i < node->output.dataCount; i++)
+        {
+            unsigned int bits = 0;
+            memcpy(&bits, &node->output.data[i], sizeof(unsigned int));
+            hash = (hash ^ bits)*16777619u;
+        }
+    }
+
+    return hash;
+}
+
+// Check if a node expression key is equal to an already resolved node expression
+static bool SameExpression(FNodeContext context, FNode node, const int *inputs, FNode other)
+{
+    if ((node->type != other->type) || (node->output.dataCount != other->output.dataCount) || (node->inputsCount != other->inputsCount)) return false;
+
+    for (int i = 0; i < node->inputsCount; i++)
+    {
+        if (inputs[i] != context->expressionIds[other->inputs[i]]) return false;
+    }
+
+    if ((node->inputsCount == 0) && ((node->type <= FNODE_E) || (node->type >= FNODE_MATRIX)))
+    {
+        if (memcmp(node->output.data, other->output.data, node->output.dataCount*sizeof(float)) != 0) return false;
+    }
+
+    return true;
+}
+
+// Finds nodes with values known at compile time (constant folding)
+static void FindConstants(FNodeContext context)
+{
+    // Folded literals use the values calculated by the CPU
+    CalculateValues(context);
+
+    context->foldStates = (signed char *)FNODE_REALLOC(context->foldStates, context->nodesLimit*sizeof(signed char));
+    memset(context->foldStates, -1, context->nodesLimit*sizeof(signed char));
+
+    for (int i = 0; i < context->nodesCount; i++) FoldNode(context, context->nodes[GetNodeIndex(context, context->expressionIds[context->nodes[i]->id])]);
+}
+
+// Check if a node values are known at compile time, folding operations over constant inputs
+static bool FoldNode(FNodeContext context, FNode node)
+{
+    if (context->foldStates[node->id] != -1) return (context->foldStates[node->id] == 1);
+
+    context->foldStates[node->id] = 0;
+
+    bool constant = false;
+
+    if (node->inputsCount == 0) constant = (!node->property && ((node->type <= FNODE_E) || ((node->type >= FNODE_VALUE) && (node->type <= FNODE_VECTOR4))));
+    else if (FoldableOperation(context, node))
+    {
+        constant = true;
+
+        for (int i = 0; i < node->inputsCount; i++)
+        {
+            if (!FoldNode(context, context->nodes[GetNodeIndex(context, context->expressionIds[node->inputs[i]])])) constant = false;
+        }
+
+        for (int i = 0; i < node->output.dataCount; i++)
+        {
+            if (!isfinite(node->output.data[i])) constant = false;
+        }
+    }
+
+    context->foldStates[node->id] = (constant ? 1 : 0);
+
+    return constant;
+}
+
+// Check if a node operation has the same CPU and GLSL results so its values can be folded
+static bool FoldableOperation(FNodeContext context, FNode node)
+{
+    int width = node->output.dataCount;
+    int widths[MAX_INPUTS] = { 0 };
+    int n = node->inputsCount;
+
+    if ((width < 1) || (width > 4)) return false;
+
+    bool sameWidths = true;         // Every input has output values count
+    bool scalarInputs = true;       // Every input after first one has a single value
+    int appendWidth = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        widths[i] = context->nodes[GetNodeIndex(context, context->expressionIds[node->inputs[i]])]->output.dataCount;
+        if (widths[i] != width) sameWidths = false;
+        if ((i > 0) && (widths[i] != 1)) scalarInputs = false;
+        appendWidth += widths[i];
+    }
+
+    switch (node->type)
+    {
+        case FNODE_ADD:
+        case FNODE_SUBTRACT:
+        case FNODE_MAX:
+        case FNODE_MIN: return sameWidths;
+        case FNODE_MULTIPLY:
+        case FNODE_DIVIDE: return (sameWidths || ((widths[0] == width) && scalarInputs));
+        case FNODE_APPEND: return (appendWidth == width);
+        case FNODE_ONEMINUS:
+        case FNODE_ABS:
+        case FNODE_COS:
+        case FNODE_SIN:
+        case FNODE_TAN:
+        case FNODE_DEG2RAD:
+        case FNODE_RAD2DEG:
+        case FNODE_NEGATE:
+        case FNODE_RECIPROCAL:
+        case FNODE_SQRT:
+        case FNODE_TRUNC:
+        case FNODE_CEIL:
+        case FNODE_CLAMP01:
+        case FNODE_EXP2: return ((n == 1) && sameWidths);
+        case FNODE_NORMALIZE: return ((n == 1) && sameWidths && (width >= 2));
+        case FNODE_POSTERIZE: return ((n == 2) && (widths[0] == width) && scalarInputs);
+        case FNODE_STEP: return ((n == 2) && sameWidths && (width == 1));
+        case FNODE_POWER:
+        {
+            // GLSL power is undefined for negative or zero bases
+            if ((n != 2) || !sameWidths || (width != 1)) return false;
+            return (context->nodes[GetNodeIndex(context, context->expressionIds[node->inputs[0]])]->output.data[0] > 0.0f);
+        }
+        case FNODE_LERP: return ((n == 3) && (widths[0] == width) && (widths[1] == width) && (widths[2] == 1));
+        case FNODE_DISTANCE:
+        case FNODE_DOTPRODUCT: return ((n == 2) && (width == 1) && (widths[0] >= 2) && (widths[0] <= 4) && (widths[1] == widths[0]));
+        case FNODE_LENGTH: return ((n == 1) && (width == 1) && (widths[0] >= 2) && (widths[0] <= 4));
+        case FNODE_CROSSPRODUCT: return ((n == 2) && (width == 3) && sameWidths);
+        default: return false;
+    }
+}
+
+// Writes a GLSL float or vector literal with exact float values
+static void FormatLiteral(char *text, const float *values, int count)
+{
+    text[0] = '\0';
+
+    if (count > 1) sprintf(text, "vec%i(", count);
+
+    for (int i = 0; i < count; i++)
+    {
+        char literal[32] = { '\0' };
+        sprintf(literal, "%.9g", values[i]);
+
+        // GLSL 100 has no implicit integer to float conversion
+        if (strpbrk(literal, ".e") == NULL) strcat(literal, ".0");
+        if ((i + 1) < count) strcat(literal, ", ");
+
+        strcat(text, literal);
+    }
+
+    if (count > 1) strcat(text, ")");
+}
+
+// Removes identity operands of an expression (adding zero, multiplying or dividing by one)
+static void SimplifyExpression(FNodeContext context, FNodeData *expression)
+{
+    if ((expression->type < FNODE_ADD) || (expression->type > FNODE_DIVIDE)) return;
+
+    int width = expression->output.dataCount;
+    float identity = (((expression->type == FNODE_ADD) || (expression->type == FNODE_SUBTRACT)) ? 0.0f : 1.0f);
+    bool ordered = ((expression->type == FNODE_SUBTRACT) || (expression->type == FNODE_DIVIDE));
+
+    // Inputs with different values count are promoted by generated code, so their operands are kept
+    for (int i = 0; i < expression->inputsCount; i++)
+    {
+        int count = context->nodes[GetNodeIndex(context, expression->inputs[i])]->output.dataCount;
+        if ((count != 1) && (count != width)) return;
+    }
+
+    int inputs[MAX_INPUTS] = { 0 };
+    int inputsCount = 0;
+    bool typed = false;
+
+    for (int i = 0; i < expression->inputsCount; i++)
+    {
+        // Left operand of subtractions and divisions is never an identity
+        if (((i > 0) || !ordered) && IsConstantValue(context, expression->inputs[i], identity)) continue;
+
+        inputs[inputsCount] = expression->inputs[i];
+        if (context->nodes[GetNodeIndex(context, inputs[inputsCount])]->output.dataCount == width) typed = true;
+        inputsCount++;
+    }
+
+    // Remaining operands must keep expression output type
+    if ((inputsCount > 0) && typed)
+    {
+        for (int i = 0; i < inputsCount; i++) expression->inputs[i] = inputs[i];
+        expression->inputsCount = inputsCount;
+    }
+}
+
+// Check if a node is a compile-time constant with all its values equal to a value
+static bool IsConstantValue(FNodeContext context, int id, float value)
+{
+    FNode node = context->nodes[GetNodeIndex(context, id)];
+
+    if (context->foldStates[id] != 1) return false;
+
+    for (int i = 0; i < node->output.dataCount; i++)
+    {
+        if (node->output.data[i] != value) return false;
+    }
+
+    return true;
+}
+
+// Gets reciprocal values of a compile-time constant node if all of them are finite
+static bool GetReciprocal(FNodeContext context, int id, float *values)
+{
+    FNode node = context->nodes[GetNodeIndex(context, id)];
+
+    if ((context->foldStates[id] != 1) || (node->output.dataCount < 1) || (node->output.dataCount > 4)) return false;
+
+    for (int i = 0; i < node->output.dataCount; i++)
+    {
+        if (node->output.data[i] == 0.0f) return false;
+
+        values[i] = 1.0f/node->output.data[i];
+        if (!isfinite(values[i])) return false;
+    }
+
+    return true;
+}
+
+// Check if a power exponent node is a constant reduced to multiplications, square root or reciprocal
+static bool ReducedExponent(FNodeContext context, int id)
+{
+    return (IsConstantValue(context, id, 1.0f) || IsConstantValue(context, id, 2.0f) || IsConstantValue(context, id, 3.0f) || IsConstantValue(context, id, 4.0f) || IsConstantValue(context, id, 0.5f) || IsConstantValue(context, id, -1.0f));
+}
+
+// Gets a node expression with structurally identical and simplified inputs
+static void GetExpression(FNodeContext context, FNode node, FNodeData *expression)
+{
+    *expression = *node;
+    for (int i = 0; i < node->inputsCount; i++) expression->inputs[i] = context->expressionIds[node->inputs[i]];
+    SimplifyExpression(context, expression);
+}
+
+// Gets input node ids whose variables are referenced by an expression generated code
+static int GetReferencedInputs(FNodeContext context, const FNodeData *expression, int *inputs)
+{
+    int count = 0;
+    float reciprocal[MAX_VALUES] = { 0 };
+
+    switch (expression->type)
+    {
+        // Texture unit, channel and color selectors are read at compile time
+        case FNODE_SAMPLER2D:
+        case FNODE_VERTEXCOLOR: break;
+        case FNODE_POWER:
+        {
+            for (int i = 0; i < expression->inputsCount; i++)
+            {
+                if ((i == 1) && ReducedExponent(context, expression->inputs[i])) continue;
+                inputs[count++] = expression->inputs[i];
+            }
+        } break;
+        case FNODE_DIVIDE:
+        {
+            for (int i = 0; i < expression->inputsCount; i++)
+            {
+                if ((i > 0) && GetReciprocal(context, expression->inputs[i], reciprocal)) continue;
+                inputs[count++] = expression->inputs[i];
+            }
+        } break;
+        default:
+        {
+            for (int i = 0; i < expression->inputsCount; i++) inputs[count++] = expression->inputs[i];
+        } break;
+    }
+
+    return count;
+}
+
+// Marks nodes referenced by a stage generated code, storing them in declaration order
+static int MarkLiveNodes(FNodeContext context, FNode node, unsigned int *live, int *liveIds, int liveCount, bool fragment)
+{
+    if (BITSET_TEST(live, node->id)) return liveCount;
+
+    BITSET_SET(live, node->id);
+    liveIds[liveCount++] = node->id;
+
+    // Folded operations are declared as literals and hoisted values are interpolated, so their inputs are not referenced
+    if (context->foldStates[node->id] == 1) return liveCount;
+    if (fragment && IsNodeHoisted(context, node->id)) return liveCount;
+
+    FNodeData expression;
+    GetExpression(context, node, &expression);
+
+    int inputs[MAX_INPUTS] = { 0 };
+    int inputsCount = GetReferencedInputs(context, &expression, inputs);
+
+    for (int i = 0; i < inputsCount; i++) liveCount = MarkLiveNodes(context, context->nodes[GetNodeIndex(context, inputs[i])], live, liveIds, liveCount, fragment);
+
+    return liveCount;
+}
+
+// Check if any live node of a stage has a specific type
+static bool IsNodeLive(FNodeContext context, const int *liveIds, int liveCount, FNodeType type)
+{
+    for (int i = 0; i < liveCount; i++)
+    {
+        if (context->nodes[GetNodeIndex(context, liveIds[i])]->type == type) return true;
+    }
+
+    return false;
+}
+
+// Gets how a node value varies over a primitive (uniform, linear in interpolated attributes or non linear)
+static FInterpolation GetInterpolation(FNodeContext context, FNode node)
+{
+    if (context->interpolations[node->id] != -1) return (FInterpolation)context->interpolations[node->id];
+
+    context->interpolations[node->id] = INTERPOLATION_NONE;
+
+    FNodeData expression;
+    GetExpression(context, node, &expression);
+
+    int inputs[MAX_INPUTS] = { 0 };
+    int inputsCount = GetReferencedInputs(context, &expression, inputs);
+    FInterpolation classes[MAX_INPUTS] = { INTERPOLATION_UNIFORM };
+    int linearCount = 0;
+    bool nonLinear = false;
+
+    for (int i = 0; i < inputsCount; i++)
+    {
+        classes[i] = GetInterpolation(context, context->nodes[GetNodeIndex(context, inputs[i])]);
+        if (classes[i] == INTERPOLATION_LINEAR) linearCount++;
+        else if (classes[i] == INTERPOLATION_NONE) nonLinear = true;
+    }
+
+    FInterpolation output = INTERPOLATION_NONE;
+
+    if (context->foldStates[node->id] == 1) output = INTERPOLATION_UNIFORM;
+    else
+    {
+        switch (node->type)
+        {
+            // Attributes interpolated from vertex stage and fresnel dot product with an uniform direction
+            case FNODE_VERTEXPOSITION:
+            case FNODE_VERTEXNORMAL:
+            case FNODE_VERTEXCOLOR:
+            case FNODE_FRESNEL: output = INTERPOLATION_LINEAR; break;
+            case FNODE_SAMPLER2D: output = INTERPOLATION_NONE; break;
+            case FNODE_PI:
+            case FNODE_E:
+            case FNODE_TIME:
+            case FNODE_VIEWDIRECTION:
+            case FNODE_MVP:
+            case FNODE_MATRIX:
+            case FNODE_VALUE:
+            case FNODE_VECTOR2:
+            case FNODE_VECTOR3:
+            case FNODE_VECTOR4: output = INTERPOLATION_UNIFORM; break;
+            default:
+            {
+                if (nonLinear) output = INTERPOLATION_NONE;
+                else if (linearCount == 0) output = INTERPOLATION_UNIFORM;
+                else
+                {
+                    // Affine operations of linear values keep them linear
+                    switch (node->type)
+                    {
+                        case FNODE_ADD:
+                        case FNODE_SUBTRACT:
+                        case FNODE_APPEND:
+                        case FNODE_ONEMINUS:
+                        case FNODE_NEGATE:
+                        case FNODE_DEG2RAD:
+                        case FNODE_RAD2DEG:
+                        case FNODE_TRANSPOSE: output = INTERPOLATION_LINEAR; break;
+                        case FNODE_MULTIPLY:
+                        case FNODE_MULTIPLYMATRIX:
+                        case FNODE_DOTPRODUCT:
+                        case FNODE_CROSSPRODUCT: output = ((linearCount == 1) ? INTERPOLATION_LINEAR : INTERPOLATION_NONE); break;
+                        case FNODE_DIVIDE: output = (((linearCount == 1) && (classes[0] == INTERPOLATION_LINEAR)) ? INTERPOLATION_LINEAR : INTERPOLATION_NONE); break;
+                        case FNODE_LERP: output = (((inputsCount == 3) && ((classes[2] == INTERPOLATION_UNIFORM) || (linearCount == 1))) ? INTERPOLATION_LINEAR : INTERPOLATION_NONE); break;
+                        default: output = INTERPOLATION_NONE; break;
+                    }
+                }
+            } break;
+        }
+    }
+
+    context->interpolations[node->id] = output;
+
+    return output;
+}
+
+// Finds largest linearly interpolable fragment values to compute in vertex stage
+static void FindHoistedNodes(FNodeContext context, FNode node, unsigned int *visited)
+{
+    if (BITSET_TEST(visited, node->id)) return;
+
+    BITSET_SET(visited, node->id);
+
+    if (context->foldStates[node->id] == 1) return;
+
+    // Only operations are hoisted, attributes and uniforms are already available in fragment stage
+    bool operation = ((node->inputsCount > 0) && (node->type != FNODE_SAMPLER2D) && (node->type != FNODE_VERTEXCOLOR));
+    bool width = ((node->output.dataCount >= 1) && (node->output.dataCount <= 4));
+
+    if (operation && width && (GetInterpolation(context, node) != INTERPOLATION_NONE))
+    {
+        if (context->hoistedCount < MAX_HOISTED_VARYINGS) context->hoistedNodes[context->hoistedCount++] = node->id;
+        return;
+    }
+
+    FNodeData expression;
+    GetExpression(context, node, &expression);
+
+    int inputs[MAX_INPUTS] = { 0 };
+    int inputsCount = GetReferencedInputs(context, &expression, inputs);
+
+    for (int i = 0; i < inputsCount; i++) FindHoistedNodes(context, context->nodes[GetNodeIndex(context, inputs[i])], visited);
+}
+
+// Check if a fragment node value is computed in vertex stage
+static bool IsNodeHoisted(FNodeContext context, int id)
+{
+    for (int i = 0; i < context->hoistedCount; i++)
+    {
+        if (context->hoistedNodes[i] == id) return true;
+    }
+
+    return false;
+}
+
+// Check a live node searching for constant values to define them in shaders
+static void CheckConstant(FNodeContext context, FNode node, FString *code)
+{
+    // Folded operations are declared as a single literal
+    if ((node->inputsCount > 0) && (context->foldStates[node->id] == 1))
+    {
+        const char *types[4] = { "float", "vec2", "vec3", "vec4" };
+        char literal[MAX_LITERAL_LENGTH] = { '\0' };
+
+        FormatLiteral(literal, node->output.data, node->output.dataCount);
+        AppendString(code, "const %s node_%02i = %s;\n", types[node->output.dataCount - 1], node->id, literal);
+
+        return;
+    }
+
+    switch (node->type)
+    {
+        case FNODE_PI: AppendString(code, "const float node_%02i = 3.14159265358979323846;\n", node->id); break;
+        case FNODE_E: AppendString(code, "const float node_%02i = 2.71828182845904523536;\n", node->id); break;
+        case FNODE_VALUE:
+        {
+            if (node->property)
+            {
+                const char fConstantVector4[] = "uniform float node_%02i;\n";
+                AppendString(code, fConstantVector4, node->id);
+            }
+            else
+            {
+                const char fConstantValue[] = "const float node_%02i = %.3f;\n";
+                AppendString(code, fConstantValue, node->id, node->output.data[0]);
+            }
+        } break;
+        case FNODE_VECTOR2:
+        {
+            const char fConstantVector2[] = "const vec2 node_%02i = vec2(%.3f, %.3f);\n";
+            AppendString(code, fConstantVector2, node->id, node->output.data[0], node->output.data[1]);
+        } break;
+        case FNODE_VECTOR3:
+        {
+            const char fConstantVector3[] = "const vec3 node_%02i = vec3(%.3f, %.3f, %.3f);\n";
+            AppendString(code, fConstantVector3, node->id, node->output.data[0], node->output.data[1], node->output.data[2]);
+        } break;
+        case FNODE_VECTOR4:
+        {
+            if (node->property)
+            {
+                const char fConstantVector4[] = "uniform vec4 node_%02i;\n";
+                AppendString(code, fConstantVector4, node->id);
+            }
+            else
+            {
+                const char fConstantVector4[] = "const vec4 node_%02i = vec4(%.3f, %.3f, %.3f, %.3f);\n";
+                AppendString(code, fConstantVector4, node->id, node->output.data[0], node->output.data[1], node->output.data[2], node->output.data[3]);
+            }
+        } break;
+        case FNODE_SAMPLER2D:
+        {
+            char fConstantSampler[32] = { '\0' };
+            int index = GetNodeIndex(context, node->inputs[0]);
+            sprintf(fConstantSampler, "uniform sampler2D texture%i;\n", (int)context->nodes[index]->output.data[0]);
+            if (!context->usedUnits[(int)context->nodes[index]->output.data[0]])
+            {
+                AppendString(code, fConstantSampler);
+                context->usedUnits[(int)context->nodes[index]->output.data[0]] = true;
+            }
+        } break;
+        default: break;
+    }
+}
+
+// Compiles a specific node checking its inputs and writing current node operation in shader
+static void CompileNode(FNodeContext context, FNode node, FString *code, unsigned int *declared, bool fragment)
+{
+    // Folded operations are already declared as constants
+    if (context->foldStates[node->id] == 1) return;
+
+    // Hoisted values are interpolated from vertex stage
+    if (fragment && IsNodeHoisted(context, node->id))
+    {
+        const char *types[4] = { "float", "vec2", "vec3", "vec4" };
+
+        if (!BITSET_TEST(declared, node->id))
+        {
+            BITSET_SET(declared, node->id);
+            AppendString(code, "    %s node_%02i = fragNode_%02i;\n", types[node->output.dataCount - 1], node->id, node->id);
+        }
+
+        return;
+    }
+
+    // Reference first structurally identical inputs so common subexpressions are emitted once
+    FNodeData expression;
+    GetExpression(context, node, &expression);
+    node = &expression;
+
+    // Declared nodes already compiled their inputs, so shared inputs are visited once instead of once per path
+    if (BITSET_TEST(declared, node->id)) return;
+
+    // Check if current node is an operator
+    if ((node->inputsCount > 0) || ((node->type < FNODE_MATRIX) && (node->type > FNODE_E)) || (node->type == FNODE_SAMPLER2D))
+    {
+        int inputs[MAX_INPUTS] = { 0 };
+        int inputsCount = GetReferencedInputs(context, node, inputs);
+
+        // Check for operator nodes in inputs to compile them first
+        for (int i = 0; i < inputsCount; i++)
+        {
+            int index = GetNodeIndex(context, inputs[i]);
+            if (context->nodes[index]->type > FNODE_VECTOR4 || ((context->nodes[index]->type < FNODE_MATRIX) && (context->nodes[index]->type > FNODE_E))) CompileNode(context, context->nodes[index], code, declared, fragment);
+        }
+
+        // Check if current node is previously defined and declared (unsupported output data count is never declared)
+        bool supported = (((node->output.dataCount >= 1) && (node->output.dataCount <= 4)) || (node->output.dataCount == 16));
+
+        if (supported && !BITSET_TEST(declared, node->id))
+        {
+            BITSET_SET(declared, node->id);
+
+            // Variable definition based on current node output data count
+            char body[4096] = { '\0' };
+            char definition[32] = { '\0' };
+
+            switch (node->output.dataCount)
+            {
+                case 1: sprintf(definition, "    float node_%02i = ", node->id); break;
+                case 2: sprintf(definition, "    vec2 node_%02i = ", node->id); break;
+                case 3: sprintf(definition, "    vec3 node_%02i = ", node->id); break;
+                case 4: sprintf(definition, "    vec4 node_%02i = ", node->id); break;
+                case 16: sprintf(definition, "    mat4 node_%02i = ", node->id); break;
+                default: break;
+            }
+
+            strcat(body, definition);
+
+            if (((node->type < FNODE_MATRIX) && (node->type > FNODE_E)) || (node->type == FNODE_SAMPLER2D))
+            {
+                switch (node->type)
+                {
+                    case FNODE_TIME:
+                    {
+                        if (fragment) strcat(body, "fragCurrentTime;\n");
+                        else strcat(body, "vertCurrentTime;\n");
+                    } break;
+                    case FNODE_VERTEXPOSITION:
+                    {
+                        if (fragment) strcat(body, "fragPosition;\n");
+                        else strcat(body, "vertexPosition;\n");
+                    } break;
+                    case FNODE_VERTEXNORMAL:
+                    {
+                        if (fragment) strcat(body, "fragNormal;\n");
+                        else strcat(body, "vertexNormal;\n");
+                    } break;
+                    case FNODE_FRESNEL: strcat(body, "1.0 - dot(fragNormal, viewDirection);\n"); break;
+                    case FNODE_VIEWDIRECTION: strcat(body, "viewDirection;\n"); break;
+                    case FNODE_MVP: strcat(body, "mvp;\n"); break;
+                    case FNODE_SAMPLER2D:
+                    {
+                        char test[MAX_CODE_LENGTH] = { '\0' };
+
+                        int indexA = GetNodeIndex(context, node->inputs[0]);
+                        int indexB = GetNodeIndex(context, node->inputs[1]);
+                        int unit = (int)context->nodes[indexA]->output.data[0];
+
+                        // Texture units are fetched once per stage and shared by every sampler node that reads them
+                        if (!context->fetchedUnits[unit])
+                        {
+                            switch (context->shaderVersion)
+                            {
+                                case GLSL_330: AppendString(code, "    vec4 texel%i = texture(texture%i, fragTexCoord);\n", unit, unit); break;
+                                case GLSL_100: AppendString(code, "    vec4 texel%i = texture2D(texture%i, fragTexCoord);\n", unit, unit); break;
+                                default: break;
+                            }
+
+                            context->fetchedUnits[unit] = true;
+                        }
+
+                        switch ((int)context->nodes[indexB]->output.data[0])
+                        {
+                            case 0: sprintf(test, "texel%i;\n    if (node_%02i.a == 0.0) discard;\n", unit, node->id); break;
+                            case 1: sprintf(test, "texel%i.rgb;\n", unit); break;
+                            case 2: sprintf(test, "texel%i.r;\n", unit); break;
+                            case 3: sprintf(test, "texel%i.g;\n", unit); break;
+                            case 4: sprintf(test, "texel%i.b;\n", unit); break;
+                            case 5: sprintf(test, "texel%i.a;\n    if (node_%02i == 0.0) discard;\n", unit, node->id); break;
+                            default: sprintf(test, "texel%i;\n", unit); break;
+                        }
+
+                        strcat(body, test);
+                        break;
+                    }
+                    default: break;
+                }
+            }
+            else if ((node->type >= FNODE_ADD && node->type <= FNODE_DIVIDE) || node->type == FNODE_MULTIPLYMATRIX)
+            {
+                // Operate with each input node
+                for (int i = 0; i < node->inputsCount; i++)
+                {
+                    char temp[MAX_CODE_LENGTH] = { '\0' };
+                    char operand[MAX_LITERAL_LENGTH] = { '\0' };
+                    float reciprocal[MAX_VALUES] = { 0 };
+
+                    // Constant divisors are emitted as a multiplication by their reciprocal
+                    if ((node->type == FNODE_DIVIDE) && (i > 0) && GetReciprocal(context, node->inputs[i], reciprocal)) FormatLiteral(operand, reciprocal, context->nodes[GetNodeIndex(context, node->inputs[i])]->output.dataCount);
+                    else sprintf(operand, "node_%02i", node->inputs[i]);
+
+                    if ((i+1) == node->inputsCount) sprintf(temp, "%s;\n", operand);
+                    else
+                    {
+                        int nextIndex = GetNodeIndex(context, node->inputs[i+1]);
+                        if ((context->nodes[nextIndex]->output.dataCount - 1) == node->output.dataCount)
+                        {
+                            switch (node->output.dataCount)
+                            {
+                                case 1: sprintf(temp, "vec2(node_%02i, 0.0);\n", node->inputs[i]);
+                                case 2: sprintf(temp, "vec3(node_%02i, 0.0);\n", node->inputs[i]);
+                                case 3: sprintf(temp, "vec4(node_%02i, 0.0);\n", node->inputs[i]);
+                                default: break;
+                            }
+                        }
+                        else strcpy(temp, operand);
+                        switch (node->type)
+                        {
+                            case FNODE_ADD: strcat(temp, " + "); break;
+                            case FNODE_SUBTRACT: strcat(temp, " - "); break;
+                            case FNODE_MULTIPLYMATRIX:
+                            case FNODE_MULTIPLY: strcat(temp, "*"); break;
+                            case FNODE_DIVIDE: strcat(temp, (GetReciprocal(context, node->inputs[i+1], reciprocal) ? "*" : "/")); break;
+                            default: break;
+                        }
+                    }
+
+                    strcat(body, temp);
+                }
+            }
+            else if (node->type >= FNODE_APPEND)
+            {
+                char temp[MAX_CODE_LENGTH] = { '\0' };
+                switch (node->type)
+                {
+                    case FNODE_APPEND:
+                    {
+                        switch (node->output.dataCount)
+                        {
+                            case 2: strcat(temp, "vec2("); break;
+                            case 3: strcat(temp, "vec3("); break;
+                            case 4: strcat(temp, "vec4("); break;
+                            default: break;
+                        }
+
+                        for (int i = 0; i < node->inputsCount; i++)
+                        {
+                            char append[32] = { '\0' };
+                            if ((i + 1) == node->inputsCount) sprintf(append, "node_%02i);\n", node->inputs[i]);
+                            else sprintf(append, "node_%02i, ", node->inputs[i]);
+                            
+                            strcat(temp, append);
+                        }
+                    } break;
+                    case FNODE_ONEMINUS: sprintf(temp, "(1.0 - node_%02i);\n", node->inputs[0]); break;
+                    case FNODE_ABS: sprintf(temp, "abs(node_%02i);\n", node->inputs[0]); break;
+                    case FNODE_COS: sprintf(temp, "cos(node_%02i);\n", node->inputs[0]); break;
+                    case FNODE_SIN: sprintf(temp, "sin(node_%02i);\n", node->inputs[0]); break;
+                    case FNODE_TAN: sprintf(temp, "tan(node_%02i);\n", node->inputs[0]); break;
+                    case FNODE_DEG2RAD: sprintf(temp, "node_%02i*0.0174532925;\n", node->inputs[0]); break;
+                    case FNODE_RAD2DEG: sprintf(temp, "node_%02i*57.2957795;\n", node->inputs[0]); break;
+                    case FNODE_NORMALIZE: sprintf(temp, "normalize(node_%02i);\n", node->inputs[0]); break;
+                    case FNODE_NEGATE: sprintf(temp, "-node_%02i;\n", node->inputs[0]); break;
+                    case FNODE_RECIPROCAL: sprintf(temp, "1.0/node_%02i;\n", node->inputs[0]); break;
+                    case FNODE_SQRT: sprintf(temp, "sqrt(node_%02i);\n", node->inputs[0]); break;
+                    case FNODE_TRUNC: sprintf(temp, "trunc(node_%02i);\n", node->inputs[0]); break;
+                    case FNODE_ROUND: sprintf(temp, "round(node_%02i);\n", node->inputs[0]); break;
+                    case FNODE_VERTEXCOLOR:
+                    {
+                        int index = GetNodeIndex(context, node->inputs[0]);
+                        switch ((int)context->nodes[index]->output.data[0])
+                        {
+                            case 0: sprintf(temp, (fragment ? "fragColor;\n" : "vertexColor;\n")); break;
+                            case 1: sprintf(temp, (fragment ? "fragColor.rgb;\n" : "vertexColor.rgb;\n")); break;
+                            case 2: sprintf(temp, (fragment ? "fragColor.r;\n" : "vertexColor.r;\n")); break;
+                            case 3: sprintf(temp, (fragment ? "fragColor.g;\n" : "vertexColor.g;\n")); break;
+                            case 4: sprintf(temp, (fragment ? "fragColor.b;\n" : "vertexColor.b;\n")); break;
+                            case 5: sprintf(temp, (fragment ? "fragColor.a;\n" : "vertexColor.a;\n")); break;
+                            default: break;
+                        }
+                    } break;
+                    case FNODE_CEIL: sprintf(temp, "ceil(node_%02i);\n", node->inputs[0]); break;
+                    case FNODE_CLAMP01: sprintf(temp, "clamp(node_%02i, 0.0, 1.0);\n", node->inputs[0]); break;
+                    case FNODE_EXP2: sprintf(temp, "exp2(node_%02i);\n", node->inputs[0]); break;
+                    case FNODE_POWER:
+                    {
+                        // Small constant exponents are reduced to multiplications, square root or reciprocal
+                        int a = node->inputs[0];
+
+                        if (IsConstantValue(context, node->inputs[1], 1.0f)) sprintf(temp, "node_%02i;\n", a);
+                        else if (IsConstantValue(context, node->inputs[1], 2.0f)) sprintf(temp, "node_%02i*node_%02i;\n", a, a);
+                        else if (IsConstantValue(context, node->inputs[1], 3.0f)) sprintf(temp, "node_%02i*node_%02i*node_%02i;\n", a, a, a);
+                        else if (IsConstantValue(context, node->inputs[1], 4.0f)) sprintf(temp, "(node_%02i*node_%02i)*(node_%02i*node_%02i);\n", a, a, a, a);
+                        else if (IsConstantValue(context, node->inputs[1], 0.5f)) sprintf(temp, "sqrt(node_%02i);\n", a);
+                        else if (IsConstantValue(context, node->inputs[1], -1.0f)) sprintf(temp, "1.0/node_%02i;\n", a);
+                        else sprintf(temp, "pow(node_%02i, node_%02i);\n", a, node->inputs[1]);
+                    } break;
+                    case FNODE_STEP: sprintf(temp, "((node_%02i <= node_%02i) ? 1.0 : 0.0);\n", node->inputs[0], node->inputs[1]); break;
+                    case FNODE_POSTERIZE:
+                    {
+                        // Constant samples divide by their reciprocal
+                        float reciprocal[MAX_VALUES] = { 0 };
+                        char literal[MAX_LITERAL_LENGTH] = { '\0' };
+
+                        if (GetReciprocal(context, node->inputs[1], reciprocal))
+                        {
+                            FormatLiteral(literal, reciprocal, context->nodes[GetNodeIndex(context, node->inputs[1])]->output.dataCount);
+                            sprintf(temp, "floor(node_%02i*node_%02i)*%s;\n", node->inputs[0], node->inputs[1], literal);
+                        }
+                        else sprintf(temp, "floor(node_%02i*node_%02i)/node_%02i;\n", node->inputs[0], node->inputs[1], node->inputs[1]);
+                    } break;
+                    case FNODE_MAX: sprintf(temp, "max(node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1]); break;
+                    case FNODE_MIN: sprintf(temp, "min(node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1]); break;
+                    case FNODE_LERP: sprintf(temp, "mix(node_%02i, node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1], node->inputs[2]); break;
+                    case FNODE_SMOOTHSTEP: sprintf(temp, "smoothstep(node_%02i, node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1], node->inputs[2]); break;
+                    case FNODE_CROSSPRODUCT: sprintf(temp, "cross(node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1]); break;
+                    case FNODE_DESATURATE:
+                    {
+                        switch (node->output.dataCount)
+                        {
+                            case 1: sprintf(temp, "mix(node_%02i, 0.3, node_%02i);\n", node->inputs[0], node->inputs[1]); break;
+                            case 2: sprintf(temp, "vec2(mix(node_%02i.x, vec2(0.3, 0.59), node_%02i));\n", node->inputs[0], node->inputs[1]); break;
+                            case 3: sprintf(temp, "vec3(mix(node_%02i.xyz, vec3(0.3, 0.59, 0.11), node_%02i));\n", node->inputs[0], node->inputs[1]); break;
+                            case 4: sprintf(temp, "vec4(mix(node_%02i.xyz, vec3(0.3, 0.59, 0.11), node_%02i), 1.0);\n", node->inputs[0], node->inputs[1]); break;
+                            default: break;
+                        }
+                    } break;
+                    case FNODE_DISTANCE: sprintf(temp, "distance(node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1]); break;
+                    case FNODE_DOTPRODUCT: sprintf(temp, "dot(node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1]); break;
+                    case FNODE_LENGTH: sprintf(temp, "length(node_%02i);\n", node->inputs[0]); break;
+                    case FNODE_TRANSPOSE: sprintf(temp, "transpose(node_%02i);\n", node->inputs[0]); break;
+                    case FNODE_PROJECTION:
+                    {
+                        switch (node->output.dataCount)
+                        {
+                            case 2: sprintf(temp, "vec2(dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.x, dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.y);\n", 
+                            node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1]); break;
+                            case 3: sprintf(temp, "vec3(dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.x, dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.y, dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.z);\n", 
+                            node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1]); break;
+                            case 4: sprintf(temp, "vec4(dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.x, dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.y, dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.z, dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.w);\n", 
+                            node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1]); break;
+                            default: break;
+                        }
+                    }
+                    case FNODE_REJECTION:
+                    {
+                        switch (node->output.dataCount)
+                        {
+                            case 2: sprintf(temp, "vec2(node_%02i.x - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.x, node_%02i.y - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.y);\n", 
+                            node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1]); break;
+                            case 3: sprintf(temp, "vec3(node_%02i.x - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.x, node_%02i.y - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.y, node_%02i.z - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.z);\n", 
+                            node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1]); break;
+                            case 4: sprintf(temp, "vec4(node_%02i.x - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.x, node_%02i.y - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.y, node_%02i.z - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.z, node_%02i.w - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.w);\n", 
+                            node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1]); break;
+                            default: break;
+                        }
+                    } break;
+                    case FNODE_HALFDIRECTION: sprintf(temp, "normalize(node_%02i + node_%02i);\n", node->inputs[0], node->inputs[1]); break;
+                    default: break;
+                }
+
+                strcat(body, temp);
+            }
+
+            // Append current node string to shader code
+            AppendString(code, "%s", body);
+        }
+    }
+}
+
+#if !defined(FNODE_NO_EDITOR)
+// Sends a float conversion value of a string to an initialized float pointer
+static void FStringToFloat(float *pointer, const char *string)
+{
+    *pointer = (float)atof(string);
+}
+#endif
+
+// Sends formatted output to an initialized string pointer
+static void FFloatToString(char *buffer, float value)
 {
-    sprintf(buffer, "%.3f", value);
+    // Float values times 1000 are exact doubles, so rounding them gives the same digits as "%.3f" without parsing a format
+    double scaled = fabs((double)value*1000.0);
+
+    if (scaled < 1e15)
+    {
+        long long thousandths = (long long)rint(scaled);
+        long long integer = thousandths/1000;
+        int fraction = (int)(thousandths%1000);
+        char digits[16] = { 0 };
+        int count = 0;
+        int length = 0;
+
+        do
+        {
+            digits[count++] = '0' + (char)(integer%10);
+            integer /= 10;
+        } while (integer > 0);
+
+        if (signbit(value)) buffer[length++] = '-';
+        while (count > 0) buffer[length++] = digits[--count];
+
+        buffer[length++] = '.';
+        buffer[length++] = '0' + (char)(fraction/100);
+        buffer[length++] = '0' + (char)((fraction/10)%10);
+        buffer[length++] = '0' + (char)(fraction%10);
+        buffer[length] = '\0';
+    }
+    else sprintf(buffer, "%.3f", value);
 }
 
 #endif  // FNODE_IMPLEMENTATION
@@ -0,0 +1,386 @@
+/**********************************************************************************************
+*
+*   FNode 1.1 - Graph Benchmark
+*
+*   DESCRIPTION:
+*
+*   Headless tool that builds large generated graphs and measures how long FNode takes to calculate
+*   their nodes values and to generate their shaders code. Every graph is a deterministic set of
+*   chains of add, multiply, subtract and sine operators that reuse earlier sine values of their chain,
+*   fed by a time uniform so shaders code can not be folded into literals. Chains are joined by a tree
+*   of add operators linked to fragment output, and vertex output is linked to the first chain.
+*
+*   Operator kernels of every instruction set supported by current CPU (scalar, SSE and AVX tables)
+*   can be timed instead, over vector, matrix and batch chunk sized values counts. Operations without
+*   kernels (lerp, power and normalize) are timed once as they are the same for every table.
+*
+*   USAGE:
+*
+*   fnode_bench [-n nodes] [-i iterations] [-kernels]
+*
+*       -n          Benchmarks a single graph with a number of nodes (1000 and 10000 nodes graphs by default)
+*       -i          Number of timed iterations of every measure (20 by default)
+*       -kernels    Logs nanoseconds per call of every operator kernel instead of benchmarking graphs
+*
+*   Use the following code to compile:
+*   gcc -o $(NAME_PART).exe $(FILE_NAME) -lraylib -lopengl32 -lgdi32 -lpthread -std=c99
+*
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2016-2020 Victor Fisac
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+//----------------------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------------------
+#define _POSIX_C_SOURCE 199309L     // Required for: clock_gettime()
+
+#define FNODE_NO_EDITOR             // Graphs are benchmarked without window, so editor drawing and OpenGL functions are not built
+#define FNODE_EXTERN                // Library functions not used by the benchmark are kept without unused static functions warnings
+#define FNODE_IMPLEMENTATION
+#include "fnode.h"
+
+#include <time.h>                   // Required for: clock_gettime(), CLOCK_MONOTONIC
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define     BENCH_DEFAULT_ITERATIONS    20                                          // Timed iterations of every measure when not specified
+#define     BENCH_CHAIN_LENGTH          64                                          // Generated nodes chains length (shader generation recurses along inputs)
+#define     BENCH_KERNEL_VALUES         256                                         // Max values count of a timed kernel call (a batch chunk of values)
+#define     BENCH_KERNEL_WORK           4000000                                     // Values processed by every timed kernel measure
+#define     BENCH_KERNELS_COUNT         14                                          // Timed operator kernels count (table kernels first)
+#define     BENCH_TABLE_KERNELS         11                                          // Timed operator kernels that belong to kernels tables
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct BenchGraph {
+    FNode source;                           // Constant node whose values change between timed calculations
+    int nodesCount;                         // Graph nodes count (output nodes included)
+} BenchGraph;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const char *kernelNames[BENCH_KERNELS_COUNT] = { "add", "subtract", "multiply", "divide", "scale", "divideBy", "min", "max", "clamp", "matrixMultiply", "matrixVector", "lerp", "power", "normalize" };
+static float kernelDestination[BENCH_KERNEL_VALUES] = { 0 };                        // Timed kernels destination values
+static float kernelSource[BENCH_KERNEL_VALUES] = { 0 };                             // Timed kernels source values (ones, so destination values do not overflow)
+static float kernelMatrix[16] = { 0 };                                              // Timed matrix kernels source matrix (identity)
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void RunGraphBench(int nodesCount, int iterations);                                 // Builds a generated graph and logs its calculation and shader generation times
+BenchGraph BuildBenchGraph(FNodeContext context, int nodesCount);                   // Creates a generated graph of a number of nodes linked to output nodes
+void RunKernelsBench(void);                                                         // Logs time per call of every operator kernel of each instruction set supported by current CPU
+double TimeKernel(int kernel, int count);                                           // Returns nanoseconds per call of an operator kernel over a number of values (negative if not supported)
+double GetElapsedTime(void);                                                        // Returns monotonic clock time in seconds
+
+//----------------------------------------------------------------------------------
+// Main program
+//----------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    int nodesCount = 0;
+    int iterations = BENCH_DEFAULT_ITERATIONS;
+    bool kernelsBench = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-n") == 0)
+        {
+            if (i + 1 < argc) nodesCount = atoi(argv[++i]);
+            else TraceLogFNode(true, "nodes count expected after -n option");
+        }
+        else if (strcmp(argv[i], "-i") == 0)
+        {
+            if (i + 1 < argc) iterations = atoi(argv[++i]);
+            else TraceLogFNode(true, "iterations count expected after -i option");
+        }
+        else if (strcmp(argv[i], "-kernels") == 0) kernelsBench = true;
+        else
+        {
+            printf("usage: fnode_bench [-n nodes] [-i iterations] [-kernels]\n");
+            return 1;
+        }
+    }
+
+    if (iterations < 1) iterations = 1;
+
+    if (kernelsBench) RunKernelsBench();
+    else if (nodesCount > 0) RunGraphBench(nodesCount, iterations);
+    else
+    {
+        RunGraphBench(1000, iterations);
+        RunGraphBench(10000, iterations);
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Builds a generated graph and logs its calculation and shader generation times
+void RunGraphBench(int nodesCount, int iterations)
+{
+    FNodeContext context = InitFNode();
+
+    double startTime = GetElapsedTime();
+    BenchGraph graph = BuildBenchGraph(context, nodesCount);
+    double buildTime = GetElapsedTime() - startTime;
+
+    // First calculation sorts nodes and lowers their program
+    startTime = GetElapsedTime();
+    CalculateValues(context);
+    double firstTime = GetElapsedTime() - startTime;
+
+    // Source values change every iteration, so all generated nodes are calculated again
+    startTime = GetElapsedTime();
+    for (int i = 0; i < iterations; i++)
+    {
+        graph.source->output.data[0] = 0.5f + (float)(i%8 + 1)*0.0625f;
+        SetNodeDirty(graph.source);
+        CalculateValues(context);
+    }
+    double calculateTime = (GetElapsedTime() - startTime)/iterations;
+
+    int codeLength = 0;
+
+    startTime = GetElapsedTime();
+    for (int i = 0; i < iterations; i++)
+    {
+        FString vertexCode = { 0 };
+        FString fragmentCode = { 0 };
+        GenerateShader(context, GLSL_330, false, &vertexCode, &fragmentCode);
+
+        codeLength = vertexCode.length + fragmentCode.length;
+
+        UnloadString(&vertexCode);
+        UnloadString(&fragmentCode);
+    }
+    double generateTime = (GetElapsedTime() - startTime)/iterations;
+
+    printf("%i nodes: build %.3f ms, first calculation %.3f ms, calculation %.3f ms, shader generation %.3f ms (%i code bytes)\n",
+           graph.nodesCount, buildTime*1000, firstTime*1000, calculateTime*1000, generateTime*1000, codeLength);
+
+    CloseFNode(context);
+}
+
+// Creates a generated graph of a number of nodes linked to output nodes
+BenchGraph BuildBenchGraph(FNodeContext context, int nodesCount)
+{
+    BenchGraph graph = { 0 };
+
+    FNode vertex = CreateNodeMaterial(context, FNODE_VERTEX, "[OUTPUT] Vertex Position", 0);
+    FNode fragment = CreateNodeMaterial(context, FNODE_FRAGMENT, "[OUTPUT] Fragment Color", 0);
+
+    // Time uniform scales constant values, so generated nodes depend on a shader uniform
+    FNode values = CreateNodeVector4(context, (Vector4){ 1.0f, 0.5f, 0.25f, 0.125f });
+    FNode time = CreateNodeUniform(context, FNODE_TIME, "Current Time", 1);
+    time->output.data[0] = 1.0f;
+    FNode scaled = CreateNodeOperator(context, FNODE_MULTIPLY, "Multiply", MAX_INPUTS);
+    CreateNodeLine(context, values->id, scaled->id);
+    CreateNodeLine(context, time->id, scaled->id);
+
+    // Source values are a factor of every multiply node
+    graph.source = CreateNodeVector4(context, (Vector4){ 0.5f, 0.75f, 0.25f, 1.0f });
+
+    // Generated nodes are split in chains of similar length joined by a tree of add nodes (one less than chains)
+    int remaining = nodesCount - context->nodesCount;
+    int chainsCount = (remaining + 1)/(BENCH_CHAIN_LENGTH + 1);
+    if (chainsCount < 1) chainsCount = 1;
+    int chainsNodes = remaining - (chainsCount - 1);
+
+    FNode *ends = (FNode *)FNODE_MALLOC(chainsCount*sizeof(FNode));
+    unsigned int seed = 1;
+
+    for (int c = 0; c < chainsCount; c++)
+    {
+        FNode sines[BENCH_CHAIN_LENGTH] = { 0 };
+        int sinesCount = 0;
+        int length = chainsNodes/chainsCount + ((c < chainsNodes%chainsCount) ? 1 : 0);
+        FNode last = scaled;
+
+        // Every fourth node is a sine, so values stay in a small range along the chain
+        for (int i = 0; i < length; i++)
+        {
+            FNode node = NULL;
+
+            switch (i%4)
+            {
+                case 0:
+                {
+                    node = CreateNodeOperator(context, FNODE_SIN, "Sine", 1);
+                    CreateNodeLine(context, last->id, node->id);
+
+                    sines[sinesCount++] = node;
+                } break;
+                case 2:
+                {
+                    node = CreateNodeOperator(context, FNODE_MULTIPLY, "Multiply", MAX_INPUTS);
+                    CreateNodeLine(context, last->id, node->id);
+                    CreateNodeLine(context, graph.source->id, node->id);
+                } break;
+                default:
+                {
+                    node = CreateNodeOperator(context, ((i%4 == 1) ? FNODE_ADD : FNODE_SUBTRACT), ((i%4 == 1) ? "Add" : "Subtract"), MAX_INPUTS);
+                    CreateNodeLine(context, last->id, node->id);
+
+                    // Reused values come from a pseudo-random earlier sine node of the same chain
+                    seed = seed*1103515245 + 12345;
+                    CreateNodeLine(context, sines[(seed >> 16)%sinesCount]->id, node->id);
+                } break;
+            }
+
+            last = node;
+        }
+
+        ends[c] = last;
+    }
+
+    CreateNodeLine(context, ends[0]->id, vertex->id);
+
+    // Chains ends are added in pairs until a single node remains
+    for (int count = chainsCount; count > 1; count = (count + 1)/2)
+    {
+        for (int i = 0; i < count/2; i++)
+        {
+            FNode node = CreateNodeOperator(context, FNODE_ADD, "Add", MAX_INPUTS);
+            CreateNodeLine(context, ends[2*i]->id, node->id);
+            CreateNodeLine(context, ends[2*i + 1]->id, node->id);
+
+            ends[i] = node;
+        }
+
+        if (count%2 == 1) ends[count/2] = ends[count - 1];
+    }
+
+    CreateNodeLine(context, ends[0]->id, fragment->id);
+
+    FNODE_FREE(ends);
+
+    graph.nodesCount = context->nodesCount;
+
+    return graph;
+}
+
+// Logs time per call of every operator kernel of each instruction set supported by current CPU
+void RunKernelsBench(void)
+{
+    const FKernels *tables[3] = { &scalarKernels };
+    int tablesCount = 1;
+    int counts[3] = { 4, 16, BENCH_KERNEL_VALUES };
+
+#if defined(FNODE_SIMD_X86)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("sse")) tables[tablesCount++] = &sseKernels;
+    if (__builtin_cpu_supports("avx")) tables[tablesCount++] = &avxKernels;
+#endif
+
+    // Kernels are called through selected kernels table like lowered programs do, last pass times operations without kernels
+    for (int t = 0; t <= tablesCount; t++)
+    {
+        int first = ((t < tablesCount) ? 0 : BENCH_TABLE_KERNELS);
+        int last = ((t < tablesCount) ? BENCH_TABLE_KERNELS : BENCH_KERNELS_COUNT);
+
+        if (t < tablesCount)
+        {
+            kernels = *tables[t];
+            printf("%s kernels (ns per call)\n", kernels.name);
+        }
+        else printf("operations without kernels (ns per call)\n");
+
+        printf("    %-16s %10s %10s %10s\n", "values", "4", "16", "256");
+
+        for (int k = first; k < last; k++)
+        {
+            printf("    %-16s", kernelNames[k]);
+
+            for (int c = 0; c < 3; c++)
+            {
+                double time = TimeKernel(k, counts[c]);
+
+                if (time >= 0.0) printf(" %10.2f", time);
+                else printf(" %10s", "-");
+            }
+
+            printf("\n");
+        }
+    }
+}
+
+// Returns nanoseconds per call of an operator kernel over a number of values (negative if not supported)
+double TimeKernel(int kernel, int count)
+{
+    // Matrix kernels always work with a matrix, normalize with a vector and instructions with up to an output values
+    if (((kernel == 9) || (kernel == 10)) && (count != 16)) return -1.0;
+    if ((kernel == 13) && (count != 4)) return -1.0;
+    if ((kernel >= BENCH_TABLE_KERNELS) && (count > MAX_VALUES)) return -1.0;
+
+    // Ones and identity matrices keep destination values the same after every call
+    for (int i = 0; i < BENCH_KERNEL_VALUES; i++)
+    {
+        kernelDestination[i] = 1.0f;
+        kernelSource[i] = 1.0f;
+    }
+
+    for (int i = 0; i < 16; i++) kernelMatrix[i] = (((i%5) == 0) ? 1.0f : 0.0f);
+    if (kernel == 9) memcpy(kernelDestination, kernelMatrix, 16*sizeof(float));
+
+    FInstruction instruction = { 0 };
+    instruction.opcode = ((kernel == 11) ? FOP_LERP : ((kernel == 12) ? FOP_POWER : FOP_NORMALIZE));
+    instruction.width = (unsigned char)count;
+
+    int calls = BENCH_KERNEL_WORK/count;
+    double startTime = GetElapsedTime();
+
+    for (int i = 0; i < calls; i++)
+    {
+        switch (kernel)
+        {
+            case 0: kernels.add(kernelDestination, kernelSource, count); break;
+            case 1: kernels.subtract(kernelDestination, kernelSource, count); break;
+            case 2: kernels.multiply(kernelDestination, kernelSource, count); break;
+            case 3: kernels.divide(kernelDestination, kernelSource, count); break;
+            case 4: kernels.scale(kernelDestination, kernelSource[0], count); break;
+            case 5: kernels.divideBy(kernelDestination, kernelSource[0], count); break;
+            case 6: kernels.min(kernelDestination, kernelSource, count); break;
+            case 7: kernels.max(kernelDestination, kernelSource, count); break;
+            case 8: kernels.clamp(kernelDestination, 0.0f, 1.0f, count); break;
+            case 9: kernels.matrixMultiply(kernelDestination, kernelDestination, kernelMatrix); break;
+            case 10: kernels.matrixVector(kernelDestination, kernelMatrix); break;
+            default: ExecuteInstruction(&instruction, kernelDestination, kernelSource, kernelSource, kernelSource); break;
+        }
+    }
+
+    return (GetElapsedTime() - startTime)*1000000000.0/calls;
+}
+
+// Returns monotonic clock time in seconds
+double GetElapsedTime(void)
+{
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + now.tv_nsec/1000000000.0;
+}
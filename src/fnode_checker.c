@@ -0,0 +1,457 @@
+/**********************************************************************************************
+*
+*   FNode 1.1 - Generated Shader Code Equivalence Checker
+*
+*   DESCRIPTION:
+*
+*   Headless tool that builds a corpus of small graphs for every shader code rewrite rule (identity
+*   operands removal, power exponent reduction and constant divisors reciprocal), generates their
+*   fragment shader code and evaluates the rewritten expression of every checked node over several
+*   input values. Every expression result must match the values calculated by FNode on CPU, so a
+*   rewrite rule can never change what a shader outputs.
+*
+*   USAGE:
+*
+*   fnode_checker [-v]
+*
+*       -v          Logs every checked expression and its values
+*
+*   Use the following code to compile:
+*   gcc -o $(NAME_PART).exe $(FILE_NAME) -lraylib -lopengl32 -lgdi32 -lpthread -std=c99
+*
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2016-2020 Victor Fisac
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+//----------------------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------------------
+#define FNODE_NO_EDITOR             // Graphs are checked without window, so editor drawing and OpenGL functions are not built
+#define FNODE_EXTERN                // Library functions not used by the checker are kept without unused static functions warnings
+#define FNODE_IMPLEMENTATION
+#include "fnode.h"
+
+#include <ctype.h>                  // Required for: isalpha(), isdigit()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define     MAX_CHECK_INPUTS            3                                           // Max number of inputs of a checked node
+#define     CHECK_SAMPLES               4                                           // Input values sets every expression is evaluated with
+#define     CHECK_TOLERANCE             0.00001f                                    // Max relative difference between expression and CPU values
+
+#define     ATTRIBUTE(t)                { t, { 0 }, 0 }                             // Check case input linked to a vertex attribute node
+#define     VALUE(x)                    { INPUT_CONSTANT, { x }, 1 }                // Check case input linked to a constant value node
+#define     VECTOR(x, y, z)             { INPUT_CONSTANT, { x, y, z }, 3 }          // Check case input linked to a constant Vector3 node
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum {
+    INPUT_POSITION,                         // Vertex position attribute (vec3, values changed for every sample)
+    INPUT_NORMAL,                           // Vertex normal attribute (vec3, values changed for every sample)
+    INPUT_CONSTANT                          // Constant vector or value node
+} CheckInputType;
+
+typedef struct CheckInput {
+    CheckInputType type;                    // Input node type
+    float values[4];                        // Constant input values
+    int count;                              // Constant input values count
+} CheckInput;
+
+typedef struct CheckCase {
+    const char *name;                       // Rewrite rule description
+    FNodeType type;                         // Checked operator node type
+    CheckInput inputs[MAX_CHECK_INPUTS];    // Checked node inputs
+    int inputsCount;                        // Checked node inputs count
+    bool positive;                          // Attribute values are positive (exponents without real results for negative bases)
+} CheckCase;
+
+typedef struct CheckValue {
+    float values[4];                        // Expression result values
+    int count;                              // Expression result values count (1 to 4)
+} CheckValue;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const CheckCase cases[] = {
+    // Identity operands removal
+    { "x + 0", FNODE_ADD, { ATTRIBUTE(INPUT_POSITION), VECTOR(0, 0, 0) }, 2, false },
+    { "0 + x", FNODE_ADD, { VECTOR(0, 0, 0), ATTRIBUTE(INPUT_POSITION) }, 2, false },
+    { "x + 0 + y", FNODE_ADD, { ATTRIBUTE(INPUT_POSITION), VECTOR(0, 0, 0), ATTRIBUTE(INPUT_NORMAL) }, 3, false },
+    { "x - 0", FNODE_SUBTRACT, { ATTRIBUTE(INPUT_POSITION), VECTOR(0, 0, 0) }, 2, false },
+    { "0 - x", FNODE_SUBTRACT, { VECTOR(0, 0, 0), ATTRIBUTE(INPUT_POSITION) }, 2, false },
+    { "x*1", FNODE_MULTIPLY, { ATTRIBUTE(INPUT_POSITION), VECTOR(1, 1, 1) }, 2, false },
+    { "1*x", FNODE_MULTIPLY, { VECTOR(1, 1, 1), ATTRIBUTE(INPUT_POSITION) }, 2, false },
+    { "x*1*y", FNODE_MULTIPLY, { ATTRIBUTE(INPUT_POSITION), VECTOR(1, 1, 1), ATTRIBUTE(INPUT_NORMAL) }, 3, false },
+    { "x/1", FNODE_DIVIDE, { ATTRIBUTE(INPUT_POSITION), VECTOR(1, 1, 1) }, 2, false },
+    { "1/x", FNODE_DIVIDE, { VECTOR(1, 1, 1), ATTRIBUTE(INPUT_POSITION) }, 2, false },
+
+    // Power exponent reduction
+    { "pow(x, 1)", FNODE_POWER, { ATTRIBUTE(INPUT_POSITION), VALUE(1) }, 2, false },
+    { "pow(x, 2)", FNODE_POWER, { ATTRIBUTE(INPUT_POSITION), VALUE(2) }, 2, false },
+    { "pow(x, 3)", FNODE_POWER, { ATTRIBUTE(INPUT_POSITION), VALUE(3) }, 2, false },
+    { "pow(x, 4)", FNODE_POWER, { ATTRIBUTE(INPUT_POSITION), VALUE(4) }, 2, false },
+    { "pow(x, 0.5)", FNODE_POWER, { ATTRIBUTE(INPUT_POSITION), VALUE(0.5f) }, 2, true },
+    { "pow(x, -1)", FNODE_POWER, { ATTRIBUTE(INPUT_POSITION), VALUE(-1) }, 2, false },
+    { "pow(x, 2.5)", FNODE_POWER, { ATTRIBUTE(INPUT_POSITION), VALUE(2.5f) }, 2, true },
+
+    // Constant divisors reciprocal
+    { "x/c", FNODE_DIVIDE, { ATTRIBUTE(INPUT_POSITION), VECTOR(4, 0.1f, 3) }, 2, false },
+    { "x/s", FNODE_DIVIDE, { ATTRIBUTE(INPUT_POSITION), VALUE(8) }, 2, false },
+    { "x/c/d", FNODE_DIVIDE, { ATTRIBUTE(INPUT_POSITION), VECTOR(7, -0.3f, 1e3f), VECTOR(0.2f, 9, -5) }, 3, false },
+    { "x/y/c", FNODE_DIVIDE, { ATTRIBUTE(INPUT_POSITION), ATTRIBUTE(INPUT_NORMAL), VECTOR(3, 3, 3) }, 3, false },
+    { "posterize(x, s)", FNODE_POSTERIZE, { ATTRIBUTE(INPUT_POSITION), VALUE(3) }, 2, false },
+    { "posterize(x, 0)", FNODE_POSTERIZE, { ATTRIBUTE(INPUT_POSITION), VALUE(0) }, 2, false },
+};
+
+// Attributes values of every sample (position and normal)
+static const float samples[CHECK_SAMPLES][2][3] = {
+    { { 2.0f, -3.0f, 0.5f }, { 0.25f, 1.5f, -2.0f } },
+    { { 0.1f, 7.25f, -1.5f }, { -4.0f, 0.3f, 6.0f } },
+    { { 1000.0f, -0.001f, 3.3f }, { 2.0f, -0.75f, 0.01f } },
+    { { -0.6f, 1.0f, 12.5f }, { 5.5f, -9.0f, 0.125f } },
+};
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool CheckExpression(const CheckCase *check, bool verbose);                         // Generates shader code of a rewrite rule graph and checks its expression against CPU values
+bool GetExpressionCode(const char *code, int id, char *expression, int length);     // Gets the expression assigned to a node variable in generated code
+CheckValue ParseSum(FNodeContext context, const char **text, bool *valid);          // Evaluates an additive expression
+CheckValue ParseProduct(FNodeContext context, const char **text, bool *valid);      // Evaluates a multiplicative expression
+CheckValue ParseFactor(FNodeContext context, const char **text, bool *valid);       // Evaluates a literal, a node variable, a function call or a parenthesized expression
+CheckValue OperateValues(CheckValue a, CheckValue b, char operation, bool *valid);  // Operates two values component-wise, a single value is used for all components
+void SkipSpaces(const char **text);                                                 // Moves text pointer after any white space
+
+//----------------------------------------------------------------------------------
+// Main program
+//----------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    bool verbose = ((argc > 1) && (strcmp(argv[1], "-v") == 0));
+    int casesCount = sizeof(cases)/sizeof(cases[0]);
+    int failedCount = 0;
+
+    for (int i = 0; i < casesCount; i++)
+    {
+        if (!CheckExpression(&cases[i], verbose)) failedCount++;
+    }
+
+    TraceLogFNode(false, "%i rewrite rules checked, %i rewrite rules failed", casesCount, failedCount);
+
+    return ((failedCount > 0) ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Generates shader code of a rewrite rule graph and checks its expression against CPU values
+bool CheckExpression(const CheckCase *check, bool verbose)
+{
+    bool success = true;
+    FNodeContext context = InitFNode();
+
+    CreateNodeMaterial(context, FNODE_VERTEX, "Output Vertex", 0);
+    FNode fragment = CreateNodeMaterial(context, FNODE_FRAGMENT, "Output Fragment", 0);
+    FNode position = CreateNodeUniform(context, FNODE_VERTEXPOSITION, "Vertex Position", 3);
+    FNode normal = CreateNodeUniform(context, FNODE_VERTEXNORMAL, "Normal Direction", 3);
+    FNode node = CreateNodeOperator(context, check->type, check->name, check->inputsCount);
+
+    for (int i = 0; i < check->inputsCount; i++)
+    {
+        const CheckInput *input = &check->inputs[i];
+        FNode from = NULL;
+
+        if (input->type == INPUT_POSITION) from = position;
+        else if (input->type == INPUT_NORMAL) from = normal;
+        else if (input->count == 1) from = CreateNodeValue(context, input->values[0]);
+        else from = CreateNodeVector3(context, (Vector3){ input->values[0], input->values[1], input->values[2] });
+
+        CreateNodeLine(context, from->id, node->id);
+    }
+
+    CreateNodeLine(context, node->id, fragment->id);
+
+    for (int s = 0; (s < CHECK_SAMPLES) && success; s++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            position->output.data[k] = (check->positive ? fabsf(samples[s][0][k]) : samples[s][0][k]);
+            normal->output.data[k] = samples[s][1][k];
+        }
+
+        SetNodeDirty(position);
+        SetNodeDirty(normal);
+        CalculateValues(context);
+
+        FString vertexCode = { 0 };
+        FString fragmentCode = { 0 };
+        char expression[MAX_CODE_LENGTH] = { '\0' };
+        GenerateShader(context, GLSL_330, false, &vertexCode, &fragmentCode);
+
+        if (!GetExpressionCode(fragmentCode.text, node->id, expression, MAX_CODE_LENGTH))
+        {
+            TraceLogFNode(false, "%s: node_%02i is not declared in generated fragment shader", check->name, node->id);
+            success = false;
+        }
+        else
+        {
+            const char *text = expression;
+            bool valid = true;
+            CheckValue result = ParseSum(context, &text, &valid);
+            SkipSpaces(&text);
+
+            if (!valid || (*text != '\0') || (result.count != node->output.dataCount))
+            {
+                TraceLogFNode(false, "%s: unsupported expression \"%s\"", check->name, expression);
+                success = false;
+            }
+            else
+            {
+                for (int k = 0; k < result.count; k++)
+                {
+                    float expected = node->output.data[k];
+                    float difference = fabsf(result.values[k] - expected);
+                    float scale = ((fabsf(expected) > 1.0f) ? fabsf(expected) : 1.0f);
+
+                    // Values without a real result have to be undefined in both sides
+                    if ((expected != expected) || (result.values[k] != result.values[k])) success &= ((expected != expected) && (result.values[k] != result.values[k]));
+                    else success &= (difference <= CHECK_TOLERANCE*scale);
+                }
+
+                if (!success) TraceLogFNode(false, "%s: \"%s\" returns (%g, %g, %g) instead of (%g, %g, %g)", check->name, expression, result.values[0], result.values[1], result.values[2], node->output.data[0], node->output.data[1], node->output.data[2]);
+                else if (verbose) TraceLogFNode(false, "%s: \"%s\" returns (%g, %g, %g)", check->name, expression, result.values[0], result.values[1], result.values[2]);
+            }
+        }
+
+        UnloadString(&vertexCode);
+        UnloadString(&fragmentCode);
+    }
+
+    CloseFNode(context);
+
+    return success;
+}
+
+// Gets the expression assigned to a node variable in generated code
+bool GetExpressionCode(const char *code, int id, char *expression, int length)
+{
+    char variable[32] = { '\0' };
+    sprintf(variable, " node_%02i = ", id);
+
+    const char *start = strstr(code, variable);
+    if (start == NULL) return false;
+
+    start += strlen(variable);
+    const char *end = strchr(start, ';');
+    if ((end == NULL) || ((end - start) >= length)) return false;
+
+    memcpy(expression, start, end - start);
+    expression[end - start] = '\0';
+
+    return true;
+}
+
+// Evaluates an additive expression
+CheckValue ParseSum(FNodeContext context, const char **text, bool *valid)
+{
+    CheckValue value = ParseProduct(context, text, valid);
+    SkipSpaces(text);
+
+    while (*valid && ((**text == '+') || (**text == '-')))
+    {
+        char operation = **text;
+        (*text)++;
+
+        value = OperateValues(value, ParseProduct(context, text, valid), operation, valid);
+        SkipSpaces(text);
+    }
+
+    return value;
+}
+
+// Evaluates a multiplicative expression
+CheckValue ParseProduct(FNodeContext context, const char **text, bool *valid)
+{
+    CheckValue value = ParseFactor(context, text, valid);
+    SkipSpaces(text);
+
+    while (*valid && ((**text == '*') || (**text == '/')))
+    {
+        char operation = **text;
+        (*text)++;
+
+        value = OperateValues(value, ParseFactor(context, text, valid), operation, valid);
+        SkipSpaces(text);
+    }
+
+    return value;
+}
+
+// Evaluates a literal, a node variable, a function call or a parenthesized expression
+CheckValue ParseFactor(FNodeContext context, const char **text, bool *valid)
+{
+    CheckValue value = { { 0 }, 1 };
+    SkipSpaces(text);
+
+    if (**text == '(')
+    {
+        (*text)++;
+        value = ParseSum(context, text, valid);
+        SkipSpaces(text);
+
+        if (**text == ')') (*text)++;
+        else *valid = false;
+    }
+    else if (**text == '-')
+    {
+        (*text)++;
+        value = ParseFactor(context, text, valid);
+        for (int k = 0; k < value.count; k++) value.values[k] = -value.values[k];
+    }
+    else if (isdigit((unsigned char)**text) || (**text == '.'))
+    {
+        char *end = NULL;
+        value.values[0] = strtof(*text, &end);
+        *text = end;
+    }
+    else if (isalpha((unsigned char)**text))
+    {
+        char name[32] = { '\0' };
+        int length = 0;
+
+        while ((isalpha((unsigned char)**text) || isdigit((unsigned char)**text) || (**text == '_')) && (length < 31)) name[length++] = *(*text)++;
+
+        if (strncmp(name, "node_", 5) == 0)
+        {
+            // Referenced node variables hold the values calculated on CPU
+            int id = atoi(name + 5);
+
+            if ((id >= 0) && (id < context->nodesLimit) && (context->nodesIndex[id] != -1))
+            {
+                FNode node = context->nodes[context->nodesIndex[id]];
+
+                if ((node->output.dataCount >= 1) && (node->output.dataCount <= 4))
+                {
+                    for (int k = 0; k < node->output.dataCount; k++) value.values[k] = node->output.data[k];
+                    value.count = node->output.dataCount;
+                }
+                else *valid = false;
+            }
+            else *valid = false;
+        }
+        else
+        {
+            // Function arguments are evaluated in order, constructors append their components
+            CheckValue arguments[4] = { 0 };
+            int argumentsCount = 0;
+
+            SkipSpaces(text);
+            if (**text == '(') (*text)++;
+            else *valid = false;
+
+            while (*valid && (argumentsCount < 4))
+            {
+                arguments[argumentsCount++] = ParseSum(context, text, valid);
+                SkipSpaces(text);
+
+                if (**text == ',') (*text)++;
+                else break;
+            }
+
+            SkipSpaces(text);
+            if (**text == ')') (*text)++;
+            else *valid = false;
+
+            if (!*valid) return value;
+
+            if ((strcmp(name, "vec2") == 0) || (strcmp(name, "vec3") == 0) || (strcmp(name, "vec4") == 0) || (strcmp(name, "float") == 0))
+            {
+                int count = ((name[0] == 'f') ? 1 : (name[3] - '0'));
+                value.count = 0;
+
+                for (int i = 0; i < argumentsCount; i++)
+                {
+                    for (int k = 0; (k < arguments[i].count) && (value.count < count); k++) value.values[value.count++] = arguments[i].values[k];
+                }
+
+                // A single scalar argument sets all components
+                if ((argumentsCount == 1) && (arguments[0].count == 1)) for (value.count = 1; value.count < count; value.count++) value.values[value.count] = arguments[0].values[0];
+
+                if (value.count != count) *valid = false;
+            }
+            else if ((argumentsCount == 1) && ((strcmp(name, "sqrt") == 0) || (strcmp(name, "floor") == 0) || (strcmp(name, "abs") == 0)))
+            {
+                value = arguments[0];
+
+                for (int k = 0; k < value.count; k++)
+                {
+                    if (name[0] == 's') value.values[k] = sqrtf(value.values[k]);
+                    else if (name[0] == 'f') value.values[k] = floorf(value.values[k]);
+                    else value.values[k] = fabsf(value.values[k]);
+                }
+            }
+            else if ((argumentsCount == 2) && (strcmp(name, "pow") == 0)) value = OperateValues(arguments[0], arguments[1], '^', valid);
+            else *valid = false;
+        }
+    }
+    else *valid = false;
+
+    return value;
+}
+
+// Operates two values component-wise, a single value is used for all components
+CheckValue OperateValues(CheckValue a, CheckValue b, char operation, bool *valid)
+{
+    CheckValue result = { { 0 }, ((a.count > b.count) ? a.count : b.count) };
+
+    if ((a.count != b.count) && (a.count != 1) && (b.count != 1))
+    {
+        *valid = false;
+        return result;
+    }
+
+    for (int k = 0; k < result.count; k++)
+    {
+        float x = a.values[((a.count == 1) ? 0 : k)];
+        float y = b.values[((b.count == 1) ? 0 : k)];
+
+        switch (operation)
+        {
+            case '+': result.values[k] = x + y; break;
+            case '-': result.values[k] = x - y; break;
+            case '*': result.values[k] = x*y; break;
+            case '/': result.values[k] = x/y; break;
+            case '^': result.values[k] = powf(x, y); break;
+            default: *valid = false; break;
+        }
+    }
+
+    return result;
+}
+
+// Moves text pointer after any white space
+void SkipSpaces(const char **text)
+{
+    while ((**text == ' ') || (**text == '\t') || (**text == '\n')) (*text)++;
+}
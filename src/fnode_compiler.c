@@ -0,0 +1,294 @@
+/**********************************************************************************************
+*
+*   FNode 1.1 - Command Line Shader Compiler
+*
+*   DESCRIPTION:
+*
+*   Headless tool that loads FNode serialized graph files (.fnode), calculates their nodes values
+*   and generates their GLSL vertex and fragment shaders code without creating any window or OpenGL
+*   context, so shaders can be generated in assets build pipelines. Every graph file is compiled
+*   to a vertex shader (.vs) and a fragment shader (.fs) with the same base name.
+*
+*   Graph files are compiled concurrently by a pool of worker threads. Every graph is loaded in its
+*   own FNode context, so workers do not share any nodes, lines or shader generation state.
+*
+*   USAGE:
+*
+*   fnode_compiler [-glsl330 | -glsl100] [-hoist] [-o output_folder] [-j workers] [-bench] file.fnode [file.fnode ...]
+*
+*       -glsl330    Generates GLSL 330 shaders code (default)
+*       -glsl100    Generates GLSL 100 (OpenGL ES 2.0) shaders code
+*       -hoist      Computes linearly interpolable fragment values in vertex stage
+*       -o          Writes shaders to an output folder instead of each graph file folder
+*       -j          Compiles graph files with a number of worker threads (a worker per CPU core by default)
+*       -bench      Compiles all graph files with 1, 2, 4... up to the workers count and logs graphs per second
+*
+*   Use the following code to compile:
+*   gcc -o $(NAME_PART).exe $(FILE_NAME) -lraylib -lopengl32 -lgdi32 -lpthread -std=c99
+*
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2016-2020 Victor Fisac
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+//----------------------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------------------
+#define _POSIX_C_SOURCE 199309L     // Required for: clock_gettime()
+
+#define FNODE_NO_EDITOR             // Graphs are compiled without window, so editor drawing and OpenGL functions are not built
+#define FNODE_EXTERN                // Library functions not used by the compiler are kept without unused static functions warnings
+#define FNODE_IMPLEMENTATION
+#include "fnode.h"
+
+#include <time.h>                   // Required for: clock_gettime(), CLOCK_MONOTONIC
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define     MAX_PATH_LENGTH             512                                         // Max length of input and output file paths
+#define     MAX_COMPILE_WORKERS         64                                          // Max number of graph compiling worker threads
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct CompileJob {
+    char **files;                           // Graph files paths
+    int filesCount;                         // Graph files count
+    int next;                               // Next graph file to compile (taken by every worker)
+    const char *outputFolder;               // Shaders output folder (NULL to write them next to every graph file)
+    ShaderVersion version;                  // Generated shaders version
+    bool hoistVertex;                       // Linearly interpolable fragment values are computed in vertex stage
+    int compiledCount;                      // Compiled graph files count
+    int failedCount;                        // Failed graph files count
+} CompileJob;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+double RunCompileJob(CompileJob *job, int workersCount);                            // Compiles all job graph files on worker threads and returns elapsed time
+void *RunCompileWorker(void *data);                                                 // Compiles job graph files until all of them are taken
+bool CompileGraph(const char *fileName, const char *outputFolder, ShaderVersion version, bool hoistVertex);  // Loads a graph file and writes its generated vertex and fragment shaders
+bool WriteShaderCode(const char *fileName, const FString *code);                    // Writes generated shader code to a file
+void GetOutputPath(char *path, const char *fileName, const char *outputFolder, const char *extension);  // Gets a shader file path from a graph file path replacing its extension
+double GetElapsedTime(void);                                                        // Returns monotonic clock time in seconds
+
+//----------------------------------------------------------------------------------
+// Main program
+//----------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    CompileJob job = { 0 };
+    job.version = GLSL_330;
+    job.files = (char **)FNODE_MALLOC(argc*sizeof(char *));
+
+    int workersCount = 0;
+    bool benchmark = false;
+
+    // Options are applied to every graph file regardless of their position
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-glsl330") == 0) job.version = GLSL_330;
+        else if (strcmp(argv[i], "-glsl100") == 0) job.version = GLSL_100;
+        else if (strcmp(argv[i], "-hoist") == 0) job.hoistVertex = true;
+        else if (strcmp(argv[i], "-bench") == 0) benchmark = true;
+        else if (strcmp(argv[i], "-o") == 0)
+        {
+            if (i + 1 < argc) job.outputFolder = argv[++i];
+            else TraceLogFNode(true, "output folder expected after -o option");
+        }
+        else if (strcmp(argv[i], "-j") == 0)
+        {
+            if (i + 1 < argc) workersCount = atoi(argv[++i]);
+            else TraceLogFNode(true, "workers count expected after -j option");
+        }
+        else if (argv[i][0] == '-') TraceLogFNode(true, "unknown option %s", argv[i]);
+        else job.files[job.filesCount++] = argv[i];
+    }
+
+    if (job.filesCount == 0)
+    {
+        printf("usage: fnode_compiler [-glsl330 | -glsl100] [-hoist] [-o output_folder] [-j workers] [-bench] file.fnode [file.fnode ...]\n");
+        FNODE_FREE(job.files);
+        return 1;
+    }
+
+#if defined(FNODE_THREADS)
+    // Use a worker per CPU core when workers count is not specified
+    if (workersCount <= 0) workersCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (workersCount > MAX_COMPILE_WORKERS) workersCount = MAX_COMPILE_WORKERS;
+    if (workersCount < 1) workersCount = 1;
+
+    if (benchmark)
+    {
+        // Throughput is measured doubling workers count up to the requested one
+        for (int workers = 1; workers > 0; workers *= 2)
+        {
+            if (workers > workersCount) workers = workersCount;
+
+            job.next = 0;
+            job.compiledCount = 0;
+            job.failedCount = 0;
+
+            double elapsedTime = RunCompileJob(&job, workers);
+
+            printf("%i workers: %i graphs in %.3f seconds (%.0f graphs/s)\n", workers, job.filesCount, elapsedTime, ((elapsedTime > 0) ? job.filesCount/elapsedTime : 0.0));
+
+            if (workers == workersCount) break;
+        }
+    }
+    else
+    {
+        double elapsedTime = RunCompileJob(&job, workersCount);
+
+        TraceLogFNode(false, "%i graphs compiled, %i graphs failed with %i workers (%.0f graphs/s)", job.compiledCount, job.failedCount, workersCount, ((elapsedTime > 0) ? job.filesCount/elapsedTime : 0.0));
+    }
+
+    FNODE_FREE(job.files);
+
+    return ((job.failedCount > 0) ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Compiles all job graph files on worker threads and returns elapsed time
+double RunCompileJob(CompileJob *job, int workersCount)
+{
+    if (workersCount > job->filesCount) workersCount = job->filesCount;
+
+    double startTime = GetElapsedTime();
+
+#if defined(FNODE_THREADS)
+    pthread_t threads[MAX_COMPILE_WORKERS];
+    bool started[MAX_COMPILE_WORKERS] = { 0 };
+
+    // First worker runs on current thread, graph files are taken by the started workers only
+    for (int i = 1; i < workersCount; i++) started[i] = (pthread_create(&threads[i], NULL, RunCompileWorker, job) == 0);
+
+    RunCompileWorker(job);
+
+    for (int i = 1; i < workersCount; i++)
+    {
+        if (started[i]) pthread_join(threads[i], NULL);
+    }
+#else
+    RunCompileWorker(job);
+#endif
+
+    return (GetElapsedTime() - startTime);
+}
+
+// Compiles job graph files until all of them are taken
+void *RunCompileWorker(void *data)
+{
+    CompileJob *job = (CompileJob *)data;
+
+    for (int i = FETCH_ADD(&job->next, 1); i < job->filesCount; i = FETCH_ADD(&job->next, 1))
+    {
+        if (CompileGraph(job->files[i], job->outputFolder, job->version, job->hoistVertex)) FETCH_ADD(&job->compiledCount, 1);
+        else FETCH_ADD(&job->failedCount, 1);
+    }
+
+    return NULL;
+}
+
+// Loads a graph file and writes its generated vertex and fragment shaders
+bool CompileGraph(const char *fileName, const char *outputFolder, ShaderVersion version, bool hoistVertex)
+{
+    bool success = false;
+
+    // Every graph starts from an empty context so previous graph ids do not leak in generated code
+    FNodeContext context = InitFNode();
+
+    if (!LoadGraph(context, fileName)) TraceLogFNode(false, "error when trying to load graph file %s", fileName);
+    else if ((context->nodesCount < 2) || (context->nodes[0]->type != FNODE_VERTEX) || (context->nodes[1]->type != FNODE_FRAGMENT)) TraceLogFNode(false, "graph file %s has no vertex and fragment output nodes", fileName);
+    else if ((context->nodes[0]->inputsCount == 0) || (context->nodes[1]->inputsCount == 0)) TraceLogFNode(false, "graph file %s output nodes are not linked", fileName);
+    else if (context->cycleDetected) TraceLogFNode(false, "graph file %s nodes links contain a cycle", fileName);
+    else
+    {
+        FString vertexCode = { 0 };
+        FString fragmentCode = { 0 };
+        GenerateShader(context, version, hoistVertex, &vertexCode, &fragmentCode);
+
+        char vertexPath[MAX_PATH_LENGTH] = { 0 };
+        char fragmentPath[MAX_PATH_LENGTH] = { 0 };
+        GetOutputPath(vertexPath, fileName, outputFolder, ".vs");
+        GetOutputPath(fragmentPath, fileName, outputFolder, ".fs");
+
+        if (!WriteShaderCode(vertexPath, &vertexCode)) TraceLogFNode(false, "error when trying to open and write in vertex shader file %s", vertexPath);
+        else if (!WriteShaderCode(fragmentPath, &fragmentCode)) TraceLogFNode(false, "error when trying to open and write in fragment shader file %s", fragmentPath);
+        else success = true;
+
+        UnloadString(&vertexCode);
+        UnloadString(&fragmentCode);
+    }
+
+    CloseFNode(context);
+
+    return success;
+}
+
+// Writes generated shader code to a file
+bool WriteShaderCode(const char *fileName, const FString *code)
+{
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) return false;
+
+    fwrite(code->text, 1, code->length, file);
+    fclose(file);
+
+    return true;
+}
+
+// Gets a shader file path from a graph file path replacing its extension
+void GetOutputPath(char *path, const char *fileName, const char *outputFolder, const char *extension)
+{
+    // Base name starts after last folder separator of graph file path
+    const char *baseName = fileName;
+    for (const char *c = fileName; *c != '\0'; c++)
+    {
+        if ((*c == '/') || (*c == '\\')) baseName = c + 1;
+    }
+
+    // Base name ends at its last extension dot
+    int baseLength = (int)strlen(baseName);
+    for (int i = baseLength - 1; i > 0; i--)
+    {
+        if (baseName[i] == '.')
+        {
+            baseLength = i;
+            break;
+        }
+    }
+
+    if (outputFolder != NULL) snprintf(path, MAX_PATH_LENGTH, "%s/%.*s%s", outputFolder, baseLength, baseName, extension);
+    else snprintf(path, MAX_PATH_LENGTH, "%.*s%.*s%s", (int)(baseName - fileName), fileName, baseLength, baseName, extension);
+}
+
+// Returns monotonic clock time in seconds
+double GetElapsedTime(void)
+{
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + now.tv_nsec/1000000000.0;
+}
@@ -57,13 +57,20 @@
 #define FNODE_IMPLEMENTATION
 #include "fnode.h"
 
+// Required for program binary functions loading, raylib desktop platform is built over GLFW3
+typedef void (*GLFWglproc)(void);
+GLFWglproc glfwGetProcAddress(const char *procname);
+
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
 #define     CHAR_SIZE                   512                                         // Shader output max size for text
-#define     MAX_TEXTURES                8                                           // Shader maximum OpenGL texture units
 #define     DEFAULT_PROJECT_TEXTURES    2                                           // Textures to load when loading default project
 #define     COMPILE_DURATION            120                                         // Shader compile result duration
+#define     BAKE_SIZE                   512                                         // Baked fragment output texture width and height
+#define     MAX_SHADER_CACHE            8                                           // Compiled shader programs kept loaded to reuse them
+#define     SHADER_CACHE_FORMAT         1                                           // Generated shader code format version included in cache keys
+#define     MAX_CACHE_FILES             64                                          // Cached shader code and program binary files kept in output folder of each kind
 #define     UI_PADDING                  25                                          // Interface bounds padding with background
 #define     UI_PADDING_SCROLL           0                                           // Interface scroll bar padding
 #define     UI_BUTTON_HEIGHT            30                                          // Interface bounds height
@@ -75,6 +82,12 @@
 #define     VERTEX_PATH                 "output/shader.vs"                          // Vertex shader output path
 #define     FRAGMENT_PATH               "output/shader.fs"                          // Fragment shader output path
 #define     DATA_PATH                   "output/shader.fnode"                       // Shader data output path
+#define     BAKE_PATH                   "output/bake.png"                           // Baked fragment output texture path
+#define     MESH_PATH                   "output/mesh.obj"                           // Evaluated vertex output values mesh path
+#define     CACHE_VERTEX_PATH           "output/cache_%016llx.vs"                   // Cached vertex shader path format by graph hash
+#define     CACHE_FRAGMENT_PATH         "output/cache_%016llx.fs"                   // Cached fragment shader path format by graph hash
+#define     PROGRAM_BINARY_PATH         "output/program_%016llx.bin"                // Cached shader program binary path format by shader code hash
+#define     CACHE_FOLDER                "output"                                    // Cached shader code and program binary files folder
 #define     EXAMPLE_VERTEX_PATH         "res/example/output/shader.vs"              // Vertex shader output path of start example
 #define     EXAMPLE_FRAGMENT_PATH       "res/example/output/shader.fs"              // Fragment shader output path of start example
 #define     EXAMPLE_DATA_PATH           "res/example/output/shader.fnode"           // Shader data output path of start example
@@ -87,8 +100,8 @@
 
 #define     FXAA_SCREENSIZE_UNIFORM     "viewportSize"                              // Visor FXAA shader screen size uniform location name
 
-#define     LEFT_LAYOUT_RECT            (Rectangle){ layoutRect.x, layoutRect.y + (UI_BUTTON_HEIGHT + PADDING_MAIN_CENTER)*menuOffset, layoutRect.width, UI_BUTTON_HEIGHT }
-#define     RIGHT_LAYOUT_RECT           (Rectangle){ layoutRect.x, layoutRect.y + (UI_BUTTON_HEIGHT + PADDING_MAIN_CENTER)*menuOffset, layoutRect.width, layoutRect.height }
+#define     LEFT_LAYOUT_RECT            (Rectangle){ layoutRect.x, layoutRect.y + (UI_BUTTON_HEIGHT + PADDING_MAIN_CENTER)*context->menuOffset, layoutRect.width, UI_BUTTON_HEIGHT }
+#define     RIGHT_LAYOUT_RECT           (Rectangle){ layoutRect.x, layoutRect.y + (UI_BUTTON_HEIGHT + PADDING_MAIN_CENTER)*context->menuOffset, layoutRect.width, layoutRect.height }
 
 // Interface visual style
 #define     COLOR_INTERFACE_SHAPE       (Color){ 245, 245, 245, 255 }
@@ -136,9 +149,26 @@ typedef enum {
     TOGGLE_ACTIVE 
 } ToggleState;
 
+typedef struct ShaderCache {
+    unsigned long long hash;                // Graph structure and settings hash
+    Shader shader;                          // Loaded shader program
+    int lastUse;                            // Compile count when shader program was last used
+} ShaderCache;
+
+typedef struct ShaderCompile {
+    unsigned int program;                   // Linking shader program id (0 if there is no pending compile)
+    unsigned int vertexId;                  // Compiling vertex shader id
+    unsigned int fragmentId;                // Compiling fragment shader id
+    unsigned long long hash;                // Graph structure and settings hash
+    bool cachedCode;                        // Shader code was loaded from cache files
+    FString vertexCode;                     // Compiling vertex shader code
+    FString fragmentCode;                   // Compiling fragment shader code
+} ShaderCompile;
+
 //----------------------------------------------------------------------------------
 // Global Variables
 //----------------------------------------------------------------------------------
+FNodeContext context = NULL;                // Edited graph nodes, lines, comments and canvas state
 Vector2 mousePosition = { 0, 0 };           // Current mouse position
 Vector2 lastMousePosition = { 0, 0 };       // Previous frame mouse position
 Vector2 mouseDelta = { 0, 0 };              // Current frame mouse position increment since previous frame
@@ -170,7 +200,17 @@ Texture2D textures[MAX_TEXTURES] = { 0 };   // Shader texture unit textures
 Rectangle texRects[MAX_TEXTURES] = { 0 };   // Interfaces panels to display current loaded textures and unload them
 bool loadedtexRects = false;                // State of texRects initialization
 int loadedFiles = 0;                        // Loaded textures count
-bool usedUnits[MAX_TEXTURES] = { false };   // Shader compiling used texture units
+bool hoistVertex = false;                   // Shader compiling moves linearly interpolable fragment values to vertex stage
+ShaderCache shaderCache[MAX_SHADER_CACHE] = { 0 };  // Compiled shader programs of previous graphs
+int shaderCacheCount = 0;                   // Compiled shader programs cache count
+int compilesCount = 0;                      // Shader compile requests count
+PFNGLGETPROGRAMBINARYPROC getProgramBinary = NULL;  // Shader program binary retrieve function
+PFNGLPROGRAMBINARYPROC programBinary = NULL;        // Shader program binary load function
+PFNGLPROGRAMPARAMETERIPROC programParameteri = NULL;    // Shader program parameter set function
+bool programBinaries = false;               // Shader program binaries support state
+bool parallelCompile = false;               // Driver shaders parallel compile support state
+ShaderCompile pendingCompile = { 0 };       // Shader program being compiled by driver
+unsigned long long driverHash = 0;          // Current OpenGL vendor, renderer and version hash
 bool drawVisor = true;                      // Visor display enabled state
 bool fullVisor = false;                     // Visor full screen state
 bool help = false;                          // Display help message state
@@ -179,7 +219,7 @@ bool settings = false;                      // Interface settings window state
 ShaderVersion version = GLSL_330;           // Current shader version setting
 bool backfaceCulling = false;               // Current shader backface culling state
 bool prevBackfaceCulling = false;           // Previous shader backface culling state
-int compileState = -1;                      // Compile state (awiting, successful, failed)
+int compileState = -1;                      // Compile state (awiting, failed, successful, pending)
 int framesCounter = 0;                      // Global frames counter
 int compileFrame = 0;                       // Compile time frames count
 Texture2D iconTex;                          // FNode icon texture used in help message
@@ -190,6 +230,7 @@ RenderTexture2D gridTarget;                 // Grid display render target
 // Functions Declaration
 //----------------------------------------------------------------------------------
 void CheckPreviousShader(bool makeGraph);                       // Check if there are a compatible shader in output folder
+void SetVisorShader(Shader newShader);                          // Sets a loaded shader to visor model and gets its uniforms locations
 void LoadDefaultProject(void);                                  // Loads example project nodes and shader
 void UpdateMouseData(void);                                     // Updates current mouse position and delta position
 void UpdateInputsData(void);                                    // Updates current inputs states
@@ -201,10 +242,29 @@ void UpdateCommentCreationEdit(void);                           // Check comment
 void UpdateCommentsDrag(void);                                  // Check comment drag input
 void UpdateCommentsEdit(void);                                  // Check comment text edit input
 void UpdateShaderData(void);                                    // Update required values to created shader for geometry data calculations
-void SaveChanges(void);                                         // Serialize current project data and write to file
-void CompileShader(void);                                       // Compiles all node structure to create the GLSL fragment shader in output folder
-void CheckConstant(FNode node, FILE *file);                     // Check nodes searching for constant values to define them in shaders
-void CompileNode(FNode node, FILE *file, bool fragment);        // Compiles a specific node checking its inputs and writing current node operation in shader
+void SaveChanges(void);                                         // Serialize current project data and generated shader code and write to files
+void CompileShader(void);                                       // Compiles all node structure to create the GLSL shader and load it in visor model
+void RequestShaderCompile(unsigned long long hash, bool useCache);  // Loads a graph shader program binary or starts compiling its code without waiting for the driver
+void UpdateShaderCompile(void);                                 // Check pending shader compile completion to load it in visor model
+void CancelShaderCompile(void);                                 // Discards pending shader compile
+void ApplyCompiledShader(Shader compiled);                      // Replaces visor model shader with a compiled shader program
+bool SaveShaderCode(const char *fileName, const FString *code); // Writes generated shader code to a file
+unsigned long long HashGraph(void);                             // Returns hash of graph structure and settings used to generate shader code
+int FindCachedShader(unsigned long long hash);                  // Returns cached shader program index of a graph hash (-1 if not found)
+bool IsShaderCached(Shader cached);                             // Check if a shader program is owned by compiled shaders cache
+void CacheShader(unsigned long long hash, Shader compiled);     // Stores a compiled shader program, replacing the least recently used one
+void UnloadShaderCache(void);                                   // Unloads all cached shader programs
+void TrimCacheFiles(const char *prefix, int maxFiles);          // Removes the oldest cache files starting with a prefix until a max count is kept
+void InitShaderExtensions(void);                                // Loads shader program binary and parallel compile functions and hashes current driver
+bool IsExtensionSupported(const char *name);                    // Check if current driver supports an OpenGL extension
+unsigned long long HashText(unsigned long long hash, const char *text);    // Returns hash of a text continuing a previous hash
+bool LoadShaderFile(const char *fileName, FString *code);       // Reads shader code from a file
+Shader LoadShaderProgram(char *vsCode, char *fsCode);           // Loads a shader program from binaries cache or compiles its code, storing its binary
+Shader LoadProgramBinary(const char *fileName, unsigned long long hash);   // Loads a shader program binary file created by current driver
+void SaveProgramBinary(const char *fileName, unsigned long long hash, Shader program);  // Writes a linked shader program binary to a file
+void SetProgramLocations(Shader *program);                      // Allocates and sets raylib default locations of a linked shader program
+void BakeTexture(void);                                         // Bakes fragment output color of every texel to a texture in output folder
+void EvaluateMesh(void);                                        // Calculates vertex output values of visor model vertices and exports them to a mesh in output folder
 void AlignAllNodes(void);                                       // Aligns all created nodes
 void ClearUnusedNodes(void);                                    // Destroys all unused nodes
 void ClearGraph(void);                                          // Destroys all created nodes and its linked lines
@@ -232,147 +292,23 @@ bool CheckModelExtension(char *filename);                       // Check filenam
 // Check if there are a compatible shader in output folder
 void CheckPreviousShader(bool makeGraph)
 {
-    Shader previousShader = LoadShader(VERTEX_PATH, FRAGMENT_PATH);
+    // Saved shader code is loaded through program binaries cache to avoid compiling it again
+    Shader previousShader = { 0 };
+    FString vertexCode = { 0 };
+    FString fragmentCode = { 0 };
+
+    if (LoadShaderFile(VERTEX_PATH, &vertexCode) && LoadShaderFile(FRAGMENT_PATH, &fragmentCode)) previousShader = LoadShaderProgram(vertexCode.text, fragmentCode.text);
+
+    UnloadString(&vertexCode);
+    UnloadString(&fragmentCode);
+
     if (previousShader.id > 0)
     {
-        shader = previousShader;
-        model.materials[0].shader = shader;
-        viewUniform = GetShaderLocation(shader, "viewDirection");
-        transformUniform = GetShaderLocation(shader, "modelMatrix");
-        timeUniformV = GetShaderLocation(shader, "vertCurrentTime");
-        timeUniformF = GetShaderLocation(shader, "fragCurrentTime");
-
-        shader.locs[LOC_MAP_ALBEDO] = glGetUniformLocation(shader.id, "texture0");
-        shader.locs[LOC_MAP_NORMAL] = glGetUniformLocation(shader.id, "texture1");
-        shader.locs[LOC_MAP_METALNESS] = glGetUniformLocation(shader.id, "texture2");
-        shader.locs[LOC_MAP_ROUGHNESS] = glGetUniformLocation(shader.id, "texture3");
-        shader.locs[LOC_MAP_OCCLUSION] = glGetUniformLocation(shader.id, "texture4");
-        shader.locs[LOC_MAP_EMISSION] = glGetUniformLocation(shader.id, "texture5");
-        shader.locs[LOC_MAP_HEIGHT] = glGetUniformLocation(shader.id, "texture6");
-        shader.locs[LOC_MAP_BRDF] = glGetUniformLocation(shader.id, "texture7");
+        SetVisorShader(previousShader);
 
         if (makeGraph)
         {
-            FILE *dataFile = fopen(DATA_PATH, "r");
-            if (dataFile != NULL)
-            {
-                float type = -1;
-                float inputs[MAX_INPUTS] = { -1, -1, -1, -1 };
-                float inputsCount = -1;
-                float inputsLimit = -1;
-                float dataCount = -1;
-                float property = -1;
-                float data[MAX_VALUES] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
-                float shapeX = -1;
-                float shapeY = -1;
-
-                while (fscanf(dataFile, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n", &type, &property,
-                &inputs[0], &inputs[1], &inputs[2], &inputs[3], &inputsCount, &inputsLimit, &dataCount, &data[0], &data[1], &data[2],
-                &data[3], &data[4], &data[5], &data[6], &data[7], &data[8], &data[9], &data[10], &data[11], &data[12], &data[13], &data[14],
-                &data[15], &shapeX, &shapeY) > 0)
-                {                
-                    FNode newNode = InitializeNode(true);
-                    newNode->type = type;
-                    newNode->property = property;
-
-                    if (type < FNODE_ADD) newNode->inputShape = (Rectangle){ 0, 0, 0, 0 };
-
-                    switch ((int)type)
-                    {
-                        case FNODE_PI: newNode->name = "Pi"; break;
-                        case FNODE_E: newNode->name = "e"; break;
-                        case FNODE_TIME: newNode->name = "Current Time"; break;
-                        case FNODE_VERTEXPOSITION: newNode->name = "Vertex Position"; break;
-                        case FNODE_VERTEXNORMAL: newNode->name = "Normal Direction"; break;
-                        case FNODE_FRESNEL: newNode->name = "Fresnel"; break;
-                        case FNODE_VIEWDIRECTION: newNode->name = "View Direction"; break;
-                        case FNODE_MVP: newNode->name = "MVP Matrix"; break;
-                        case FNODE_MATRIX: newNode->name = "Matrix 4x4"; break;
-                        case FNODE_VALUE: newNode->name = "Value"; break;
-                        case FNODE_VECTOR2: newNode->name = "Vector 2"; break;
-                        case FNODE_VECTOR3: newNode->name = "Vector 3"; break;
-                        case FNODE_VECTOR4: newNode->name = "Vector 4"; break;
-                        case FNODE_ADD: newNode->name = "Add"; break;
-                        case FNODE_SUBTRACT: newNode->name = "Subtract"; break;
-                        case FNODE_MULTIPLY: newNode->name = "Multiply"; break;
-                        case FNODE_DIVIDE: newNode->name = "Divide"; break;
-                        case FNODE_APPEND: newNode->name = "Append"; break;
-                        case FNODE_ONEMINUS: newNode->name = "One Minus"; break;
-                        case FNODE_ABS: newNode->name = "Abs"; break;
-                        case FNODE_COS:newNode->name = "Cos"; break;
-                        case FNODE_SIN: newNode->name = "Sin"; break;
-                        case FNODE_TAN: newNode->name = "Tan"; break;
-                        case FNODE_DEG2RAD: newNode->name = "Deg to Rad"; break;
-                        case FNODE_RAD2DEG: newNode->name = "Rad to Deg"; break;
-                        case FNODE_NORMALIZE: newNode->name = "Normalize"; break;
-                        case FNODE_NEGATE: newNode->name = "Negate"; break;
-                        case FNODE_RECIPROCAL: newNode->name = "Reciprocal"; break;
-                        case FNODE_SQRT: newNode->name = "Square Root"; break;
-                        case FNODE_TRUNC: newNode->name = "Trunc"; break;
-                        case FNODE_ROUND: newNode->name = "Round"; break;
-                        case FNODE_VERTEXCOLOR: newNode->name = "Vertex Color"; break;
-                        case FNODE_CEIL: newNode->name = "Ceil"; break;
-                        case FNODE_CLAMP01: newNode->name = "Clamp 0-1"; break;
-                        case FNODE_EXP2: newNode->name = "Exp 2"; break;
-                        case FNODE_POWER: newNode->name = "Power"; break;
-                        case FNODE_STEP: newNode->name = "Step"; break;
-                        case FNODE_POSTERIZE: newNode->name = "Posterize"; break;
-                        case FNODE_MAX: newNode->name = "Max"; break;
-                        case FNODE_MIN: newNode->name = "Min"; break;
-                        case FNODE_LERP: newNode->name = "Lerp"; break;
-                        case FNODE_SMOOTHSTEP: newNode->name = "Smooth Step"; break;
-                        case FNODE_CROSSPRODUCT: newNode->name = "Cross Product"; break;
-                        case FNODE_DESATURATE: newNode->name = "Desaturate"; break;
-                        case FNODE_DISTANCE: newNode->name = "Distance"; break;
-                        case FNODE_DOTPRODUCT: newNode->name = "Dot Product"; break;
-                        case FNODE_LENGTH: newNode->name = "Length"; break;
-                        case FNODE_MULTIPLYMATRIX: newNode->name = "Multiply Matrix"; break;
-                        case FNODE_TRANSPOSE: newNode->name = "Transpose"; break;
-                        case FNODE_PROJECTION: newNode->name = "Projection Vector"; break;
-                        case FNODE_REJECTION: newNode->name = "Rejection Vector"; break;
-                        case FNODE_HALFDIRECTION: newNode->name = "Half Direction"; break;
-                        case FNODE_SAMPLER2D: newNode->name = "Sampler 2D"; break;
-                        case FNODE_VERTEX: newNode->name = "[OUTPUT] Vertex Position"; break;
-                        case FNODE_FRAGMENT: newNode->name = "[OUTPUT] Fragment Color"; break;
-                        default: break;
-                    }
-
-                    for (int i = 0; i < MAX_INPUTS; i++) newNode->inputs[i] = inputs[i];
-
-                    newNode->inputsCount = inputsCount;
-                    newNode->inputsLimit = inputsLimit;
-
-                    for (int i = 0; i < MAX_VALUES; i++)
-                    {
-                        newNode->output.data[i].value = data[i];
-                        FFloatToString(newNode->output.data[i].valueText, newNode->output.data[i].value);
-                    }
-
-                    newNode->output.dataCount = dataCount;
-                    newNode->shape.x = shapeX;
-                    newNode->shape.y = shapeY;
-
-                    UpdateNodeShapes(newNode);
-                }
-
-                int from = -1;
-                int to = -1;            
-
-                while (fscanf(dataFile, "?%i?%i\n", &from, &to) > 0)
-                {
-                    tempLine = CreateNodeLine(from);
-                    tempLine->to = to;
-                }
-
-                for (int i = 0; i < nodesCount; i++) UpdateNodeShapes(nodes[i]);
-
-                CalculateValues();
-
-                for (int i = 0; i < nodesCount; i++) UpdateNodeShapes(nodes[i]);
-
-                loadedShader = true;
-                fclose(dataFile);
-            }
+            if (LoadGraph(context, DATA_PATH)) loadedShader = true;
             else TraceLogFNode(false, "error when trying to open previous shader data file");
         }
     }
@@ -381,6 +317,26 @@ void CheckPreviousShader(bool makeGraph)
     if (!loadedShader) LoadDefaultProject();
 }
 
+// Sets a loaded shader to visor model and gets its uniforms locations
+void SetVisorShader(Shader newShader)
+{
+    shader = newShader;
+    model.materials[0].shader = shader;
+    viewUniform = GetShaderLocation(shader, "viewDirection");
+    transformUniform = GetShaderLocation(shader, "modelMatrix");
+    timeUniformV = GetShaderLocation(shader, "vertCurrentTime");
+    timeUniformF = GetShaderLocation(shader, "fragCurrentTime");
+
+    shader.locs[LOC_MAP_ALBEDO] = glGetUniformLocation(shader.id, "texture0");
+    shader.locs[LOC_MAP_NORMAL] = glGetUniformLocation(shader.id, "texture1");
+    shader.locs[LOC_MAP_METALNESS] = glGetUniformLocation(shader.id, "texture2");
+    shader.locs[LOC_MAP_ROUGHNESS] = glGetUniformLocation(shader.id, "texture3");
+    shader.locs[LOC_MAP_OCCLUSION] = glGetUniformLocation(shader.id, "texture4");
+    shader.locs[LOC_MAP_EMISSION] = glGetUniformLocation(shader.id, "texture5");
+    shader.locs[LOC_MAP_HEIGHT] = glGetUniformLocation(shader.id, "texture6");
+    shader.locs[LOC_MAP_BRDF] = glGetUniformLocation(shader.id, "texture7");
+}
+
 // Loads the default project nodes and shader
 void LoadDefaultProject(void)
 {
@@ -407,132 +363,13 @@ void LoadDefaultProject(void)
         timeUniformV = GetShaderLocation(shader, "vertCurrentTime");
         timeUniformF = GetShaderLocation(shader, "fragCurrentTime");
 
-        FILE *dataFile = fopen(EXAMPLE_DATA_PATH, "r");
-        if (dataFile != NULL)
-        {
-            float type = -1;
-            float inputs[MAX_INPUTS] = { -1, -1, -1, -1 };
-            float inputsCount = -1;
-            float inputsLimit = -1;
-            float dataCount = -1;
-            float property = -1;
-            float data[MAX_VALUES] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
-            float shapeX = -1;
-            float shapeY = -1;
-
-            while (fscanf(dataFile, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n", &type, &property,
-            &inputs[0], &inputs[1], &inputs[2], &inputs[3], &inputsCount, &inputsLimit, &dataCount, &data[0], &data[1], &data[2],
-            &data[3], &data[4], &data[5], &data[6], &data[7], &data[8], &data[9], &data[10], &data[11], &data[12], &data[13], &data[14],
-            &data[15], &shapeX, &shapeY) > 0)
-            {                
-                FNode newNode = InitializeNode(true);
-                newNode->type = type;
-                newNode->property = property;
-
-                if (type < FNODE_ADD) newNode->inputShape = (Rectangle){ 0, 0, 0, 0 };
-
-                switch ((int)type)
-                {
-                    case FNODE_PI: newNode->name = "Pi"; break;
-                    case FNODE_E: newNode->name = "e"; break;
-                    case FNODE_TIME: newNode->name = "Current Time"; break;
-                    case FNODE_VERTEXPOSITION: newNode->name = "Vertex Position"; break;
-                    case FNODE_VERTEXNORMAL: newNode->name = "Normal Direction"; break;
-                    case FNODE_FRESNEL: newNode->name = "Fresnel"; break;
-                    case FNODE_VIEWDIRECTION: newNode->name = "View Direction"; break;
-                    case FNODE_MVP: newNode->name = "MVP Matrix"; break;
-                    case FNODE_MATRIX: newNode->name = "Matrix 4x4"; break;
-                    case FNODE_VALUE: newNode->name = "Value"; break;
-                    case FNODE_VECTOR2: newNode->name = "Vector 2"; break;
-                    case FNODE_VECTOR3: newNode->name = "Vector 3"; break;
-                    case FNODE_VECTOR4: newNode->name = "Vector 4"; break;
-                    case FNODE_ADD: newNode->name = "Add"; break;
-                    case FNODE_SUBTRACT: newNode->name = "Subtract"; break;
-                    case FNODE_MULTIPLY: newNode->name = "Multiply"; break;
-                    case FNODE_DIVIDE: newNode->name = "Divide"; break;
-                    case FNODE_APPEND: newNode->name = "Append"; break;
-                    case FNODE_ONEMINUS: newNode->name = "One Minus"; break;
-                    case FNODE_ABS: newNode->name = "Abs"; break;
-                    case FNODE_COS:newNode->name = "Cos"; break;
-                    case FNODE_SIN: newNode->name = "Sin"; break;
-                    case FNODE_TAN: newNode->name = "Tan"; break;
-                    case FNODE_DEG2RAD: newNode->name = "Deg to Rad"; break;
-                    case FNODE_RAD2DEG: newNode->name = "Rad to Deg"; break;
-                    case FNODE_NORMALIZE: newNode->name = "Normalize"; break;
-                    case FNODE_NEGATE: newNode->name = "Negate"; break;
-                    case FNODE_RECIPROCAL: newNode->name = "Reciprocal"; break;
-                    case FNODE_SQRT: newNode->name = "Square Root"; break;
-                    case FNODE_TRUNC: newNode->name = "Trunc"; break;
-                    case FNODE_ROUND: newNode->name = "Round"; break;
-                    case FNODE_VERTEXCOLOR: newNode->name = "Vertex Color"; break;
-                    case FNODE_CEIL: newNode->name = "Ceil"; break;
-                    case FNODE_CLAMP01: newNode->name = "Clamp 0-1"; break;
-                    case FNODE_EXP2: newNode->name = "Exp 2"; break;
-                    case FNODE_POWER: newNode->name = "Power"; break;
-                    case FNODE_STEP: newNode->name = "Step"; break;
-                    case FNODE_POSTERIZE: newNode->name = "Posterize"; break;
-                    case FNODE_MAX: newNode->name = "Max"; break;
-                    case FNODE_MIN: newNode->name = "Min"; break;
-                    case FNODE_LERP: newNode->name = "Lerp"; break;
-                    case FNODE_SMOOTHSTEP: newNode->name = "Smooth Step"; break;
-                    case FNODE_CROSSPRODUCT: newNode->name = "Cross Product"; break;
-                    case FNODE_DESATURATE: newNode->name = "Desaturate"; break;
-                    case FNODE_DISTANCE: newNode->name = "Distance"; break;
-                    case FNODE_DOTPRODUCT: newNode->name = "Dot Product"; break;
-                    case FNODE_LENGTH: newNode->name = "Length"; break;
-                    case FNODE_MULTIPLYMATRIX: newNode->name = "Multiply Matrix"; break;
-                    case FNODE_TRANSPOSE: newNode->name = "Transpose"; break;
-                    case FNODE_PROJECTION: newNode->name = "Projection Vector"; break;
-                    case FNODE_REJECTION: newNode->name = "Rejection Vector"; break;
-                    case FNODE_HALFDIRECTION: newNode->name = "Half Direction"; break;
-                    case FNODE_SAMPLER2D: newNode->name = "Sampler 2D"; break;
-                    case FNODE_VERTEX: newNode->name = "[OUTPUT] Vertex Position"; break;
-                    case FNODE_FRAGMENT: newNode->name = "[OUTPUT] Fragment Color"; break;
-                    default: break;
-                }
-
-                for (int i = 0; i < MAX_INPUTS; i++) newNode->inputs[i] = inputs[i];
-
-                newNode->inputsCount = inputsCount;
-                newNode->inputsLimit = inputsLimit;
-
-                for (int i = 0; i < MAX_VALUES; i++)
-                {
-                    newNode->output.data[i].value = data[i];
-                    FFloatToString(newNode->output.data[i].valueText, newNode->output.data[i].value);
-                }
-
-                newNode->output.dataCount = dataCount;
-                newNode->shape.x = shapeX;
-                newNode->shape.y = shapeY;
-
-                UpdateNodeShapes(newNode);
-            }
-
-            int from = -1;
-            int to = -1;  
-
-            while (fscanf(dataFile, "?%i?%i\n", &from, &to) > 0)
-            {
-                tempLine = CreateNodeLine(from);
-                tempLine->to = to;
-            }
-
-            for (int i = 0; i < nodesCount; i++) UpdateNodeShapes(nodes[i]);
-
-            CalculateValues();
-
-            for (int i = 0; i < nodesCount; i++) UpdateNodeShapes(nodes[i]);
-
-            loadedShader = true;
-            fclose(dataFile);
-        }
+        if (LoadGraph(context, EXAMPLE_DATA_PATH)) loadedShader = true;
     }
 
     if (!loadedShader)
     {
-        CreateNodeMaterial(FNODE_VERTEX, "[OUTPUT] Vertex Position", 0);
-        CreateNodeMaterial(FNODE_FRAGMENT, "[OUTPUT] Fragment Color", 0);
+        CreateNodeMaterial(context, FNODE_VERTEX, "[OUTPUT] Vertex Position", 0);
+        CreateNodeMaterial(context, FNODE_FRAGMENT, "[OUTPUT] Fragment Color", 0);
     }
 }
 
@@ -543,24 +380,31 @@ void UpdateMouseData(void)
     lastMousePosition = mousePosition;
     mousePosition = GetMousePosition();
     mouseDelta = (Vector2){ mousePosition.x - lastMousePosition.x, mousePosition.y - lastMousePosition.y };
-    overUI = CheckCollisionPointRec(mousePosition, (Rectangle){ 0, 0, screenSize.x - canvasSize.x, screenSize.y });
+    overUI = CheckCollisionPointRec(mousePosition, (Rectangle){ 0, 0, context->screenSize.x - canvasSize.x, context->screenSize.y });
 
-    if (!overUI) CheckCollisionPointRec(mousePosition, (Rectangle){ canvasSize.x, 0, screenSize.x - canvasSize.x, screenSize.y });
+    if (!overUI) CheckCollisionPointRec(mousePosition, (Rectangle){ canvasSize.x, 0, context->screenSize.x - canvasSize.x, context->screenSize.y });
 }
 
 // Updates current inputs states
 void UpdateInputsData(void)
 {
     if (IsKeyPressed('H')) help = !help;
+    else if (IsKeyPressed('B') && !overUI) BakeTexture();
+    else if (IsKeyPressed('M') && !overUI) EvaluateMesh();
+    else if (IsKeyPressed('V') && !overUI)
+    {
+        hoistVertex = !hoistVertex;
+        TraceLogFNode(false, "vertex stage hoisting %s, compile shader again to apply it", (hoistVertex ? "enabled" : "disabled"));
+    }
     else if (IsKeyPressed(KEY_RIGHT_ALT) && drawVisor)
     {
         fullVisor = !fullVisor;
         UnloadRenderTexture(visorTarget);
-        visorTarget = LoadRenderTexture((fullVisor ? screenSize.x : (screenSize.x/4)), (fullVisor ? screenSize.y : (screenSize.y/4)));
+        visorTarget = LoadRenderTexture((fullVisor ? context->screenSize.x : (context->screenSize.x/4)), (fullVisor ? context->screenSize.y : (context->screenSize.y/4)));
     }
 
     // Update canvas camera values
-    camera.target = mousePosition;
+    context->camera.target = mousePosition;
 }
 
 // Updates mouse scrolling for menu and canvas drag
@@ -569,22 +413,22 @@ void UpdateScroll(void)
     // Check zoom input
     if (GetMouseWheelMove() != 0)
     {
-        if (CheckCollisionPointRec(mousePosition, (Rectangle){ canvasSize.x - visorTarget.texture.width - UI_PADDING, screenSize.y - visorTarget.texture.height - UI_PADDING, visorTarget.texture.width, visorTarget.texture.height }))
-            UpdateCamera(&camera3d);
+        if (CheckCollisionPointRec(mousePosition, (Rectangle){ canvasSize.x - visorTarget.texture.width - UI_PADDING, context->screenSize.y - visorTarget.texture.height - UI_PADDING, visorTarget.texture.width, visorTarget.texture.height }))
+            UpdateCamera(&context->camera3d);
         else if (CheckCollisionPointRec(mousePosition, (Rectangle){ 0, 0, canvasSize.x, canvasSize.y }))
         {
-            if (IsKeyDown(KEY_LEFT_ALT)) camera.offset.x -= GetMouseWheelMove()*UI_SCROLL;
-            else camera.offset.y -= GetMouseWheelMove()*UI_SCROLL;
+            if (IsKeyDown(KEY_LEFT_ALT)) context->camera.offset.x -= GetMouseWheelMove()*UI_SCROLL;
+            else context->camera.offset.y -= GetMouseWheelMove()*UI_SCROLL;
         }
         else
         {
             menuScroll -= GetMouseWheelMove()*UI_SCROLL;
             menuScroll = FClamp(menuScroll, menuScrollLimits.x, menuScrollLimits.y);
-            menuScrollRec.y = menuScroll/HEIGHT_SCROLL_AREA*(screenSize.y - menuScrollRec.height);
+            menuScrollRec.y = menuScroll/HEIGHT_SCROLL_AREA*(context->screenSize.y - menuScrollRec.height);
         }
     }
-    else if (CheckCollisionPointRec(mousePosition, (Rectangle){ canvasSize.x - visorTarget.texture.width - UI_PADDING, screenSize.y - visorTarget.texture.height - UI_PADDING, visorTarget.texture.width, visorTarget.texture.height }))
-        UpdateCamera(&camera3d);
+    else if (CheckCollisionPointRec(mousePosition, (Rectangle){ canvasSize.x - visorTarget.texture.width - UI_PADDING, context->screenSize.y - visorTarget.texture.height - UI_PADDING, visorTarget.texture.width, visorTarget.texture.height }))
+        UpdateCamera(&context->camera3d);
 
     // Check mouse drag interface scrolling input
     if (scrollState == 0)
@@ -605,7 +449,7 @@ void UpdateScroll(void)
         }
 
         menuScroll = FClamp(menuScroll, menuScrollLimits.x, menuScrollLimits.y);
-        menuScrollRec.y = menuScroll/HEIGHT_SCROLL_AREA*(screenSize.y - menuScrollRec.height);
+        menuScrollRec.y = menuScroll/HEIGHT_SCROLL_AREA*(context->screenSize.y - menuScrollRec.height);
 
         if (IsMouseButtonUp(MOUSE_LEFT_BUTTON)) scrollState = 0;
     }
@@ -618,13 +462,13 @@ void UpdateNodesEdit(void)
     {
         int index = -1;
         int data = -1;
-        for (int i = 0; i < nodesCount; i++)
+        for (int i = 0; i < context->nodesCount; i++)
         {
-            if ((nodes[i]->type >= FNODE_MATRIX) && (nodes[i]->type <= FNODE_VECTOR4))
+            if ((context->nodes[i]->type >= FNODE_MATRIX) && (context->nodes[i]->type <= FNODE_VECTOR4))
             {
-                for (int k = 0; k < nodes[i]->output.dataCount; k++)
+                for (int k = 0; k < context->nodes[i]->output.dataCount; k++)
                 {
-                    if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->output.data[k].shape, camera)))
+                    if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodes[i]->outputView.shapes[k], context->camera)))
                     {
                         index = i;
                         data = k;
@@ -636,48 +480,48 @@ void UpdateNodesEdit(void)
 
         if (index != -1)
         {
-            if ((editNode == -1) && (selectedNode == -1) && (lineState == 0) && (commentState == 0) && (selectedComment == -1) && (editSize == -1) && (editSizeType == -1) && (editComment == -1))
+            if ((context->editNode == -1) && (context->selectedNode == -1) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedComment == -1) && (context->editSize == -1) && (context->editSizeType == -1) && (context->editComment == -1))
             {
-                editNode = nodes[index]->id;
-                editNodeType = data;
-                editNodeText = (char *)FNODE_MALLOC(MAX_NODE_LENGTH);
-                usedMemory += MAX_NODE_LENGTH;
-                for (int i = 0; i < MAX_NODE_LENGTH; i++) editNodeText[i] = nodes[index]->output.data[data].valueText[i];
+                context->editNode = context->nodes[index]->id;
+                context->editNodeType = data;
+                context->editNodeText = (char *)FNODE_MALLOC(MAX_NODE_LENGTH);
+                context->usedMemory += MAX_NODE_LENGTH;
+                for (int i = 0; i < MAX_NODE_LENGTH; i++) context->editNodeText[i] = context->nodes[index]->outputView.texts[data][i];
             }
-            else if ((editNode != -1) && (selectedNode == -1) && (lineState == 0) && (commentState == 0) && (selectedComment == -1) && (editSize == -1) && (editSizeType == -1) && (editComment == -1))
+            else if ((context->editNode != -1) && (context->selectedNode == -1) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedComment == -1) && (context->editSize == -1) && (context->editSizeType == -1) && (context->editComment == -1))
             {
-                if ((nodes[index]->id != editNode) || (data != editNodeType))
+                if ((context->nodes[index]->id != context->editNode) || (data != context->editNodeType))
                 {
-                    for (int i = 0; i < nodesCount; i++)
+                    for (int i = 0; i < context->nodesCount; i++)
                     {
-                        if (nodes[i]->id == editNode)
+                        if (context->nodes[i]->id == context->editNode)
                         {
-                            for (int k = 0; k < MAX_NODE_LENGTH; k++) nodes[i]->output.data[editNodeType].valueText[k] = editNodeText[k];
+                            for (int k = 0; k < MAX_NODE_LENGTH; k++) context->nodes[i]->outputView.texts[context->editNodeType][k] = context->editNodeText[k];
                         }
                     }
 
-                    editNode = nodes[index]->id;
-                    editNodeType = data;
+                    context->editNode = context->nodes[index]->id;
+                    context->editNodeType = data;
 
-                    for (int i = 0; i < MAX_NODE_LENGTH; i++) editNodeText[i] = nodes[index]->output.data[data].valueText[i];
+                    for (int i = 0; i < MAX_NODE_LENGTH; i++) context->editNodeText[i] = context->nodes[index]->outputView.texts[data][i];
                 }
             }
         }
-        else if ((editNode != -1) && (editNodeType != -1))
+        else if ((context->editNode != -1) && (context->editNodeType != -1))
         {
-            for (int i = 0; i < nodesCount; i++)
+            for (int i = 0; i < context->nodesCount; i++)
             {
-                if (nodes[i]->id == editNode)
+                if (context->nodes[i]->id == context->editNode)
                 {
-                    for (int k = 0; k < MAX_NODE_LENGTH; k++) nodes[i]->output.data[editNodeType].valueText[k] = editNodeText[k];
+                    for (int k = 0; k < MAX_NODE_LENGTH; k++) context->nodes[i]->outputView.texts[context->editNodeType][k] = context->editNodeText[k];
                 }
             }
 
-            editNode = -1;
-            editNodeType = -1;
-            FNODE_FREE(editNodeText);
-            usedMemory -= MAX_NODE_LENGTH;
-            editNodeText = NULL;
+            context->editNode = -1;
+            context->editNodeType = -1;
+            FNODE_FREE(context->editNodeText);
+            context->usedMemory -= MAX_NODE_LENGTH;
+            context->editNodeText = NULL;
         }     
     }
 }
@@ -685,105 +529,92 @@ void UpdateNodesEdit(void)
 // Check node drag input
 void UpdateNodesDrag(void)
 {
-    if ((selectedNode == -1) && (lineState == 0) && (commentState == 0) && (selectedComment == -1))
+    if ((context->selectedNode == -1) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedComment == -1))
     {
         if (IsMouseButtonDown(MOUSE_LEFT_BUTTON))
         {
-            for (int i = nodesCount - 1; i >= 0; i--)
+            for (int i = context->nodesCount - 1; i >= 0; i--)
             {
-                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->shape, camera)))
+                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodes[i]->shape, context->camera)))
                 {
-                    selectedNode = nodes[i]->id;
-                    currentOffset = (Vector2){ mousePosition.x - nodes[i]->shape.x, mousePosition.y - nodes[i]->shape.y };
+                    context->selectedNode = context->nodes[i]->id;
+                    currentOffset = (Vector2){ mousePosition.x - context->nodes[i]->shape.x, mousePosition.y - context->nodes[i]->shape.y };
                     break;
                 }
             }
 
-            if ((selectedNode == -1) && (scrollState == 0) && (!CheckCollisionPointRec(mousePosition, (Rectangle){ canvasSize.x, 0, (screenSize.x - canvasSize.x), screenSize.y })))
+            if ((context->selectedNode == -1) && (scrollState == 0) && (!CheckCollisionPointRec(mousePosition, (Rectangle){ canvasSize.x, 0, (context->screenSize.x - canvasSize.x), context->screenSize.y })))
             {
-                camera.offset.x += mouseDelta.x;
-                camera.offset.y += mouseDelta.y;
+                context->camera.offset.x += mouseDelta.x;
+                context->camera.offset.y += mouseDelta.y;
             }
         }
         else if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON))
         {
-            for (int i = nodesCount - 1; i >= 0; i--)
+            for (int i = context->nodesCount - 1; i >= 0; i--)
             {
-                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->shape, camera)) && (nodes[i]->type < FNODE_VERTEX))
+                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodes[i]->shape, context->camera)) && (context->nodes[i]->type < FNODE_VERTEX))
                 {
-                    DestroyNode(nodes[i]);
-                    CalculateValues();
+                    DestroyNode(context, context->nodes[i]);
                     break;
                 }
             }
         }
     }
-    else if ((selectedNode != -1) && (lineState == 0) && (commentState == 0) && (selectedComment == -1))
+    else if ((context->selectedNode != -1) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedComment == -1))
     {
-        for (int i = 0; i < nodesCount; i++)
+        for (int i = 0; i < context->nodesCount; i++)
         {
-            if (nodes[i]->id == selectedNode)
+            if (context->nodes[i]->id == context->selectedNode)
             {
-                nodes[i]->shape.x = mousePosition.x - currentOffset.x;
-                nodes[i]->shape.y = mousePosition.y - currentOffset.y;
+                context->nodes[i]->shape.x = mousePosition.x - currentOffset.x;
+                context->nodes[i]->shape.y = mousePosition.y - currentOffset.y;
 
                 // Check aligned drag movement input
-                if (IsKeyDown(KEY_LEFT_ALT)) AlignNode(nodes[i]);
+                if (IsKeyDown(KEY_LEFT_ALT)) AlignNode(context->nodes[i]);
 
-                UpdateNodeShapes(nodes[i]);
+                UpdateNodeShapes(context->nodes[i]);
                 break;
             }
         }
 
-        if (IsMouseButtonUp(MOUSE_LEFT_BUTTON)) selectedNode = -1;
+        if (IsMouseButtonUp(MOUSE_LEFT_BUTTON)) context->selectedNode = -1;
     }
 }
 
 // Check node link input
 void UpdateNodesLink(void)
 {
-    if ((selectedNode == -1) && (commentState == 0) && (selectedComment == -1)) 
+    if ((context->selectedNode == -1) && (context->commentState == 0) && (context->selectedComment == -1)) 
     {
-        switch (lineState)
+        switch (context->lineState)
         {
             case 0:
             {
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
                 {
-                    for (int i = nodesCount - 1; i >= 0; i--)
+                    for (int i = context->nodesCount - 1; i >= 0; i--)
                     {
-                        if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->outputShape, camera)))
+                        if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodes[i]->outputShape, context->camera)))
                         {
-                            tempLine = CreateNodeLine(nodes[i]->id);
-                            lineState = 1;
+                            context->tempLine = CreateNodeLine(context, context->nodes[i]->id, -1);
+                            context->lineState = 1;
                             break;
                         }
                     }
                 }
                 else if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON) && !IsKeyDown(KEY_LEFT_ALT))
                 {
-                    for (int i = nodesCount - 1; i >= 0; i--)
+                    for (int i = context->nodesCount - 1; i >= 0; i--)
                     {
-                        if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->outputShape, camera)))
+                        if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodes[i]->outputShape, context->camera)))
                         {
-                            for (int k = linesCount - 1; k >= 0; k--)
-                            {
-                                if (nodes[i]->id == lines[k]->from) DestroyNodeLine(lines[k]);
-                            }
-
-                            CalculateValues();
-                            CalculateValues();
+                            DestroyNodeLinks(context, context->nodes[i], false, true);
                             break;
                         }
-                        else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->inputShape, camera)))
+                        else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodes[i]->inputShape, context->camera)))
                         {
-                            for (int k = linesCount - 1; k >= 0; k--)
-                            {
-                                if (nodes[i]->id == lines[k]->to) DestroyNodeLine(lines[k]);
-                            }
-
-                            CalculateValues();
-                            CalculateValues();
+                            DestroyNodeLinks(context, context->nodes[i], true, false);
                             break;
                         }
                     }
@@ -793,93 +624,96 @@ void UpdateNodesLink(void)
             {
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
                 {
-                    for (int i = 0; i < nodesCount; i++)
+                    for (int i = 0; i < context->nodesCount; i++)
                     {
-                        if (CheckCollisionPointRec(mousePosition, CameraToViewRec(nodes[i]->inputShape, camera)) && (nodes[i]->id != tempLine->from) && (nodes[i]->inputsCount < nodes[i]->inputsLimit))
+                        if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->nodes[i]->inputShape, context->camera)) && (context->nodes[i]->id != context->tempLine->from) && (context->nodes[i]->inputsCount < context->nodes[i]->inputsLimit))
                         {
                             // Get which index has the first input node id from current nude                            
-                            int indexFrom = GetNodeIndex(tempLine->from);
+                            int indexFrom = GetNodeIndex(context, context->tempLine->from);
 
                             bool valuesCheck = true;
-                            if (nodes[i]->type == FNODE_SAMPLER2D) valuesCheck = (nodes[indexFrom]->output.dataCount == 1);
-                            else if (nodes[i]->type == FNODE_LERP) valuesCheck = (nodes[i]->inputsCount <= nodes[i]->inputsLimit);
-                            else if (nodes[i]->type == FNODE_APPEND) valuesCheck = ((nodes[i]->output.dataCount + nodes[indexFrom]->output.dataCount <= 4) && (nodes[indexFrom]->output.dataCount == 1));
-                            else if (nodes[i]->type == FNODE_VERTEXCOLOR) valuesCheck = (nodes[indexFrom]->output.dataCount == 1);
-                            else if ((nodes[i]->type == FNODE_POWER) && (nodes[i]->inputsCount == 1)) valuesCheck = (nodes[indexFrom]->output.dataCount == 1);
-                            else if (nodes[i]->type == FNODE_STEP) valuesCheck = (nodes[indexFrom]->output.dataCount == 1);
-                            else if (nodes[i]->type == FNODE_NORMALIZE) valuesCheck = ((nodes[indexFrom]->output.dataCount > 1) && (nodes[indexFrom]->output.dataCount <= 4));
-                            else if (nodes[i]->type == FNODE_CROSSPRODUCT) valuesCheck = (nodes[indexFrom]->output.dataCount == 3);
-                            else if (nodes[i]->type == FNODE_DESATURATE)
+                            if (context->nodes[i]->type == FNODE_SAMPLER2D) valuesCheck = (context->nodes[indexFrom]->output.dataCount == 1);
+                            else if (context->nodes[i]->type == FNODE_LERP) valuesCheck = (context->nodes[i]->inputsCount <= context->nodes[i]->inputsLimit);
+                            else if (context->nodes[i]->type == FNODE_APPEND) valuesCheck = ((context->nodes[i]->output.dataCount + context->nodes[indexFrom]->output.dataCount <= 4) && (context->nodes[indexFrom]->output.dataCount == 1));
+                            else if (context->nodes[i]->type == FNODE_VERTEXCOLOR) valuesCheck = (context->nodes[indexFrom]->output.dataCount == 1);
+                            else if ((context->nodes[i]->type == FNODE_POWER) && (context->nodes[i]->inputsCount == 1)) valuesCheck = (context->nodes[indexFrom]->output.dataCount == 1);
+                            else if (context->nodes[i]->type == FNODE_STEP) valuesCheck = (context->nodes[indexFrom]->output.dataCount == 1);
+                            else if (context->nodes[i]->type == FNODE_NORMALIZE) valuesCheck = ((context->nodes[indexFrom]->output.dataCount > 1) && (context->nodes[indexFrom]->output.dataCount <= 4));
+                            else if (context->nodes[i]->type == FNODE_CROSSPRODUCT) valuesCheck = (context->nodes[indexFrom]->output.dataCount == 3);
+                            else if (context->nodes[i]->type == FNODE_DESATURATE)
                             {
-                                if (nodes[i]->inputsCount == 0) valuesCheck = (nodes[indexFrom]->output.dataCount < 4);
-                                else if (nodes[i]->inputsCount == 1) valuesCheck = (nodes[indexFrom]->output.dataCount == 1);
+                                if (context->nodes[i]->inputsCount == 0) valuesCheck = (context->nodes[indexFrom]->output.dataCount < 4);
+                                else if (context->nodes[i]->inputsCount == 1) valuesCheck = (context->nodes[indexFrom]->output.dataCount == 1);
                             }
-                            else if ((nodes[i]->type == FNODE_DOTPRODUCT) || (nodes[i]->type == FNODE_LENGTH) || ((nodes[i]->type >= FNODE_PROJECTION) && (nodes[i]->type <= FNODE_HALFDIRECTION)))
+                            else if ((context->nodes[i]->type == FNODE_DOTPRODUCT) || (context->nodes[i]->type == FNODE_LENGTH) || ((context->nodes[i]->type >= FNODE_PROJECTION) && (context->nodes[i]->type <= FNODE_HALFDIRECTION)))
                             {
-                                valuesCheck = ((nodes[indexFrom]->output.dataCount > 1) && (nodes[indexFrom]->output.dataCount <= 4));
+                                valuesCheck = ((context->nodes[indexFrom]->output.dataCount > 1) && (context->nodes[indexFrom]->output.dataCount <= 4));
 
-                                if (valuesCheck && (nodes[i]->inputsCount > 0))
+                                if (valuesCheck && (context->nodes[i]->inputsCount > 0))
                                 {
-                                    int index = GetNodeIndex(nodes[i]->inputs[0]);
+                                    int index = GetNodeIndex(context, context->nodes[i]->inputs[0]);
                                     
-                                    if (index != -1) valuesCheck = (nodes[indexFrom]->output.dataCount == nodes[index]->output.dataCount);
+                                    if (index != -1) valuesCheck = (context->nodes[indexFrom]->output.dataCount == context->nodes[index]->output.dataCount);
                                     else TraceLogFNode(true, "error when trying to get node inputs index");
                                 }
                             }
-                            else if (nodes[i]->type == FNODE_DISTANCE)
+                            else if (context->nodes[i]->type == FNODE_DISTANCE)
                             {
-                                valuesCheck = ((nodes[indexFrom]->output.dataCount <= 4));
+                                valuesCheck = ((context->nodes[indexFrom]->output.dataCount <= 4));
 
-                                if (valuesCheck && (nodes[i]->inputsCount > 0))
+                                if (valuesCheck && (context->nodes[i]->inputsCount > 0))
                                 {
-                                    int index = GetNodeIndex(nodes[i]->inputs[0]);
+                                    int index = GetNodeIndex(context, context->nodes[i]->inputs[0]);
                                     
-                                    if (index != -1) valuesCheck = (nodes[indexFrom]->output.dataCount == nodes[index]->output.dataCount);
+                                    if (index != -1) valuesCheck = (context->nodes[indexFrom]->output.dataCount == context->nodes[index]->output.dataCount);
                                     else TraceLogFNode(true, "error when trying to get node inputs index");
                                 }
                             }
-                            else if ((nodes[i]->type == FNODE_MULTIPLYMATRIX) || (nodes[i]->type == FNODE_TRANSPOSE)) valuesCheck = (nodes[indexFrom]->output.dataCount == 16);
-                            else if (nodes[i]->type >= FNODE_VERTEX) valuesCheck = (nodes[indexFrom]->output.dataCount <= nodes[i]->output.dataCount);
-                            else if (nodes[i]->type > FNODE_DIVIDE) valuesCheck = (nodes[i]->output.dataCount == nodes[indexFrom]->output.dataCount);
-
-                            if (((nodes[i]->inputsCount == 0) && (nodes[i]->type != FNODE_NORMALIZE) && (nodes[i]->type != FNODE_DOTPRODUCT) && 
-                            (nodes[i]->type != FNODE_LENGTH) && (nodes[i]->type != FNODE_MULTIPLYMATRIX) && (nodes[i]->type != FNODE_TRANSPOSE) && (nodes[i]->type != FNODE_PROJECTION) &&
-                            (nodes[i]->type != FNODE_DISTANCE) && (nodes[i]->type != FNODE_REJECTION) && (nodes[i]->type != FNODE_HALFDIRECTION) && (nodes[i]->type != FNODE_STEP) &&
-                            (nodes[i]->type != FNODE_LERP) && (nodes[i]->type != FNODE_SAMPLER2D)) || valuesCheck)
+                            else if ((context->nodes[i]->type == FNODE_MULTIPLYMATRIX) || (context->nodes[i]->type == FNODE_TRANSPOSE)) valuesCheck = (context->nodes[indexFrom]->output.dataCount == 16);
+                            else if (context->nodes[i]->type >= FNODE_VERTEX) valuesCheck = (context->nodes[indexFrom]->output.dataCount <= context->nodes[i]->output.dataCount);
+                            else if (context->nodes[i]->type > FNODE_DIVIDE) valuesCheck = (context->nodes[i]->output.dataCount == context->nodes[indexFrom]->output.dataCount);
+
+                            if (((context->nodes[i]->inputsCount == 0) && (context->nodes[i]->type != FNODE_NORMALIZE) && (context->nodes[i]->type != FNODE_DOTPRODUCT) && 
+                            (context->nodes[i]->type != FNODE_LENGTH) && (context->nodes[i]->type != FNODE_MULTIPLYMATRIX) && (context->nodes[i]->type != FNODE_TRANSPOSE) && (context->nodes[i]->type != FNODE_PROJECTION) &&
+                            (context->nodes[i]->type != FNODE_DISTANCE) && (context->nodes[i]->type != FNODE_REJECTION) && (context->nodes[i]->type != FNODE_HALFDIRECTION) && (context->nodes[i]->type != FNODE_STEP) &&
+                            (context->nodes[i]->type != FNODE_LERP) && (context->nodes[i]->type != FNODE_SAMPLER2D)) || valuesCheck)
                             {
-                                // Check if there is already a line created with same linking ids
-                                for (int k = 0; k < linesCount; k++)
+                                // Save temporal line values and destroy it
+                                int from = context->tempLine->from;
+                                int to = context->nodes[i]->id;
+                                DestroyNodeLine(context, context->tempLine);
+
+                                // Reset linking state values
+                                context->lineState = 0;
+
+                                // Discard the new line if it makes a node depend on its own output
+                                if (IsNodeReachable(context, to, from)) TraceLogFNode(false, "error trying to link node ID %i with node ID %i because it creates a cycle", from, to);
+                                else
                                 {
-                                    if ((lines[k]->to == nodes[i]->id) && (lines[k]->from == tempLine->from))
+                                    // Check if there is already a line created with same linking ids
+                                    for (int k = 0; k < context->nodes[i]->inputsCount; k++)
                                     {
-                                        DestroyNodeLine(lines[k]);
-                                        break;
+                                        if (context->nodes[i]->inputs[k] == from)
+                                        {
+                                            DestroyNodeLine(context, context->nodes[i]->inputLines[k]);
+                                            break;
+                                        }
                                     }
-                                }
 
-                                // Save temporal line values and destroy it
-                                int from = tempLine->from;
-                                int to = nodes[i]->id;
-                                DestroyNodeLine(tempLine);
-
-                                // Create final node line
-                                FLine temp = CreateNodeLine(from);
-                                temp->to = to;
-
-                                // Reset linking state values
-                                lineState = 0;
-                                CalculateValues();
-                                CalculateValues();
+                                    // Create final node line
+                                    CreateNodeLine(context, from, to);
+                                    CalculateValues(context);
+                                }
                                 break;
                             }
-                            else TraceLogFNode(false, "error trying to link node ID %i (length: %i) with node ID %i (length: %i)", nodes[i]->id, nodes[i]->output.dataCount, nodes[indexFrom]->id, nodes[indexFrom]->output.dataCount);
+                            else TraceLogFNode(false, "error trying to link node ID %i (length: %i) with node ID %i (length: %i)", context->nodes[i]->id, context->nodes[i]->output.dataCount, context->nodes[indexFrom]->id, context->nodes[indexFrom]->output.dataCount);
                         }
                     }
                 }
                 else if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON))
                 {
-                    DestroyNodeLine(tempLine);
-                    lineState = 0;
+                    DestroyNodeLine(context, context->tempLine);
+                    context->lineState = 0;
                 }
             } break;
             default: break;
@@ -890,9 +724,9 @@ void UpdateNodesLink(void)
 // Check comment creation input
 void UpdateCommentCreationEdit(void)
 {
-    if ((selectedNode == -1) && (lineState == 0) && (selectedComment == -1)) 
+    if ((context->selectedNode == -1) && (context->lineState == 0) && (context->selectedComment == -1)) 
     {
-        switch (commentState)
+        switch (context->commentState)
         {
             case 0:
             {
@@ -900,75 +734,75 @@ void UpdateCommentCreationEdit(void)
                 {
                     if (IsKeyDown(KEY_LEFT_ALT))
                     {
-                        commentState = 1;
+                        context->commentState = 1;
 
-                        tempCommentPos.x = mousePosition.x;
-                        tempCommentPos.y = mousePosition.y;
+                        context->tempCommentPos.x = mousePosition.x;
+                        context->tempCommentPos.y = mousePosition.y;
 
-                        tempComment = CreateComment();
-                        tempComment->shape.x = mousePosition.x - camera.offset.x;
-                        tempComment->shape.y = mousePosition.y - camera.offset.y;
+                        context->tempComment = CreateComment(context);
+                        context->tempComment->shape.x = mousePosition.x - context->camera.offset.x;
+                        context->tempComment->shape.y = mousePosition.y - context->camera.offset.y;
 
-                        UpdateCommentShapes(tempComment);
+                        UpdateCommentShapes(context, context->tempComment);
                     }
                     else
                     {
-                        for (int i = 0; i < commentsCount; i++)
+                        for (int i = 0; i < context->commentsCount; i++)
                         {
-                            if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeTShape, camera)))
+                            if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeTShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 0;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 0;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeBShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeBShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 1;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 1;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeLShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeLShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 2;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 2;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeRShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeRShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 3;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 3;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeTlShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeTlShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 4;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 4;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeTrShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeTrShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 5;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 5;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeBlShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeBlShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 6;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 6;
                                 break;
                             }
-                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->sizeBrShape, camera)))
+                            else if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->sizeBrShape, context->camera)))
                             {
-                                editSize = comments[i]->id;
-                                commentState = 1;
-                                editSizeType = 7;
+                                context->editSize = context->comments[i]->id;
+                                context->commentState = 1;
+                                context->editSizeType = 7;
                                 break;
                             }
                         }
@@ -977,99 +811,99 @@ void UpdateCommentCreationEdit(void)
             } break;
             case 1:
             {
-                if (editSize != -1)
+                if (context->editSize != -1)
                 {
-                    for (int i = 0; i < commentsCount; i++)
+                    for (int i = 0; i < context->commentsCount; i++)
                     {
-                        if (comments[i]->id == editSize)
+                        if (context->comments[i]->id == context->editSize)
                         {
-                            switch (editSizeType)
+                            switch (context->editSizeType)
                             {
                                 case 0:
                                 {
-                                    comments[i]->shape.y += mouseDelta.y;
-                                    comments[i]->shape.height -= mouseDelta.y;
+                                    context->comments[i]->shape.y += mouseDelta.y;
+                                    context->comments[i]->shape.height -= mouseDelta.y;
                                 } break;
-                                case 1: comments[i]->shape.height += mouseDelta.y; break;
+                                case 1: context->comments[i]->shape.height += mouseDelta.y; break;
                                 case 2:
                                 {
-                                    comments[i]->shape.x += mouseDelta.x;
-                                    comments[i]->shape.width -= mouseDelta.x;
+                                    context->comments[i]->shape.x += mouseDelta.x;
+                                    context->comments[i]->shape.width -= mouseDelta.x;
                                 } break;
-                                case 3: comments[i]->shape.width += mouseDelta.x; break;
+                                case 3: context->comments[i]->shape.width += mouseDelta.x; break;
                                 case 4:
                                 {
-                                    comments[i]->shape.x += mouseDelta.x;
-                                    comments[i]->shape.width -= mouseDelta.x;
-                                    comments[i]->shape.y += mouseDelta.y;
-                                    comments[i]->shape.height -= mouseDelta.y;
+                                    context->comments[i]->shape.x += mouseDelta.x;
+                                    context->comments[i]->shape.width -= mouseDelta.x;
+                                    context->comments[i]->shape.y += mouseDelta.y;
+                                    context->comments[i]->shape.height -= mouseDelta.y;
                                 } break;
                                 case 5:
                                 {
-                                    comments[i]->shape.width += mouseDelta.x;
-                                    comments[i]->shape.y += mouseDelta.y;
-                                    comments[i]->shape.height -= mouseDelta.y;
+                                    context->comments[i]->shape.width += mouseDelta.x;
+                                    context->comments[i]->shape.y += mouseDelta.y;
+                                    context->comments[i]->shape.height -= mouseDelta.y;
                                 } break;
                                 case 6:
                                 {
-                                    comments[i]->shape.x += mouseDelta.x;
-                                    comments[i]->shape.width -= mouseDelta.x;
-                                    comments[i]->shape.height += mouseDelta.y;
+                                    context->comments[i]->shape.x += mouseDelta.x;
+                                    context->comments[i]->shape.width -= mouseDelta.x;
+                                    context->comments[i]->shape.height += mouseDelta.y;
                                 } break;
                                 case 7:
                                 {
-                                    comments[i]->shape.width += mouseDelta.x;
-                                    comments[i]->shape.height += mouseDelta.y;
+                                    context->comments[i]->shape.width += mouseDelta.x;
+                                    context->comments[i]->shape.height += mouseDelta.y;
                                 } break;
                                 default: break;
                             }
 
-                            UpdateCommentShapes(comments[i]);
+                            UpdateCommentShapes(context, context->comments[i]);
                             break;
                         }
                     }
 
                     if (IsMouseButtonUp(MOUSE_LEFT_BUTTON))
                     {
-                        editSize = -1;
-                        editSizeType = -1;
-                        commentState = 0;
+                        context->editSize = -1;
+                        context->editSizeType = -1;
+                        context->commentState = 0;
                     }
                 }
                 else
                 {
-                    if ((mousePosition.x - tempCommentPos.x) >= 0) tempComment->shape.width = mousePosition.x - tempComment->shape.x - camera.offset.x;
+                    if ((mousePosition.x - context->tempCommentPos.x) >= 0) context->tempComment->shape.width = mousePosition.x - context->tempComment->shape.x - context->camera.offset.x;
                     else
                     {
-                        tempComment->shape.width = tempCommentPos.x - mousePosition.x;
-                        tempComment->shape.x = tempCommentPos.x - tempComment->shape.width - camera.offset.x;
+                        context->tempComment->shape.width = context->tempCommentPos.x - mousePosition.x;
+                        context->tempComment->shape.x = context->tempCommentPos.x - context->tempComment->shape.width - context->camera.offset.x;
                     }
 
-                    if ((mousePosition.y - tempCommentPos.y) >= 0) tempComment->shape.height = mousePosition.y - tempComment->shape.y - camera.offset.y;
+                    if ((mousePosition.y - context->tempCommentPos.y) >= 0) context->tempComment->shape.height = mousePosition.y - context->tempComment->shape.y - context->camera.offset.y;
                     else
                     {
-                        tempComment->shape.height = tempCommentPos.y - mousePosition.y;
-                        tempComment->shape.y = tempCommentPos.y - tempComment->shape.height - camera.offset.y;
+                        context->tempComment->shape.height = context->tempCommentPos.y - mousePosition.y;
+                        context->tempComment->shape.y = context->tempCommentPos.y - context->tempComment->shape.height - context->camera.offset.y;
                     }
 
-                    UpdateCommentShapes(tempComment);
+                    UpdateCommentShapes(context, context->tempComment);
 
                     if (IsMouseButtonUp(MOUSE_LEFT_BUTTON))
                     {
                         // Save temporal comment values
-                        Rectangle tempRec = { tempComment->shape.x, tempComment->shape.y, tempComment->shape.width, tempComment->shape.height };
-                        DestroyComment(tempComment);
+                        Rectangle tempRec = { context->tempComment->shape.x, context->tempComment->shape.y, context->tempComment->shape.width, context->tempComment->shape.height };
+                        DestroyComment(context, context->tempComment);
 
                         // Reset comment state
-                        commentState = 0;
+                        context->commentState = 0;
 
                         if (tempRec.width >= 0 && tempRec.height >= 0)
                         {
                             // Create final comment
-                            FComment temp = CreateComment();
+                            FComment temp = CreateComment(context);
                             temp->shape = tempRec;
 
-                            UpdateCommentShapes(temp);
+                            UpdateCommentShapes(context, temp);
                         }
                         else TraceLogFNode(false, "comment have not been created because its width or height are has a negative value");
                     }
@@ -1083,27 +917,25 @@ void UpdateCommentCreationEdit(void)
 // Check comment drag input
 void UpdateCommentsDrag(void)
 {
-    if ((selectedComment == -1) && (lineState == 0) && (commentState == 0) && (selectedNode == -1))
+    if ((context->selectedComment == -1) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedNode == -1))
     {
         if (!IsKeyDown(KEY_LEFT_ALT))
         {
             if (IsMouseButtonDown(MOUSE_LEFT_BUTTON))
             {
-                for (int i = commentsCount - 1; i >= 0; i--)
+                for (int i = context->commentsCount - 1; i >= 0; i--)
                 {
-                    if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->shape, camera)))
+                    if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->shape, context->camera)))
                     {
-                        selectedComment = comments[i]->id;
-                        currentOffset = (Vector2){ mousePosition.x - comments[i]->shape.x, mousePosition.y - comments[i]->shape.y };
+                        context->selectedComment = context->comments[i]->id;
+                        currentOffset = (Vector2){ mousePosition.x - context->comments[i]->shape.x, mousePosition.y - context->comments[i]->shape.y };
 
-                        for (int k = 0; k < nodesCount; k++)
+                        for (int k = 0; k < context->nodesCount; k++)
                         {
-                            if (CheckCollisionRecs(CameraToViewRec(comments[i]->shape, camera), CameraToViewRec(nodes[k]->shape, camera)))
+                            if (CheckCollisionRecs(CameraToViewRec(context->comments[i]->shape, context->camera), CameraToViewRec(context->nodes[k]->shape, context->camera)))
                             {
-                                selectedCommentNodes[selectedCommentNodesCount] = nodes[k]->id;
-                                selectedCommentNodesCount++;
-
-                                if (selectedCommentNodesCount > MAX_NODES) break;
+                                context->selectedCommentNodes[context->selectedCommentNodesCount] = context->nodes[k]->id;
+                                context->selectedCommentNodesCount++;
                             }
                         }
 
@@ -1114,37 +946,37 @@ void UpdateCommentsDrag(void)
         }
         else if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON))
         {
-            for (int i = commentsCount - 1; i >= 0; i--)
+            for (int i = context->commentsCount - 1; i >= 0; i--)
             {
-                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->shape, camera)))
+                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->shape, context->camera)))
                 {
-                    DestroyComment(comments[i]);
+                    DestroyComment(context, context->comments[i]);
                     break;
                 }
             }
         }
     }
-    else if ((selectedComment != -1) && (lineState == 0) && (commentState == 0) && (selectedNode == -1))
+    else if ((context->selectedComment != -1) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedNode == -1))
     {
-        for (int i = 0; i < commentsCount; i++)
+        for (int i = 0; i < context->commentsCount; i++)
         {
-            if (comments[i]->id == selectedComment)
+            if (context->comments[i]->id == context->selectedComment)
             {
-                comments[i]->shape.x = mousePosition.x - currentOffset.x;
-                comments[i]->shape.y = mousePosition.y - currentOffset.y;
+                context->comments[i]->shape.x = mousePosition.x - currentOffset.x;
+                context->comments[i]->shape.y = mousePosition.y - currentOffset.y;
 
-                UpdateCommentShapes(comments[i]);
+                UpdateCommentShapes(context, context->comments[i]);
 
-                for (int k = 0; k < selectedCommentNodesCount; k++)
+                for (int k = 0; k < context->selectedCommentNodesCount; k++)
                 {
-                    for (int j = 0; j < nodesCount; j++)
+                    for (int j = 0; j < context->nodesCount; j++)
                     {
-                        if (nodes[j]->id == selectedCommentNodes[k])
+                        if (context->nodes[j]->id == context->selectedCommentNodes[k])
                         {
-                            nodes[j]->shape.x += mouseDelta.x;
-                            nodes[j]->shape.y += mouseDelta.y;
+                            context->nodes[j]->shape.x += mouseDelta.x;
+                            context->nodes[j]->shape.y += mouseDelta.y;
 
-                            UpdateNodeShapes(nodes[j]);
+                            UpdateNodeShapes(context->nodes[j]);
                             break;
                         }
                     }
@@ -1155,10 +987,10 @@ void UpdateCommentsDrag(void)
 
         if (IsMouseButtonUp(MOUSE_LEFT_BUTTON))
         {
-            selectedComment = -1;
+            context->selectedComment = -1;
 
-            for (int i = 0; i < selectedCommentNodesCount; i++) selectedCommentNodes[i] = -1;
-            selectedCommentNodesCount = 0;
+            for (int i = 0; i < context->selectedCommentNodesCount; i++) context->selectedCommentNodes[i] = -1;
+            context->selectedCommentNodesCount = 0;
         }
     }
 }
@@ -1168,41 +1000,41 @@ void UpdateCommentsEdit(void)
 {
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
     {
-        if ((editComment == -1) && (selectedNode == -1) && (lineState == 0) && (commentState == 0) && (selectedComment == -1) && (editSize == -1) && (editSizeType == -1) && (editNode == -1))
+        if ((context->editComment == -1) && (context->selectedNode == -1) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedComment == -1) && (context->editSize == -1) && (context->editSizeType == -1) && (context->editNode == -1))
         {
-            for (int i = 0; i < commentsCount; i++)
+            for (int i = 0; i < context->commentsCount; i++)
             {
-                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->valueShape, camera)))
+                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->valueShape, context->camera)))
                 {
-                    editComment = i;
+                    context->editComment = i;
                     break;
                 }
             }
         }
-        else if ((editComment != -1) && (selectedNode == -1) && (lineState == 0) && (commentState == 0) && (selectedComment == -1) && (editSize == -1) && (editSizeType == -1) && (editNode == -1))
+        else if ((context->editComment != -1) && (context->selectedNode == -1) && (context->lineState == 0) && (context->commentState == 0) && (context->selectedComment == -1) && (context->editSize == -1) && (context->editSizeType == -1) && (context->editNode == -1))
         {
             bool isCurrentText = false;
-            int currentEdit = editComment;
-            for (int i = 0; i < commentsCount; i++)
+            int currentEdit = context->editComment;
+            for (int i = 0; i < context->commentsCount; i++)
             {
-                if (comments[i]->id == editComment)
+                if (context->comments[i]->id == context->editComment)
                 {
-                    if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->valueShape, camera)))
+                    if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->valueShape, context->camera)))
                     {
                         isCurrentText = true;
                         break;
                     }
                 }
 
-                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(comments[i]->valueShape, camera)))
+                if (CheckCollisionPointRec(mousePosition, CameraToViewRec(context->comments[i]->valueShape, context->camera)))
                 {
-                    editComment = i;
+                    context->editComment = i;
                     break;
                 }
             }
 
             // Reset current editing text any other text label is pressed
-            if (!isCurrentText && (currentEdit == editComment)) editComment = -1;
+            if (!isCurrentText && (currentEdit == context->editComment)) context->editComment = -1;
         }
     }
 }
@@ -1216,7 +1048,9 @@ void UpdateShaderData(void)
     // Update visor model current rotation
     modelRotation -= VISOR_MODEL_ROTATION;
 
-    if (compileState >= 0)
+    UpdateShaderCompile();
+
+    if ((compileState == 0) || (compileState == 1))
     {
         if (framesCounter - compileFrame >= COMPILE_DURATION)
         {
@@ -1285,7 +1119,7 @@ void UpdateShaderData(void)
         if (viewUniform != -1)
         {
             // Convert view vector to float array and send it to shader
-            Vector3 viewVector = { camera3d.position.x - camera3d.target.x, camera3d.position.y - camera3d.target.y, camera3d.position.z - camera3d.target.z };
+            Vector3 viewVector = { context->camera3d.position.x - context->camera3d.target.x, context->camera3d.position.y - context->camera3d.target.y, context->camera3d.position.z - context->camera3d.target.z };
             viewVector = FVector3Normalize(viewVector);
             float viewDir[3] = {  viewVector.x, viewVector.y, viewVector.z };
             SetShaderValue(shader, viewUniform, viewDir, UNIFORM_VEC3);
@@ -1310,12 +1144,12 @@ void UpdateShaderData(void)
             SetShaderValue(shader, timeUniformF, time, UNIFORM_FLOAT);
         }
 
-        float resolution[2] = { (fullVisor ? screenSize.x : (screenSize.x/4)), (fullVisor ? screenSize.y : (screenSize.y/4)) };
+        float resolution[2] = { (fullVisor ? context->screenSize.x : (context->screenSize.x/4)), (fullVisor ? context->screenSize.y : (context->screenSize.y/4)) };
         SetShaderValue(fxaa, fxaaUniform, resolution, UNIFORM_VEC2);
     }
 }
 
-// Serialize current project data and write to file
+// Serialize current project data and generated shader code and write to files
 void SaveChanges(void)
 {
     // Delete current serialized data file if exists
@@ -1326,729 +1160,704 @@ void SaveChanges(void)
         remove(DATA_PATH);
     }
 
-    // Open shader serialized data file
-    FILE *dataFile = fopen(DATA_PATH, "w");
-    if (dataFile != NULL)
+    if (!SaveGraph(context, DATA_PATH)) TraceLogFNode(false, "error when trying to open and write in data file");
+
+    // Export generated shader code, visor compilation does not require these files
+    FString vertexCode = { 0 };
+    FString fragmentCode = { 0 };
+    GenerateShader(context, version, hoistVertex, &vertexCode, &fragmentCode);
+
+    if (!SaveShaderCode(VERTEX_PATH, &vertexCode)) TraceLogFNode(false, "error when trying to open and write in vertex shader file");
+    if (!SaveShaderCode(FRAGMENT_PATH, &fragmentCode)) TraceLogFNode(false, "error when trying to open and write in fragment shader file");
+
+    UnloadString(&vertexCode);
+    UnloadString(&fragmentCode);
+}
+
+// Compiles all node structure to create the GLSL shader and load it in visor model
+void CompileShader(void)
+{
+    // Visor keeps current shader until the new one is linked, a previous pending compile is discarded
+    CancelShaderCompile();
+
+    compilesCount++;
+
+    // Unchanged or previously compiled graphs reuse their shader program
+    unsigned long long hash = HashGraph();
+
+    int index = FindCachedShader(hash);
+    if (index != -1)
     {
-        // Nodes data reading
-        int count = 0;
-        for (int i = 0; i < MAX_NODES; i++)
-        {
-            for (int k = 0; k < nodesCount; k++)
-            {
-                if (nodes[k] == NULL) continue;
+        shaderCache[index].lastUse = compilesCount;
+        ApplyCompiledShader(shaderCache[index].shader);
+    }
+    else RequestShaderCompile(hash, true);
+}
 
-                if (nodes[k]->id == i)
-                {
-                    float type = (float)nodes[k]->type;
-                    float property = (float)nodes[k]->property;
-                    float inputs[MAX_INPUTS] = { (float)nodes[k]->inputs[0], (float)nodes[k]->inputs[1], (float)nodes[k]->inputs[2], (float)nodes[k]->inputs[3] };
-                    float inputsCount = (float)nodes[k]->inputsCount;
-                    float inputsLimit = (float)nodes[k]->inputsLimit;
-                    float dataCount = (float)nodes[k]->output.dataCount;
-                    float data[MAX_VALUES] = { nodes[k]->output.data[0].value, nodes[k]->output.data[1].value, nodes[k]->output.data[2].value, nodes[k]->output.data[3].value, nodes[k]->output.data[4].value,
-                    nodes[k]->output.data[5].value, nodes[k]->output.data[6].value, nodes[k]->output.data[7].value, nodes[k]->output.data[8].value, nodes[k]->output.data[9].value, nodes[k]->output.data[10].value,
-                    nodes[k]->output.data[11].value, nodes[k]->output.data[12].value, nodes[k]->output.data[13].value, nodes[k]->output.data[14].value, nodes[k]->output.data[15].value };
-                    float shapeX = (float)nodes[k]->shape.x;
-                    float shapeY = (float)nodes[k]->shape.y;
-
-                    fprintf(dataFile, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n", type, property,
-                    inputs[0], inputs[1], inputs[2], inputs[3], inputsCount, inputsLimit, dataCount, data[0], data[1], data[2],
-                    data[3], data[4], data[5], data[6], data[7], data[8], data[9], data[10], data[11], data[12], data[13], data[14],
-                    data[15], shapeX, shapeY);
-                    
-                    count++;
-                    break;
-                }
-            }
+// Loads a graph shader program binary or starts compiling its code without waiting for the driver
+void RequestShaderCompile(unsigned long long hash, bool useCache)
+{
+    char vertexPath[CHAR_SIZE] = { 0 };
+    char fragmentPath[CHAR_SIZE] = { 0 };
+    sprintf(vertexPath, CACHE_VERTEX_PATH, hash);
+    sprintf(fragmentPath, CACHE_FRAGMENT_PATH, hash);
 
-            if (count == nodesCount) break;
-        }
+    FString vertexCode = { 0 };
+    FString fragmentCode = { 0 };
 
-        // Lines data reading
-        count = 0;
+    // Shader code generated in previous sessions is loaded from cache files
+    bool cachedCode = (useCache && LoadShaderFile(vertexPath, &vertexCode) && LoadShaderFile(fragmentPath, &fragmentCode));
 
-        for (int i = 0; i < MAX_NODES; i++)
-        {
-            for (int k = 0; k < nodesCount; k++)
-            {
-                if (lines[k] == NULL) continue;
+    if (!cachedCode)
+    {
+        UnloadString(&vertexCode);
+        UnloadString(&fragmentCode);
+        GenerateShader(context, version, hoistVertex, &vertexCode, &fragmentCode);
+    }
 
-                if (lines[k]->id == i)
-                {
-                    fprintf(dataFile, "?%i?%i\n", lines[k]->from, lines[k]->to);
-                    
-                    count++;
-                    break;
-                }
-            }
+    // Shader programs linked in previous sessions are loaded from their binary without compiling
+    Shader compiled = { 0 };
 
-            if (count == linesCount) break;
-        }
+    if (programBinaries)
+    {
+        unsigned long long sourceHash = HashText(HashText(driverHash, vertexCode.text), fragmentCode.text);
+        char binaryPath[CHAR_SIZE] = { 0 };
+        sprintf(binaryPath, PROGRAM_BINARY_PATH, sourceHash);
 
-        fclose(dataFile);
+        compiled = LoadProgramBinary(binaryPath, sourceHash);
     }
+
+    if (compiled.id > 0)
+    {
+        if (!cachedCode && (!SaveShaderCode(vertexPath, &vertexCode) || !SaveShaderCode(fragmentPath, &fragmentCode))) TraceLogFNode(false, "error when trying to write shader cache files");
+
+        UnloadString(&vertexCode);
+        UnloadString(&fragmentCode);
+
+        ApplyCompiledShader(compiled);
+        CacheShader(hash, compiled);
+        return;
+    }
+
+    // Compile and link status are not queried here, so the driver can build the program while frames are drawn
+    const char *vertexText = vertexCode.text;
+    const char *fragmentText = fragmentCode.text;
+
+    pendingCompile.vertexId = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(pendingCompile.vertexId, 1, &vertexText, NULL);
+    glCompileShader(pendingCompile.vertexId);
+
+    pendingCompile.fragmentId = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(pendingCompile.fragmentId, 1, &fragmentText, NULL);
+    glCompileShader(pendingCompile.fragmentId);
+
+    pendingCompile.program = glCreateProgram();
+    glAttachShader(pendingCompile.program, pendingCompile.vertexId);
+    glAttachShader(pendingCompile.program, pendingCompile.fragmentId);
+
+    // Attributes are bound to the same locations raylib uses to draw meshes
+    glBindAttribLocation(pendingCompile.program, 0, "vertexPosition");
+    glBindAttribLocation(pendingCompile.program, 1, "vertexTexCoord");
+    glBindAttribLocation(pendingCompile.program, 2, "vertexNormal");
+    glBindAttribLocation(pendingCompile.program, 3, "vertexColor");
+    glBindAttribLocation(pendingCompile.program, 4, "vertexTangent");
+    glBindAttribLocation(pendingCompile.program, 5, "vertexTexCoord2");
+
+    if (programBinaries && (programParameteri != NULL)) programParameteri(pendingCompile.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    glLinkProgram(pendingCompile.program);
+
+    pendingCompile.hash = hash;
+    pendingCompile.cachedCode = cachedCode;
+    pendingCompile.vertexCode = vertexCode;
+    pendingCompile.fragmentCode = fragmentCode;
+
+    compileState = 2;
+    compileFrame = framesCounter;
 }
 
-// Compiles all node structure to create the GLSL fragment shader in output folder
-void CompileShader(void)
+// Check pending shader compile completion to load it in visor model
+void UpdateShaderCompile(void)
 {
-    SaveChanges();
+    if (pendingCompile.program == 0) return;
 
-    // Reset previous compiled shader data
-    if (loadedShader || (shader.id > 0)) UnloadShader(shader);
+    // Without parallel compile support link status is queried in the next frame, blocking until driver finishes
+    if (parallelCompile)
+    {
+        GLint completed = GL_FALSE;
+        glGetProgramiv(pendingCompile.program, GL_COMPLETION_STATUS_KHR, &completed);
+        if (completed != GL_TRUE) return;
+    }
 
-    remove(VERTEX_PATH);
-    remove(FRAGMENT_PATH);
+    GLint linked = GL_FALSE;
+    glGetProgramiv(pendingCompile.program, GL_LINK_STATUS, &linked);
 
-    model.materials[0].shader = GetShaderDefault();
-    for (int i = 0; i < MAX_TEXTURES; i++) usedUnits[i] = false;
-    viewUniform = -1;
-    transformUniform = -1;
-    timeUniformV = -1;
-    timeUniformF = -1;
+    glDetachShader(pendingCompile.program, pendingCompile.vertexId);
+    glDetachShader(pendingCompile.program, pendingCompile.fragmentId);
+    glDeleteShader(pendingCompile.vertexId);
+    glDeleteShader(pendingCompile.fragmentId);
 
-    compileState = -1;
-    compileFrame = 0;
+    ShaderCompile finished = pendingCompile;
+    pendingCompile = (ShaderCompile){ 0 };
 
-    // Open shader data file
-    FILE *dataFile = fopen(DATA_PATH, "w");
-    if (dataFile != NULL)
+    if (linked == GL_TRUE)
     {
-        // Nodes data reading
-        int count = 0;
-        for (int i = 0; i < MAX_NODES; i++)
+        Shader compiled = { 0 };
+        compiled.id = finished.program;
+        SetProgramLocations(&compiled);
+
+        if (programBinaries)
         {
-            for (int k = 0; k < nodesCount; k++)
-            {
-                if (nodes[k]->id == i)
-                {
-                    float type = (float)nodes[k]->type;
-                    float property = (float)nodes[k]->property;
-                    float inputs[MAX_INPUTS] = { (float)nodes[k]->inputs[0], (float)nodes[k]->inputs[1], (float)nodes[k]->inputs[2], (float)nodes[k]->inputs[3] };
-                    float inputsCount = (float)nodes[k]->inputsCount;
-                    float inputsLimit = (float)nodes[k]->inputsLimit;
-                    float dataCount = (float)nodes[k]->output.dataCount;
-                    float data[MAX_VALUES] = { nodes[k]->output.data[0].value, nodes[k]->output.data[1].value, nodes[k]->output.data[2].value, nodes[k]->output.data[3].value, nodes[k]->output.data[4].value,
-                    nodes[k]->output.data[5].value, nodes[k]->output.data[6].value, nodes[k]->output.data[7].value, nodes[k]->output.data[8].value, nodes[k]->output.data[9].value, nodes[k]->output.data[10].value,
-                    nodes[k]->output.data[11].value, nodes[k]->output.data[12].value, nodes[k]->output.data[13].value, nodes[k]->output.data[14].value, nodes[k]->output.data[15].value };
-                    float shapeX = (float)nodes[k]->shape.x;
-                    float shapeY = (float)nodes[k]->shape.y;
-
-                    fprintf(dataFile, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n", type, property,
-                    inputs[0], inputs[1], inputs[2], inputs[3], inputsCount, inputsLimit, dataCount, data[0], data[1], data[2],
-                    data[3], data[4], data[5], data[6], data[7], data[8], data[9], data[10], data[11], data[12], data[13], data[14],
-                    data[15], shapeX, shapeY);
-
-                    count++;
-                    break;
-                }
-            }
+            unsigned long long sourceHash = HashText(HashText(driverHash, finished.vertexCode.text), finished.fragmentCode.text);
+            char binaryPath[CHAR_SIZE] = { 0 };
+            sprintf(binaryPath, PROGRAM_BINARY_PATH, sourceHash);
 
-            if (count == nodesCount) break;
+            SaveProgramBinary(binaryPath, sourceHash, compiled);
         }
 
-        // Lines data reading
-        count = 0;
-
-        for (int i = 0; i < MAX_NODES; i++)
+        if (!finished.cachedCode)
         {
-            for (int k = 0; k < nodesCount; k++)
-            {
-                if (lines[k]->id == i)
-                {
-                    fprintf(dataFile, "?%i?%i\n", lines[k]->from, lines[k]->to);
-
-                    count++;
-                    break;
-                }
-            }
+            char vertexPath[CHAR_SIZE] = { 0 };
+            char fragmentPath[CHAR_SIZE] = { 0 };
+            sprintf(vertexPath, CACHE_VERTEX_PATH, finished.hash);
+            sprintf(fragmentPath, CACHE_FRAGMENT_PATH, finished.hash);
 
-            if (count == linesCount) break;
+            if (!SaveShaderCode(vertexPath, &finished.vertexCode) || !SaveShaderCode(fragmentPath, &finished.fragmentCode)) TraceLogFNode(false, "error when trying to write shader cache files");
         }
 
-        fclose(dataFile);
+        ApplyCompiledShader(compiled);
+        CacheShader(finished.hash, compiled);
     }
-    else TraceLogFNode(true, "error when trying to open and write in data file");
-
-    // Open vertex shader file to write data
-    FILE *vertexFile = fopen(VERTEX_PATH, "w");
-    if (vertexFile != NULL)
+    else
     {
-        const char vCredits[] = "// Shader created with FNode 1.0 - Credits: Victor Fisac\n\n";
-        fprintf(vertexFile, vCredits);
+        char log[CHAR_SIZE] = { 0 };
+        glGetProgramInfoLog(finished.program, CHAR_SIZE, NULL, log);
+        glDeleteProgram(finished.program);
 
-        // Vertex shader definition to embed, no external file required
-        switch (version)
+        if (finished.cachedCode)
         {
-            case GLSL_330:
-            {
-                const char vHeader[] = "#version 330\n\n";
-                fprintf(vertexFile, vHeader);
-            } break;
-            case GLSL_100:
+            char vertexPath[CHAR_SIZE] = { 0 };
+            char fragmentPath[CHAR_SIZE] = { 0 };
+            sprintf(vertexPath, CACHE_VERTEX_PATH, finished.hash);
+            sprintf(fragmentPath, CACHE_FRAGMENT_PATH, finished.hash);
+
+            TraceLogFNode(false, "error when trying to compile cached shader files, generating shader again");
+            remove(vertexPath);
+            remove(fragmentPath);
+
+            // Graph could be edited while cached code was compiling, so it is only generated again when unchanged
+            if (HashGraph() == finished.hash) RequestShaderCompile(finished.hash, false);
+            else
             {
-                const char vHeader[] = "#version 100\n\n";
-                fprintf(vertexFile, vHeader);
-            } break;
-            default: break;
+                compileState = 0;
+                compileFrame = framesCounter;
+            }
         }
-
-        switch (version)
+        else
         {
-            case GLSL_330:
-            {
-                const char vIn[] = 
-                "in vec3 vertexPosition;\n"
-                "in vec3 vertexNormal;\n"
-                "in vec2 vertexTexCoord;\n"
-                "in vec4 vertexColor;\n\n";
-                fprintf(vertexFile, vIn);
-
-                const char vOut[] = 
-                "out vec3 fragPosition;\n"
-                "out vec3 fragNormal;\n"
-                "out vec2 fragTexCoord;\n"
-                "out vec4 fragColor;\n\n";
-                fprintf(vertexFile, vOut);
-            } break;
-            case GLSL_100:
-            {
-                const char vIn[] = 
-                "attribute vec3 vertexPosition;\n"
-                "attribute vec3 vertexNormal;\n"
-                "attribute vec2 vertexTexCoord;\n"
-                "attribute vec4 vertexColor;\n\n";
-                fprintf(vertexFile, vIn);
-
-                const char vOut[] = 
-                "varying vec3 fragPosition;\n"
-                "varying vec3 fragNormal;\n"
-                "varying vec2 fragTexCoord;\n"
-                "varying vec4 fragColor;\n\n";
-                fprintf(vertexFile, vOut);
-            } break;
-            default: break;
+            TraceLogFNode(false, "error when trying to compile generated shader: %s", log);
+            compileState = 0;
+            compileFrame = framesCounter;
         }
+    }
 
-        const char vUniforms[] = 
-        "uniform mat4 mvp;\n"
-        "uniform float vertCurrentTime;\n\n";
-        fprintf(vertexFile, vUniforms);
+    UnloadString(&finished.vertexCode);
+    UnloadString(&finished.fragmentCode);
+}
 
-        fprintf(vertexFile, "// Constant and uniform values\n");
-        int index = GetNodeIndex(nodes[0]->inputs[0]);
-        CheckConstant(nodes[index], vertexFile);
+// Discards pending shader compile
+void CancelShaderCompile(void)
+{
+    if (pendingCompile.program == 0) return;
 
-        const char vMain[] = 
-        "\nvoid main()\n"
-        "{\n"
-        "    fragPosition = vertexPosition;\n"
-        "    fragNormal = vertexNormal;\n"
-        "    fragTexCoord = vertexTexCoord;\n"
-        "    fragColor = vertexColor;\n\n";
-        fprintf(vertexFile, vMain);
+    glDetachShader(pendingCompile.program, pendingCompile.vertexId);
+    glDetachShader(pendingCompile.program, pendingCompile.fragmentId);
+    glDeleteShader(pendingCompile.vertexId);
+    glDeleteShader(pendingCompile.fragmentId);
+    glDeleteProgram(pendingCompile.program);
 
-        CompileNode(nodes[index], vertexFile, false);
+    UnloadString(&pendingCompile.vertexCode);
+    UnloadString(&pendingCompile.fragmentCode);
 
-        switch (nodes[index]->output.dataCount)
-        {
-            case 1: fprintf(vertexFile, "\n    gl_Position = vec4(node_%02i, node_%02i, node_%02i, 1.0);\n}", nodes[0]->inputs[0], nodes[0]->inputs[0], nodes[0]->inputs[0]); break;
-            case 2: fprintf(vertexFile, "\n    gl_Position = vec4(node_%02i.xy, 0.0, 1.0);\n}", nodes[0]->inputs[0]); break;
-            case 3: fprintf(vertexFile, "\n    gl_Position = vec4(node_%02i.xyz, 1.0);\n}", nodes[0]->inputs[0]); break;
-            case 4: fprintf(vertexFile, "\n    gl_Position = node_%02i;\n}", nodes[0]->inputs[0]); break;
-            case 16: fprintf(vertexFile, "\n    gl_Position = node_%02i;\n}", nodes[0]->inputs[0]); break;
-            default: break;
-        }
+    pendingCompile = (ShaderCompile){ 0 };
+    compileState = -1;
+}
 
-        fclose(vertexFile);
-    }
-    else TraceLogFNode(true, "error when trying to open and write in vertex shader file");
+// Replaces visor model shader with a compiled shader program
+void ApplyCompiledShader(Shader compiled)
+{
+    // Replaced shader is unloaded unless it is kept in compiled shaders cache
+    if ((shader.id > 0) && (shader.id != compiled.id) && !IsShaderCached(shader)) UnloadShader(shader);
+
+    SetVisorShader(compiled);
+    compileState = 1;
+    compileFrame = framesCounter;
+}
+
+// Writes generated shader code to a file
+bool SaveShaderCode(const char *fileName, const FString *code)
+{
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) return false;
+
+    fwrite(code->text, 1, code->length, file);
+    fclose(file);
+
+    return true;
+}
+
+// Returns hash of graph structure and settings used to generate shader code
+unsigned long long HashGraph(void)
+{
+    unsigned long long hash = 14695981039346656037ull;
+
+    hash = (hash ^ (unsigned long long)SHADER_CACHE_FORMAT)*1099511628211ull;
+    hash = (hash ^ (unsigned long long)version)*1099511628211ull;
+    hash = (hash ^ (unsigned long long)hoistVertex)*1099511628211ull;
+    hash = (hash ^ (unsigned long long)context->nodesCount)*1099511628211ull;
 
-    // Open fragment shader file to write data
-    FILE *fragmentFile = fopen(FRAGMENT_PATH, "w");
-    if (fragmentFile != NULL)
+    // Nodes positions and names do not change generated code, so they are not hashed
+    for (int i = 0; i < context->nodesCount; i++)
     {
-        const char vCredits[] = "// Shader created with FNode 1.0 - Credits: Victor Fisac\n\n";
-        fprintf(vertexFile, vCredits);
+        FNode node = context->nodes[i];
 
-        // Fragment shader definition to embed, no external file required
-        switch (version)
+        hash = (hash ^ (unsigned long long)node->id)*1099511628211ull;
+        hash = (hash ^ (unsigned long long)(node->type + 2))*1099511628211ull;
+        hash = (hash ^ (unsigned long long)node->property)*1099511628211ull;
+        hash = (hash ^ (unsigned long long)node->output.dataCount)*1099511628211ull;
+        hash = (hash ^ (unsigned long long)node->inputsCount)*1099511628211ull;
+        for (int k = 0; k < node->inputsCount; k++) hash = (hash ^ (unsigned long long)node->inputs[k])*1099511628211ull;
+
+        // Constant values are written as literals, operations values are calculated from them
+        if ((node->inputsCount == 0) && ((node->type <= FNODE_E) || (node->type >= FNODE_MATRIX)))
         {
-            case GLSL_330:
-            {
-                const char fHeader[] = "#version 330\n\n";
-                fprintf(vertexFile, fHeader);
-            } break;
-            case GLSL_100:
+            for (int k = 0; k < node->output.dataCount; k++)
             {
-                const char fHeader[] = "#version 100\n"
-                "precision mediump float;\n\n";
-                fprintf(vertexFile, fHeader);
-            } break;
-            default: break;
+                unsigned int bits = 0;
+                memcpy(&bits, &node->output.data[k], sizeof(unsigned int));
+                hash = (hash ^ (unsigned long long)bits)*1099511628211ull;
+            }
         }
+    }
 
-        fprintf(fragmentFile, "// Input attributes\n");
+    return hash;
+}
 
-        switch (version)
-        {
-            case GLSL_330:
-            {
-                const char fIn[] = 
-                "in vec3 fragPosition;\n"
-                "in vec3 fragNormal;\n"
-                "in vec2 fragTexCoord;\n"
-                "in vec4 fragColor;\n\n";
-                fprintf(fragmentFile, fIn);
-            } break;
-            case GLSL_100:
-            {
-                const char fIn[] = 
-                "varying vec3 fragPosition;\n"
-                "varying vec3 fragNormal;\n"
-                "varying vec2 fragTexCoord;\n"
-                "varying vec4 fragColor;\n\n";
-                fprintf(fragmentFile, fIn);
-            } break;
-            default: break;
-        }
+// Returns cached shader program index of a graph hash (-1 if not found)
+int FindCachedShader(unsigned long long hash)
+{
+    for (int i = 0; i < shaderCacheCount; i++)
+    {
+        if (shaderCache[i].hash == hash) return i;
+    }
 
-        fprintf(fragmentFile, "// Uniform attributes\n");
-        const char fUniforms[] = 
-        "uniform vec3 viewDirection;\n"
-        "uniform mat4 modelMatrix;\n"
-        "uniform float fragCurrentTime;\n\n";
-        fprintf(fragmentFile, fUniforms);
+    return -1;
+}
 
-        if (version == GLSL_330)
+// Check if a shader program is owned by compiled shaders cache
+bool IsShaderCached(Shader cached)
+{
+    for (int i = 0; i < shaderCacheCount; i++)
+    {
+        if (shaderCache[i].shader.id == cached.id) return true;
+    }
+
+    return false;
+}
+
+// Stores a compiled shader program, replacing the least recently used one
+void CacheShader(unsigned long long hash, Shader compiled)
+{
+    int index = shaderCacheCount;
+
+    if (shaderCacheCount < MAX_SHADER_CACHE) shaderCacheCount++;
+    else
+    {
+        index = 0;
+        for (int i = 1; i < shaderCacheCount; i++)
         {
-            fprintf(fragmentFile, "// Output attributes\n");
-            const char fOut[] = 
-            "out vec4 finalColor;\n\n";
-            fprintf(fragmentFile, fOut);
+            if (shaderCache[i].lastUse < shaderCache[index].lastUse) index = i;
         }
 
-        fprintf(fragmentFile, "// Constant and uniform values\n");
-        int index = GetNodeIndex(nodes[1]->inputs[0]);
-        CheckConstant(nodes[index], fragmentFile);
+        UnloadShader(shaderCache[index].shader);
+    }
 
-        const char fMain[] = 
-        "\nvoid main()\n"
-        "{\n";
-        fprintf(fragmentFile, fMain);
+    shaderCache[index].hash = hash;
+    shaderCache[index].shader = compiled;
+    shaderCache[index].lastUse = compilesCount;
+}
 
-        CompileNode(nodes[index], fragmentFile, true);
+// Unloads all cached shader programs
+void UnloadShaderCache(void)
+{
+    for (int i = 0; i < shaderCacheCount; i++) UnloadShader(shaderCache[i].shader);
+
+    shaderCacheCount = 0;
+}
 
-        switch (version)
+// Removes the oldest cache files starting with a prefix until a max count is kept
+void TrimCacheFiles(const char *prefix, int maxFiles)
+{
+    int filesCount = 0;
+    char **files = GetDirectoryFiles(CACHE_FOLDER, &filesCount);
+
+    // Directory files list is released by raylib, so cache files paths are copied before removing any file
+    char **paths = (char **)FNODE_MALLOC(filesCount*sizeof(char *));
+    long *times = (long *)FNODE_MALLOC(filesCount*sizeof(long));
+    int count = 0;
+    int prefixLength = (int)strlen(prefix);
+
+    for (int i = 0; i < filesCount; i++)
+    {
+        if (strncmp(files[i], prefix, prefixLength) != 0) continue;
+
+        paths[count] = (char *)FNODE_MALLOC(CHAR_SIZE);
+        snprintf(paths[count], CHAR_SIZE, "%s/%s", CACHE_FOLDER, files[i]);
+        times[count] = GetFileModTime(paths[count]);
+        count++;
+    }
+
+    ClearDirectoryFiles();
+
+    // Cache files are rewritten when generated again, so the least recently written ones are removed first
+    for (int kept = count; kept > maxFiles; kept--)
+    {
+        int oldest = -1;
+        for (int i = 0; i < count; i++)
         {
-            case GLSL_330:
-            {
-                switch (nodes[index]->output.dataCount)
-                {
-                    case 1: fprintf(fragmentFile, "\n    finalColor = vec4(node_%02i, node_%02i, node_%02i, 1.0);\n}", nodes[1]->inputs[0], nodes[1]->inputs[0], nodes[1]->inputs[0]); break;
-                    case 2: fprintf(fragmentFile, "\n    finalColor = vec4(node_%02i.xy, 0.0, 1.0);\n}", nodes[1]->inputs[0]); break;
-                    case 3: fprintf(fragmentFile, "\n    finalColor = vec4(node_%02i.xyz, 1.0);\n}", nodes[1]->inputs[0]); break;
-                    case 4: fprintf(fragmentFile, "\n    finalColor = node_%02i;\n}", nodes[1]->inputs[0]); break;
-                    default: break;
-                }
-            } break;
-            case GLSL_100:
-            {
-                switch (nodes[index]->output.dataCount)
-                {
-                    case 1: fprintf(fragmentFile, "\n    gl_FragColor = vec4(node_%02i, node_%02i, node_%02i, 1.0);\n}", nodes[1]->inputs[0], nodes[1]->inputs[0], nodes[1]->inputs[0]); break;
-                    case 2: fprintf(fragmentFile, "\n    gl_FragColor = vec4(node_%02i.xy, 0.0, 1.0);\n}", nodes[1]->inputs[0]); break;
-                    case 3: fprintf(fragmentFile, "\n    gl_FragColor = vec4(node_%02i.xyz, 1.0);\n}", nodes[1]->inputs[0]); break;
-                    case 4: fprintf(fragmentFile, "\n    gl_FragColor = node_%02i;\n}", nodes[1]->inputs[0]); break;
-                    default: break;
-                }
-            } break;
-            default: break;
+            if ((paths[i] != NULL) && ((oldest == -1) || (times[i] < times[oldest]))) oldest = i;
         }
 
-        fclose(fragmentFile);
+        remove(paths[oldest]);
+        FNODE_FREE(paths[oldest]);
+        paths[oldest] = NULL;
     }
-    else TraceLogFNode(true, "error when trying to open and write in vertex shader file");
 
-    compileState = 1;
-    compileFrame = framesCounter;
+    for (int i = 0; i < count; i++)
+    {
+        if (paths[i] != NULL) FNODE_FREE(paths[i]);
+    }
 
-    CheckPreviousShader(false);
+    FNODE_FREE(paths);
+    FNODE_FREE(times);
 }
 
-// Check nodes searching for constant values to define them in shaders
-void CheckConstant(FNode node, FILE *file)
+// Loads shader program binary and parallel compile functions and hashes current driver
+void InitShaderExtensions(void)
 {
-    switch (node->type)
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+    getProgramBinary = (PFNGLGETPROGRAMBINARYPROC)glfwGetProcAddress("glGetProgramBinary");
+    programBinary = (PFNGLPROGRAMBINARYPROC)glfwGetProcAddress("glProgramBinary");
+    programParameteri = (PFNGLPROGRAMPARAMETERIPROC)glfwGetProcAddress("glProgramParameteri");
+    programBinaries = ((formats > 0) && (getProgramBinary != NULL) && (programBinary != NULL));
+
+    // Drivers with parallel compile support report programs completion without blocking
+    PFNGLMAXSHADERCOMPILERTHREADSKHRPROC maxCompilerThreads = NULL;
+
+    if (IsExtensionSupported("GL_KHR_parallel_shader_compile")) maxCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+    else if (IsExtensionSupported("GL_ARB_parallel_shader_compile")) maxCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+
+    if (maxCompilerThreads != NULL)
     {
-        case FNODE_PI: fprintf(file, "const float node_%02i = 3.14159265358979323846;\n", node->id); break;
-        case FNODE_E: fprintf(file, "const float node_%02i = 2.71828182845904523536;\n", node->id); break;
-        case FNODE_VALUE:
-        {
-            if (node->property)
-            {
-                const char fConstantVector4[] = "uniform float node_%02i;\n";
-                fprintf(file, fConstantVector4, node->id);
-            }
-            else
-            {
-                const char fConstantValue[] = "const float node_%02i = %.3f;\n";
-                fprintf(file, fConstantValue, node->id, node->output.data[0].value);
-            }
-        } break;
-        case FNODE_VECTOR2:
-        {
-            const char fConstantVector2[] = "const vec2 node_%02i = vec2(%.3f, %.3f);\n";
-            fprintf(file, fConstantVector2, node->id, node->output.data[0].value, node->output.data[1].value);
-        } break;
-        case FNODE_VECTOR3:
-        {
-            const char fConstantVector3[] = "const vec3 node_%02i = vec3(%.3f, %.3f, %.3f);\n";
-            fprintf(file, fConstantVector3, node->id, node->output.data[0].value, node->output.data[1].value, node->output.data[2].value);
-        } break;
-        case FNODE_VECTOR4:
-        {
-            if (node->property)
-            {
-                const char fConstantVector4[] = "uniform vec4 node_%02i;\n";
-                fprintf(file, fConstantVector4, node->id);
-            }
-            else
-            {
-                const char fConstantVector4[] = "const vec4 node_%02i = vec4(%.3f, %.3f, %.3f, %.3f);\n";
-                fprintf(file, fConstantVector4, node->id, node->output.data[0].value, node->output.data[1].value, node->output.data[2].value, node->output.data[3].value);
-            }
-        } break;
-        case FNODE_SAMPLER2D:
-        {
-            char fConstantSampler[32] = { '\0' };
-            int index = GetNodeIndex(node->inputs[0]);
-            sprintf(fConstantSampler, "uniform sampler2D texture%i;\n", (int)nodes[index]->output.data[0].value);
-            if (!usedUnits[(int)nodes[index]->output.data[0].value])
-            {
-                fprintf(file, fConstantSampler);
-                usedUnits[(int)nodes[index]->output.data[0].value] = true;
-            }
-        } break;
-        default:
-        {
-            for (int i = 0; i < node->inputsCount; i++)
-            {
-                int index = GetNodeIndex(node->inputs[i]);
-                CheckConstant(nodes[index], file);
-            }
-        } break;
+        maxCompilerThreads(0xffffffff);
+        parallelCompile = true;
     }
+
+    // Program binaries are only valid for the driver that created them
+    const char *driverStrings[3] = { (const char *)glGetString(GL_VENDOR), (const char *)glGetString(GL_RENDERER), (const char *)glGetString(GL_VERSION) };
+    driverHash = 14695981039346656037ull;
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (driverStrings[i] != NULL) driverHash = HashText(driverHash, driverStrings[i]);
+    }
+
+    if (!programBinaries) TraceLogFNode(false, "shader program binaries not supported by current driver, shaders will be compiled from code");
+}
+
+// Check if current driver supports an OpenGL extension
+bool IsExtensionSupported(const char *name)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+    for (int i = 0; i < count; i++)
+    {
+        const char *extension = (const char *)glGetStringi(GL_EXTENSIONS, i);
+        if ((extension != NULL) && (strcmp(extension, name) == 0)) return true;
+    }
+
+    return false;
+}
+
+// Returns hash of a text continuing a previous hash
+unsigned long long HashText(unsigned long long hash, const char *text)
+{
+    for (int i = 0; text[i] != '\0'; i++) hash = (hash ^ (unsigned long long)(unsigned char)text[i])*1099511628211ull;
+
+    // Texts end is hashed so consecutive texts boundaries are part of the hash
+    hash = (hash ^ 0xffull)*1099511628211ull;
+
+    return hash;
 }
 
-// Compiles a specific node checking its inputs and writing current node operation in shader
-void CompileNode(FNode node, FILE *file, bool fragment)
+// Reads shader code from a file
+bool LoadShaderFile(const char *fileName, FString *code)
 {
-    // Check if current node is an operator
-    if ((node->inputsCount > 0) || ((node->type < FNODE_MATRIX) && (node->type > FNODE_E)) || (node->type == FNODE_SAMPLER2D))
+    FILE *file = fopen(fileName, "r");
+    if (file == NULL) return false;
+
+    char buffer[CHAR_SIZE] = { 0 };
+    size_t count = 0;
+
+    while ((count = fread(buffer, 1, CHAR_SIZE - 1, file)) > 0)
+    {
+        buffer[count] = '\0';
+        AppendString(code, "%s", buffer);
+    }
+
+    fclose(file);
+
+    return (code->length > 0);
+}
+
+// Loads a shader program from binaries cache or compiles its code, storing its binary
+Shader LoadShaderProgram(char *vsCode, char *fsCode)
+{
+    if (!programBinaries) return LoadShaderCode(vsCode, fsCode);
+
+    unsigned long long hash = HashText(HashText(driverHash, vsCode), fsCode);
+    char binaryPath[CHAR_SIZE] = { 0 };
+    sprintf(binaryPath, PROGRAM_BINARY_PATH, hash);
+
+    Shader program = LoadProgramBinary(binaryPath, hash);
+
+    if (program.id == 0)
     {
-        // Check for operator nodes in inputs to compile them first
-        for (int i = 0; i < node->inputsCount; i++)
+        program = LoadShaderCode(vsCode, fsCode);
+        if ((program.id > 0) && (program.id != GetShaderDefault().id)) SaveProgramBinary(binaryPath, hash, program);
+    }
+
+    return program;
+}
+
+// Loads a shader program binary file created by current driver
+Shader LoadProgramBinary(const char *fileName, unsigned long long hash)
+{
+    Shader program = { 0 };
+
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return program;
+
+    unsigned long long fileHash = 0;
+    int format = 0;
+    int length = 0;
+    void *binary = NULL;
+
+    bool valid = ((fread(&fileHash, sizeof(unsigned long long), 1, file) == 1) && (fread(&format, sizeof(int), 1, file) == 1) &&
+    (fread(&length, sizeof(int), 1, file) == 1) && (fileHash == hash) && (length > 0));
+
+    if (valid)
+    {
+        binary = FNODE_MALLOC(length);
+        valid = (fread(binary, 1, length, file) == (size_t)length);
+    }
+
+    fclose(file);
+
+    if (valid)
+    {
+        program.id = glCreateProgram();
+        programBinary(program.id, (GLenum)format, binary, length);
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program.id, GL_LINK_STATUS, &linked);
+
+        if (linked == GL_TRUE) SetProgramLocations(&program);
+        else
         {
-            int index = GetNodeIndex(node->inputs[i]);
-            if (nodes[index]->type > FNODE_VECTOR4 || ((nodes[index]->type < FNODE_MATRIX) && (nodes[index]->type > FNODE_E))) CompileNode(nodes[index], file, fragment);
+            glDeleteProgram(program.id);
+            program.id = 0;
         }
+    }
+
+    if (binary != NULL) FNODE_FREE(binary);
+
+    // Corrupted binaries or binaries rejected by current driver are compiled again from code
+    if (program.id == 0)
+    {
+        TraceLogFNode(false, "shader program binary rejected, compiling shader code");
+        remove(fileName);
+    }
+
+    return program;
+}
+
+// Allocates and sets raylib default locations of a linked shader program
+void SetProgramLocations(Shader *program)
+{
+    // Locations array is released by raylib when unloading the shader
+    program->locs = (int *)malloc(MAX_SHADER_LOCATIONS*sizeof(int));
+    for (int i = 0; i < MAX_SHADER_LOCATIONS; i++) program->locs[i] = -1;
+
+    program->locs[LOC_VERTEX_POSITION] = glGetAttribLocation(program->id, "vertexPosition");
+    program->locs[LOC_VERTEX_TEXCOORD01] = glGetAttribLocation(program->id, "vertexTexCoord");
+    program->locs[LOC_VERTEX_TEXCOORD02] = glGetAttribLocation(program->id, "vertexTexCoord2");
+    program->locs[LOC_VERTEX_NORMAL] = glGetAttribLocation(program->id, "vertexNormal");
+    program->locs[LOC_VERTEX_TANGENT] = glGetAttribLocation(program->id, "vertexTangent");
+    program->locs[LOC_VERTEX_COLOR] = glGetAttribLocation(program->id, "vertexColor");
+    program->locs[LOC_MATRIX_MVP] = glGetUniformLocation(program->id, "mvp");
+    program->locs[LOC_MATRIX_PROJECTION] = glGetUniformLocation(program->id, "projection");
+    program->locs[LOC_MATRIX_VIEW] = glGetUniformLocation(program->id, "view");
+    program->locs[LOC_COLOR_DIFFUSE] = glGetUniformLocation(program->id, "colDiffuse");
+}
+
+// Writes a linked shader program binary to a file
+void SaveProgramBinary(const char *fileName, unsigned long long hash, Shader program)
+{
+    GLint length = 0;
+    glGetProgramiv(program.id, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
 
-        // Store variable declaration into a string
-        char check[16] = { '\0' };
-        switch (node->output.dataCount)
+    void *binary = FNODE_MALLOC(length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    getProgramBinary(program.id, length, &written, &format, binary);
+
+    if (written > 0)
+    {
+        FILE *file = fopen(fileName, "wb");
+        if (file != NULL)
         {
-            case 1: sprintf(check, "float node_%02i", node->id); break;
-            case 2: sprintf(check, "vec2 node_%02i", node->id); break;
-            case 3: sprintf(check, "vec3 node_%02i", node->id); break;
-            case 4: sprintf(check, "vec4 node_%02i", node->id); break;
-            case 16: sprintf(check, "mat4 node_%02i", node->id); break;
-            default: break;
+            int header[2] = { (int)format, (int)written };
+            fwrite(&hash, sizeof(unsigned long long), 1, file);
+            fwrite(header, sizeof(int), 2, file);
+            fwrite(binary, 1, written, file);
+            fclose(file);
         }
+        else TraceLogFNode(false, "error when trying to write shader program binary file");
+    }
 
-        // Check if current node is previously defined and declared
-        if (!FSearch(FRAGMENT_PATH, check))
-        {
-            // Variable definition based on current node output data count
-            char body[4096] = { '\0' };
-            char definition[32] = { '\0' };
+    FNODE_FREE(binary);
+}
 
-            switch (node->output.dataCount)
-            {
-                case 1: sprintf(definition, "    float node_%02i = ", node->id); break;
-                case 2: sprintf(definition, "    vec2 node_%02i = ", node->id); break;
-                case 3: sprintf(definition, "    vec3 node_%02i = ", node->id); break;
-                case 4: sprintf(definition, "    vec4 node_%02i = ", node->id); break;
-                case 16: sprintf(definition, "    mat4 node_%02i = ", node->id); break;
-                default: break;
-            }
+// Bakes fragment output color of every texel to a texture in output folder
+void BakeTexture(void)
+{
+    // Samplers read CPU copies of loaded textures
+    Image images[MAX_TEXTURES] = { 0 };
+    for (int i = 0; i < MAX_TEXTURES; i++)
+    {
+        if (textures[i].id != 0) images[i] = GetTextureData(textures[i]);
+    }
 
-            strcat(body, definition);
+    Image bake = BakeFragmentImage(context, BAKE_SIZE, BAKE_SIZE, images, MAX_TEXTURES, 0);
 
-            if (((node->type < FNODE_MATRIX) && (node->type > FNODE_E)) || (node->type == FNODE_SAMPLER2D))
-            {
-                switch (node->type)
-                {
-                    case FNODE_TIME:
-                    {
-                        if (fragment) strcat(body, "fragCurrentTime;\n");
-                        else strcat(body, "vertCurrentTime;\n");
-                    } break;
-                    case FNODE_VERTEXPOSITION:
-                    {
-                        if (fragment) strcat(body, "fragPosition;\n");
-                        else strcat(body, "vertexPosition;\n");
-                    } break;
-                    case FNODE_VERTEXNORMAL:
-                    {
-                        if (fragment) strcat(body, "fragNormal;\n");
-                        else strcat(body, "vertexNormal;\n");
-                    } break;
-                    case FNODE_FRESNEL: strcat(body, "1.0 - dot(fragNormal, viewDirection);\n"); break;
-                    case FNODE_VIEWDIRECTION: strcat(body, "viewDirection;\n"); break;
-                    case FNODE_MVP: strcat(body, "mvp;\n"); break;
-                    case FNODE_SAMPLER2D:
-                    {
-                        char test[CHAR_SIZE] = { '\0' };
+    if (bake.data != NULL)
+    {
+        ExportImage(bake, BAKE_PATH);
+        UnloadImage(bake);
+    }
 
-                        int indexA = GetNodeIndex(node->inputs[0]);
-                        int indexB = GetNodeIndex(node->inputs[1]);
+    for (int i = 0; i < MAX_TEXTURES; i++)
+    {
+        if (images[i].data != NULL) UnloadImage(images[i]);
+    }
+}
 
-                        switch (version)
-                        {
-                            case GLSL_330:
-                            {
-                                switch ((int)nodes[indexB]->output.data[0].value)
-                                {
-                                    case 0: sprintf(test, "texture(texture%i, fragTexCoord);\n    if (node_%02i.a == 0.0) discard;\n", (int)nodes[indexA]->output.data[0].value, node->id); break;
-                                    case 1: sprintf(test, "texture(texture%i, fragTexCoord).rgb;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 2: sprintf(test, "texture(texture%i, fragTexCoord).r;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 3: sprintf(test, "texture(texture%i, fragTexCoord).g;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 4: sprintf(test, "texture(texture%i, fragTexCoord).b;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 5: sprintf(test, "texture(texture%i, fragTexCoord).a;\n    if (node_%02i == 0.0) discard;\n", (int)nodes[indexA]->output.data[0].value, node->id); break;
-                                    default: sprintf(test, "texture(texture%i, fragTexCoord);\n", (int)nodes[indexA]->output.data[0].value); break;
-                                }
-                            } break;
-                            case GLSL_100:
-                            {
-                                switch ((int)nodes[indexB]->output.data[0].value)
-                                {
-                                    case 0: sprintf(test, "texture2D(texture%i, fragTexCoord);\n    if (node_%02i.a == 0.0) discard;\n", (int)nodes[indexA]->output.data[0].value, node->id); break;
-                                    case 1: sprintf(test, "texture2D(texture%i, fragTexCoord).rgb;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 2: sprintf(test, "texture2D(texture%i, fragTexCoord).r;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 3: sprintf(test, "texture2D(texture%i, fragTexCoord).g;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 4: sprintf(test, "texture2D(texture%i, fragTexCoord).b;\n", (int)nodes[indexA]->output.data[0].value); break;
-                                    case 5: sprintf(test, "texture2D(texture%i, fragTexCoord).a;\n    if (node_%02i == 0.0) discard;\n", (int)nodes[indexA]->output.data[0].value, node->id); break;
-                                    default: sprintf(test, "texture2D(texture%i, fragTexCoord);\n", (int)nodes[indexA]->output.data[0].value); break;
-                                }
-                            } break;
-                            default: break;
-                        }
+// Calculates vertex output values of visor model vertices and exports them to a mesh in output folder
+void EvaluateMesh(void)
+{
+    if (model.meshCount <= 0) return;
 
-                        strcat(body, test);
-                        break;
-                    }
-                    default: break;
-                }
-            }
-            else if ((node->type >= FNODE_ADD && node->type <= FNODE_DIVIDE) || node->type == FNODE_MULTIPLYMATRIX)
-            {
-                // Operate with each input node
-                for (int i = 0; i < node->inputsCount; i++)
-                {
-                    char temp[32] = { '\0' };
-                    if ((i+1) == node->inputsCount) sprintf(temp, "node_%02i;\n", node->inputs[i]);
-                    else
-                    {
-                        int nextIndex = GetNodeIndex(node->inputs[i+1]);
-                        if ((nodes[nextIndex]->output.dataCount - 1) == node->output.dataCount)
-                        {
-                            switch (node->output.dataCount)
-                            {
-                                case 1: sprintf(temp, "vec2(node_%02i, 0.0);\n", node->inputs[i]);
-                                case 2: sprintf(temp, "vec3(node_%02i, 0.0);\n", node->inputs[i]);
-                                case 3: sprintf(temp, "vec4(node_%02i, 0.0);\n", node->inputs[i]);
-                                default: break;
-                            }
-                        }
-                        else sprintf(temp, "node_%02i", node->inputs[i]);
-                        switch (node->type)
-                        {
-                            case FNODE_ADD: strcat(temp, " + "); break;
-                            case FNODE_SUBTRACT: strcat(temp, " - "); break;
-                            case FNODE_MULTIPLYMATRIX:
-                            case FNODE_MULTIPLY: strcat(temp, "*"); break;
-                            case FNODE_DIVIDE: strcat(temp, "/"); break;
-                            default: break;
-                        }
-                    }
+    Mesh mesh = model.meshes[0];
+    float *positions = (float *)FNODE_MALLOC(mesh.vertexCount*4*sizeof(float));
 
-                    strcat(body, temp);
-                }
-            }
-            else if (node->type >= FNODE_APPEND)
-            {
-                char temp[CHAR_SIZE] = { '\0' };
-                switch (node->type)
-                {
-                    case FNODE_APPEND:
-                    {
-                        switch (node->output.dataCount)
-                        {
-                            case 2: strcat(temp, "vec2("); break;
-                            case 3: strcat(temp, "vec3("); break;
-                            case 4: strcat(temp, "vec4("); break;
-                            default: break;
-                        }
+    // Samplers read CPU copies of loaded textures at vertex texture coordinates
+    Image images[MAX_TEXTURES] = { 0 };
+    for (int i = 0; i < MAX_TEXTURES; i++)
+    {
+        if (textures[i].id != 0) images[i] = GetTextureData(textures[i]);
+    }
 
-                        for (int i = 0; i < node->inputsCount; i++)
-                        {
-                            char append[32] = { '\0' };
-                            if ((i + 1) == node->inputsCount) sprintf(append, "node_%02i);\n", node->inputs[i]);
-                            else sprintf(append, "node_%02i, ", node->inputs[i]);
-                            
-                            strcat(temp, append);
-                        }
-                    } break;
-                    case FNODE_ONEMINUS: sprintf(temp, "(1.0 - node_%02i);\n", node->inputs[0]); break;
-                    case FNODE_ABS: sprintf(temp, "abs(node_%02i);\n", node->inputs[0]); break;
-                    case FNODE_COS: sprintf(temp, "cos(node_%02i);\n", node->inputs[0]); break;
-                    case FNODE_SIN: sprintf(temp, "sin(node_%02i);\n", node->inputs[0]); break;
-                    case FNODE_TAN: sprintf(temp, "tan(node_%02i);\n", node->inputs[0]); break;
-                    case FNODE_DEG2RAD: sprintf(temp, "node_%02i*(3.14159265358979323846/180.0);\n", node->inputs[0]); break;
-                    case FNODE_RAD2DEG: sprintf(temp, "node_%02i*(180.0/3.14159265358979323846);\n", node->inputs[0]); break;
-                    case FNODE_NORMALIZE: sprintf(temp, "normalize(node_%02i);\n", node->inputs[0]); break;
-                    case FNODE_NEGATE: sprintf(temp, "node_%02i*-1;\n", node->inputs[0]); break;
-                    case FNODE_RECIPROCAL: sprintf(temp, "1.0/node_%02i;\n", node->inputs[0]); break;
-                    case FNODE_SQRT: sprintf(temp, "sqrt(node_%02i);\n", node->inputs[0]); break;
-                    case FNODE_TRUNC: sprintf(temp, "trunc(node_%02i);\n", node->inputs[0]); break;
-                    case FNODE_ROUND: sprintf(temp, "round(node_%02i);\n", node->inputs[0]); break;
-                    case FNODE_VERTEXCOLOR:
-                    {
-                        int index = GetNodeIndex(node->inputs[0]);
-                        switch ((int)nodes[index]->output.data[0].value)
-                        {
-                            case 0: sprintf(temp, (fragment ? "fragColor;\n" : "vertexColor;\n")); break;
-                            case 1: sprintf(temp, (fragment ? "fragColor.rgb;\n" : "vertexColor.rgb;\n")); break;
-                            case 2: sprintf(temp, (fragment ? "fragColor.r;\n" : "vertexColor.r;\n")); break;
-                            case 3: sprintf(temp, (fragment ? "fragColor.g;\n" : "vertexColor.g;\n")); break;
-                            case 4: sprintf(temp, (fragment ? "fragColor.b;\n" : "vertexColor.b;\n")); break;
-                            case 5: sprintf(temp, (fragment ? "fragColor.a;\n" : "vertexColor.a;\n")); break;
-                            default: break;
-                        }
-                    } break;
-                    case FNODE_CEIL: sprintf(temp, "ceil(node_%02i);\n", node->inputs[0]); break;
-                    case FNODE_CLAMP01: sprintf(temp, "clamp(node_%02i, 0.0, 1.0);\n", node->inputs[0]); break;
-                    case FNODE_EXP2: sprintf(temp, "exp2(node_%02i);\n", node->inputs[0]); break;
-                    case FNODE_POWER: sprintf(temp, "pow(node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1]); break;
-                    case FNODE_STEP: sprintf(temp, "((node_%02i <= node_%02i) ? 1.0 : 0.0);\n", node->inputs[0], node->inputs[1]); break;
-                    case FNODE_POSTERIZE: sprintf(temp, "floor(node_%02i*node_%02i)/node_%02i;\n", node->inputs[0], node->inputs[1], node->inputs[1]); break;
-                    case FNODE_MAX: sprintf(temp, "max(node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1]); break;
-                    case FNODE_MIN: sprintf(temp, "min(node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1]); break;
-                    case FNODE_LERP: sprintf(temp, "mix(node_%02i, node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1], node->inputs[2]); break;
-                    case FNODE_SMOOTHSTEP: sprintf(temp, "smoothstep(node_%02i, node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1], node->inputs[2]); break;
-                    case FNODE_CROSSPRODUCT: sprintf(temp, "cross(node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1]); break;
-                    case FNODE_DESATURATE:
-                    {
-                        switch (node->output.dataCount)
-                        {
-                            case 1: sprintf(temp, "mix(node_%02i, 0.3, node_%02i);\n", node->inputs[0], node->inputs[1]); break;
-                            case 2: sprintf(temp, "vec2(mix(node_%02i.x, vec2(0.3, 0.59), node_%02i));\n", node->inputs[0], node->inputs[1]); break;
-                            case 3: sprintf(temp, "vec3(mix(node_%02i.xyz, vec3(0.3, 0.59, 0.11), node_%02i));\n", node->inputs[0], node->inputs[1]); break;
-                            case 4: sprintf(temp, "vec4(mix(node_%02i.xyz, vec3(0.3, 0.59, 0.11), node_%02i), 1.0);\n", node->inputs[0], node->inputs[1]); break;
-                            default: break;
-                        }
-                    } break;
-                    case FNODE_DISTANCE: sprintf(temp, "distance(node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1]); break;
-                    case FNODE_DOTPRODUCT: sprintf(temp, "dot(node_%02i, node_%02i);\n", node->inputs[0], node->inputs[1]); break;
-                    case FNODE_LENGTH: sprintf(temp, "length(node_%02i);\n", node->inputs[0]); break;
-                    case FNODE_TRANSPOSE: sprintf(temp, "transpose(node_%02i);\n", node->inputs[0]); break;
-                    case FNODE_PROJECTION:
-                    {
-                        switch (node->output.dataCount)
-                        {
-                            case 2: sprintf(temp, "vec2(dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.x, dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.y);\n", 
-                            node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1]); break;
-                            case 3: sprintf(temp, "vec3(dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.x, dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.y, dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.z);\n", 
-                            node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1]); break;
-                            case 4: sprintf(temp, "vec4(dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.x, dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.y, dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.z, dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.w);\n", 
-                            node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1]); break;
-                            default: break;
-                        }
-                    }
-                    case FNODE_REJECTION:
-                    {
-                        switch (node->output.dataCount)
-                        {
-                            case 2: sprintf(temp, "vec2(node_%02i.x - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.x, node_%02i.y - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.y);\n", 
-                            node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1]); break;
-                            case 3: sprintf(temp, "vec3(node_%02i.x - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.x, node_%02i.y - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.y, node_%02i.z - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.z);\n", 
-                            node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1]); break;
-                            case 4: sprintf(temp, "vec4(node_%02i.x - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.x, node_%02i.y - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.y, node_%02i.z - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.z, node_%02i.w - dot(node_%02i, node_%02i)/dot(node_%02i, node_%02i)*node_%02i.w);\n", 
-                            node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[0], node->inputs[0], node->inputs[1], node->inputs[1], node->inputs[1], node->inputs[1]); break;
-                            default: break;
-                        }
-                    } break;
-                    case FNODE_HALFDIRECTION: sprintf(temp, "normalize(node_%02i + node_%02i);\n", node->inputs[0], node->inputs[1]); break;
-                    default: break;
-                }
+    EvaluateMeshVertices(context, mesh, positions, images, MAX_TEXTURES, 0);
 
-                strcat(body, temp);
-            }
+    // Vertex output values are exported as homogeneous vertices keeping mesh triangles
+    FILE *file = fopen(MESH_PATH, "w");
+
+    if (file != NULL)
+    {
+        for (int i = 0; i < mesh.vertexCount; i++) fprintf(file, "v %f %f %f %f\n", positions[i*4], positions[i*4 + 1], positions[i*4 + 2], positions[i*4 + 3]);
 
-            // Write current node string to shader file
-            fprintf(file, body);
+        for (int i = 0; i < mesh.triangleCount; i++)
+        {
+            if (mesh.indices != NULL) fprintf(file, "f %i %i %i\n", mesh.indices[i*3] + 1, mesh.indices[i*3 + 1] + 1, mesh.indices[i*3 + 2] + 1);
+            else fprintf(file, "f %i %i %i\n", i*3 + 1, i*3 + 2, i*3 + 3);
         }
+
+        fclose(file);
+        TraceLogFNode(false, "evaluated mesh exported to %s", MESH_PATH);
     }
+    else TraceLogFNode(false, "error when trying to open and write in mesh file %s", MESH_PATH);
+
+    for (int i = 0; i < MAX_TEXTURES; i++)
+    {
+        if (images[i].data != NULL) UnloadImage(images[i]);
+    }
+
+    FNODE_FREE(positions);
 }
 
 // Aligns all created nodes
 void AlignAllNodes(void)
 {
-    for (int i = 0; i < nodesCount; i++)
+    for (int i = 0; i < context->nodesCount; i++)
     {
-        AlignNode(nodes[i]);
-        UpdateNodeShapes(nodes[i]);
+        AlignNode(context->nodes[i]);
+        UpdateNodeShapes(context->nodes[i]);
     }
 }
 
 // Destroys all unused nodes
 void ClearUnusedNodes(void)
 {
-    for (int i = nodesCount - 1; i >= 0; i--)
-    {
-        bool used = (nodes[i]->type >= FNODE_VERTEX);
+    // Nodes are destroyed together so values are calculated once
+    FNode *unused = (FNode *)FNODE_MALLOC(context->nodesCount*sizeof(FNode));
+    int unusedCount = 0;
 
-        if (!used)
-        {
-            for (int k = 0; k < linesCount; k++)
-            {
-                if ((nodes[i]->id == lines[k]->from) || (nodes[i]->id == lines[k]->to))
-                {
-                    used = true;
-                    break;
-                }
-            }
-        }
+    for (int i = context->nodesCount - 1; i >= 0; i--)
+    {
+        bool used = ((context->nodes[i]->type >= FNODE_VERTEX) || (context->nodes[i]->inputsCount > 0) || (context->nodes[i]->outputsCount > 0));
 
-        if (!used) DestroyNode(nodes[i]);
+        if (!used) unused[unusedCount++] = context->nodes[i];
     }
 
-    TraceLogFNode(false, "all unused nodes have been deleted [USED RAM: %i bytes]", usedMemory);
+    DestroyNodes(context, unused, unusedCount);
+    FNODE_FREE(unused);
+
+    TraceLogFNode(false, "all unused nodes have been deleted [USED RAM: %i bytes]", context->usedMemory);
 }
 
 // Destroys all created nodes and its linked lines
 void ClearGraph(void)
 {
-    for (int i = nodesCount - 1; i >= 0; i--)
+    // Nodes are destroyed together so values are calculated once
+    FNode *created = (FNode *)FNODE_MALLOC(context->nodesCount*sizeof(FNode));
+    int createdCount = 0;
+
+    for (int i = context->nodesCount - 1; i >= 0; i--)
     {
-        if (nodes[i]->type < FNODE_VERTEX) DestroyNode(nodes[i]);
+        if (context->nodes[i]->type < FNODE_VERTEX) created[createdCount++] = context->nodes[i];
     }
 
-    for (int i = commentsCount - 1; i >= 0; i--) DestroyComment(comments[i]);
+    DestroyNodes(context, created, createdCount);
+    FNODE_FREE(created);
 
-    TraceLogFNode(false, "all nodes have been deleted [USED RAM: %i bytes]", usedMemory);
+    for (int i = context->commentsCount - 1; i >= 0; i--) DestroyComment(context, context->comments[i]);
+
+    TraceLogFNode(false, "all nodes have been deleted [USED RAM: %i bytes]", context->usedMemory);
 }
 
 // Draw canvas space to create nodes
@@ -2061,10 +1870,10 @@ void DrawCanvas(void)
             ClearBackground(RAYWHITE);
             
             // Draw background title and credits
-            DrawText("FNODE 1.0", (screenSize.x - MeasureText("FNODE 1.0", 120))/2, screenSize.y/2 - 60, 120, Fade(LIGHTGRAY, UI_GRID_ALPHA*2));
-            DrawText("VICTOR FISAC", (screenSize.x - MeasureText("VICTOR FISAC", 40))/2, screenSize.y*0.65f - 20, 40, Fade(LIGHTGRAY, UI_GRID_ALPHA*2));
+            DrawText("FNODE 1.0", (context->screenSize.x - MeasureText("FNODE 1.0", 120))/2, context->screenSize.y/2 - 60, 120, Fade(LIGHTGRAY, UI_GRID_ALPHA*2));
+            DrawText("VICTOR FISAC", (context->screenSize.x - MeasureText("VICTOR FISAC", 40))/2, context->screenSize.y*0.65f - 20, 40, Fade(LIGHTGRAY, UI_GRID_ALPHA*2));
 
-            BeginMode2D(camera);
+            BeginMode2D(context->camera);
 
                 DrawCanvasGrid(UI_GRID_COUNT);
 
@@ -2072,14 +1881,14 @@ void DrawCanvas(void)
 
         EndTextureMode();
 
-        DrawTexturePro(gridTarget.texture, (Rectangle){ 0, 0, gridTarget.texture.width, -gridTarget.texture.height }, (Rectangle){ 0, 0, screenSize.x, screenSize.y }, (Vector2){ 0, 0 }, 0, WHITE);
+        DrawTexturePro(gridTarget.texture, (Rectangle){ 0, 0, gridTarget.texture.width, -gridTarget.texture.height }, (Rectangle){ 0, 0, context->screenSize.x, context->screenSize.y }, (Vector2){ 0, 0 }, 0, WHITE);
 
-        BeginMode2D(camera);
+        BeginMode2D(context->camera);
 
             // Draw all created comments, lines and nodes
-            for (int i = 0; i < commentsCount; i++) DrawComment(comments[i]);
-            for (int i = 0; i < nodesCount; i++) DrawNode(nodes[i]);
-            for (int i = 0; i < linesCount; i++) DrawNodeLine(lines[i]);
+            for (int i = 0; i < context->commentsCount; i++) DrawComment(context, context->comments[i]);
+            for (int i = 0; i < context->nodesCount; i++) DrawNode(context, context->nodes[i]);
+            for (int i = 0; i < context->linesCount; i++) DrawNodeLine(context, context->lines[i]);
 
         EndMode2D();
 
@@ -2117,15 +1926,15 @@ void DrawVisor(void)
     
         ClearBackground(RAYWHITE);
 
-        DrawRectangle(0, 0, screenSize.x, screenSize.y, GRAY);
+        DrawRectangle(0, 0, context->screenSize.x, context->screenSize.y, GRAY);
 
         // Draw background title and credits
-        DrawText("FNODE 1.0", (screenSize.x - MeasureText("FNODE 1.0", 120))/2, screenSize.y/2 - 60, 120, Fade(LIGHTGRAY, UI_GRID_ALPHA*2));
-        DrawText("VICTOR FISAC", (screenSize.x - MeasureText("VICTOR FISAC", 40))/2, screenSize.y*0.65f - 20, 40, Fade(LIGHTGRAY, UI_GRID_ALPHA*2));
+        DrawText("FNODE 1.0", (context->screenSize.x - MeasureText("FNODE 1.0", 120))/2, context->screenSize.y/2 - 60, 120, Fade(LIGHTGRAY, UI_GRID_ALPHA*2));
+        DrawText("VICTOR FISAC", (context->screenSize.x - MeasureText("VICTOR FISAC", 40))/2, context->screenSize.y*0.65f - 20, 40, Fade(LIGHTGRAY, UI_GRID_ALPHA*2));
 
         BeginShaderMode(model.materials[0].shader);
 
-            BeginMode3D(camera3d);
+            BeginMode3D(context->camera3d);
 
                 DrawModelEx(model, (Vector3){ 0.0f, -1.0f, 0.0f }, (Vector3){ 0, 1, 0 }, modelRotation, (Vector3){ VISOR_MODEL_SCALE, VISOR_MODEL_SCALE, VISOR_MODEL_SCALE }, WHITE);
 
@@ -2135,14 +1944,14 @@ void DrawVisor(void)
 
     EndTextureMode();
 
-    Rectangle visor = { canvasSize.x - visorTarget.texture.width - PADDING_MAIN_BOTTOM, screenSize.y - visorTarget.texture.height - PADDING_MAIN_BOTTOM, visorTarget.texture.width, visorTarget.texture.height };
+    Rectangle visor = { canvasSize.x - visorTarget.texture.width - PADDING_MAIN_BOTTOM, context->screenSize.y - visorTarget.texture.height - PADDING_MAIN_BOTTOM, visorTarget.texture.width, visorTarget.texture.height };
 
     if (fullVisor)
     {
         visor.x = 0;
         visor.y = 0;
-        visor.width = screenSize.x;
-        visor.height = screenSize.y;
+        visor.width = context->screenSize.x;
+        visor.height = context->screenSize.y;
     }
 
     DrawRectangle(visor.x - VISOR_BORDER, visor.y - VISOR_BORDER, visor.width + VISOR_BORDER*2, visor.height + VISOR_BORDER*2, COLOR_INTERFACE_BORDER);
@@ -2161,9 +1970,9 @@ void DrawInterface(void)
 {   
     DrawHelp();
 
-    sidebarRect = (Rectangle){ 0, 0, screenSize.x - canvasSize.x, screenSize.y };
+    sidebarRect = (Rectangle){ 0, 0, context->screenSize.x - canvasSize.x, context->screenSize.y };
     DrawRectangleRec(sidebarRect, COLOR_INTERFACE_SHAPE);
-    DrawRectangle(screenSize.x - canvasSize.x, 0, WIDTH_INTERFACE_BORDER, sidebarRect.height, COLOR_INTERFACE_BORDER);
+    DrawRectangle(context->screenSize.x - canvasSize.x, 0, WIDTH_INTERFACE_BORDER, sidebarRect.height, COLOR_INTERFACE_BORDER);
 
     Rectangle layoutRect = (Rectangle){ 0, 0, 0, 0 };
     DrawLeftSection("Tools", &layoutRect, (Vector4){ 0, 0.75f, 3, 1.2f });
@@ -2172,12 +1981,13 @@ void DrawInterface(void)
     if (InterfaceButton(LEFT_LAYOUT_RECT, "Clear Unused")) ClearUnusedNodes();
 
     DrawLeftSection("Compilation", &layoutRect, (Vector4){ 4, 1.25f, 2, 1 });
-    if (InterfaceButtonGroup(LEFT_LAYOUT_RECT, "Compile", (compileState >= 0))) CompileShader();
+    const char *compileTexts[4] = { "Compile", "Compile Failed", "Compiled", "Compiling..." };
+    if (InterfaceButtonGroup(LEFT_LAYOUT_RECT, compileTexts[compileState + 1], (compileState >= 0))) CompileShader();
     if (InterfaceButton(LEFT_LAYOUT_RECT, "Save Changes")) SaveChanges();
 
     DrawLeftSection("Configuration", &layoutRect, (Vector4){ 7, 1.5f, 3, 0.05f });
     if (InterfaceButtonGroup((Rectangle){ layoutRect.x, layoutRect.y, layoutRect.width/2 - PADDING_MAIN_CENTER, UI_BUTTON_HEIGHT*0.75f }, "GLSL 330", (version == 0))) version = 0;
-    if (InterfaceButtonGroup((Rectangle){ layoutRect.x + (layoutRect.width/2*menuOffset), layoutRect.y, layoutRect.width/2 - PADDING_MAIN_CENTER, UI_BUTTON_HEIGHT*0.75f }, "GLSL 110", (version == 1))) version = 1;
+    if (InterfaceButtonGroup((Rectangle){ layoutRect.x + (layoutRect.width/2*context->menuOffset), layoutRect.y, layoutRect.width/2 - PADDING_MAIN_CENTER, UI_BUTTON_HEIGHT*0.75f }, "GLSL 110", (version == 1))) version = 1;
 
     prevBackfaceCulling = backfaceCulling;
     backfaceCulling = InterfaceToggle((Rectangle){ layoutRect.x, layoutRect.y + (UI_BUTTON_HEIGHT + PADDING_MAIN_CENTER), 16, 16 }, backfaceCulling);
@@ -2216,73 +2026,73 @@ void DrawInterface(void)
     DrawRectangle(interfaceRect.x - WIDTH_INTERFACE_BORDER*2, interfaceRect.y, WIDTH_INTERFACE_BORDER, interfaceRect.height, COLOR_INTERFACE_BORDER);
 
     DrawRightSection("Constant Properties", &layoutRect, (Vector4){ 0, 0.75f, 5, 1.6f });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Value")) CreateNodeValue((float)GetRandomValue(-11, 10));
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector 2")) CreateNodeVector2((Vector2){ (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10) });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector 3")) CreateNodeVector3((Vector3){ (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10) });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector 4")) CreateNodeVector4((Vector4){ (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10) });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Matrix 4x4")) CreateNodeMatrix(FMatrixIdentity());
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Value")) CreateNodeValue(context, (float)GetRandomValue(-11, 10));
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector 2")) CreateNodeVector2(context, (Vector2){ (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10) });
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector 3")) CreateNodeVector3(context, (Vector3){ (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10) });
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector 4")) CreateNodeVector4(context, (Vector4){ (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10), (float)GetRandomValue(0, 10) });
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Matrix 4x4")) CreateNodeMatrix(context, FMatrixIdentity());
 
     DrawRightSection("Properties", &layoutRect, (Vector4){ 6, 1.75f, 3, 1.25f });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Value")) CreateNodeProperty(FNODE_VALUE, "Value", 1, 0);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Color")) CreateNodeProperty(FNODE_VECTOR4, "Color", 4, 0);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Sampler2D")) CreateNodeProperty(FNODE_SAMPLER2D, "Sampler 2D", 4, 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Value")) CreateNodeProperty(context, FNODE_VALUE, "Value", 1, 0);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Color")) CreateNodeProperty(context, FNODE_VECTOR4, "Color", 4, 0);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Sampler2D")) CreateNodeProperty(context, FNODE_SAMPLER2D, "Sampler 2D", 4, 2);
 
     DrawRightSection("Arithmetic", &layoutRect, (Vector4){ 11, 0.85f, 24, 2 });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Add")) CreateNodeOperator(FNODE_ADD, "Add", MAX_INPUTS);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Subtract")) CreateNodeOperator(FNODE_SUBTRACT, "Subtract", MAX_INPUTS);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Multiply")) CreateNodeOperator(FNODE_MULTIPLY, "Multiply", MAX_INPUTS);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Multiply Matrix")) CreateNodeOperator(FNODE_MULTIPLYMATRIX, "Multiply Matrix", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Divide")) CreateNodeOperator(FNODE_DIVIDE, "Divide", MAX_INPUTS);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "One Minus")) CreateNodeOperator(FNODE_ONEMINUS, "One Minus", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Abs")) CreateNodeOperator(FNODE_ABS, "Abs", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Clamp 0-1")) CreateNodeOperator(FNODE_CLAMP01, "Clamp 0-1", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Max")) CreateNodeOperator(FNODE_MAX, "Max", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Min")) CreateNodeOperator(FNODE_MIN, "Min", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Negate")) CreateNodeOperator(FNODE_NEGATE, "Negate", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Reciprocal")) CreateNodeOperator(FNODE_RECIPROCAL, "Reciprocal", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Square Root")) CreateNodeOperator(FNODE_SQRT, "Square Root", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Power")) CreateNodeOperator(FNODE_POWER, "Power", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Exp 2")) CreateNodeOperator(FNODE_EXP2, "Exp 2", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Posterize")) CreateNodeOperator(FNODE_POSTERIZE, "Posterize", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Ceil")) CreateNodeOperator(FNODE_CEIL, "Ceil", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Round")) CreateNodeOperator(FNODE_ROUND, "Round", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Trunc")) CreateNodeOperator(FNODE_TRUNC, "Trunc", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Lerp")) CreateNodeOperator(FNODE_LERP, "Lerp", 3);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Step")) CreateNodeOperator(FNODE_STEP, "Step", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "SmoothStep")) CreateNodeOperator(FNODE_SMOOTHSTEP, "SmoothStep", 3);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Add")) CreateNodeOperator(context, FNODE_ADD, "Add", MAX_INPUTS);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Subtract")) CreateNodeOperator(context, FNODE_SUBTRACT, "Subtract", MAX_INPUTS);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Multiply")) CreateNodeOperator(context, FNODE_MULTIPLY, "Multiply", MAX_INPUTS);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Multiply Matrix")) CreateNodeOperator(context, FNODE_MULTIPLYMATRIX, "Multiply Matrix", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Divide")) CreateNodeOperator(context, FNODE_DIVIDE, "Divide", MAX_INPUTS);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "One Minus")) CreateNodeOperator(context, FNODE_ONEMINUS, "One Minus", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Abs")) CreateNodeOperator(context, FNODE_ABS, "Abs", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Clamp 0-1")) CreateNodeOperator(context, FNODE_CLAMP01, "Clamp 0-1", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Max")) CreateNodeOperator(context, FNODE_MAX, "Max", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Min")) CreateNodeOperator(context, FNODE_MIN, "Min", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Negate")) CreateNodeOperator(context, FNODE_NEGATE, "Negate", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Reciprocal")) CreateNodeOperator(context, FNODE_RECIPROCAL, "Reciprocal", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Square Root")) CreateNodeOperator(context, FNODE_SQRT, "Square Root", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Power")) CreateNodeOperator(context, FNODE_POWER, "Power", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Exp 2")) CreateNodeOperator(context, FNODE_EXP2, "Exp 2", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Posterize")) CreateNodeOperator(context, FNODE_POSTERIZE, "Posterize", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Ceil")) CreateNodeOperator(context, FNODE_CEIL, "Ceil", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Round")) CreateNodeOperator(context, FNODE_ROUND, "Round", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Trunc")) CreateNodeOperator(context, FNODE_TRUNC, "Trunc", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Lerp")) CreateNodeOperator(context, FNODE_LERP, "Lerp", 3);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Step")) CreateNodeOperator(context, FNODE_STEP, "Step", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "SmoothStep")) CreateNodeOperator(context, FNODE_SMOOTHSTEP, "SmoothStep", 3);
 
     DrawRightSection("Vector Operations", &layoutRect, (Vector4){ 37, 0.75f, 12, 1.35f});
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Append")) CreateNodeOperator(FNODE_APPEND, "Append", 4);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Normalize")) CreateNodeOperator(FNODE_NORMALIZE, "Normalize", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Cross Product")) CreateNodeOperator(FNODE_CROSSPRODUCT, "Cross Product", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Desaturate")) CreateNodeOperator(FNODE_DESATURATE, "Desaturate", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Distance")) CreateNodeOperator(FNODE_DISTANCE, "Distance", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Dot Product")) CreateNodeOperator(FNODE_DOTPRODUCT, "Dot Product", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Length")) CreateNodeOperator(FNODE_LENGTH, "Length", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Transpose")) CreateNodeOperator(FNODE_TRANSPOSE, "Transpose", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector Projection")) CreateNodeOperator(FNODE_PROJECTION, "Vector Projection", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector Rejection")) CreateNodeOperator(FNODE_REJECTION, "Vector Rejection", 2);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Half Direction")) CreateNodeOperator(FNODE_HALFDIRECTION, "Half Direction", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Append")) CreateNodeOperator(context, FNODE_APPEND, "Append", 4);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Normalize")) CreateNodeOperator(context, FNODE_NORMALIZE, "Normalize", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Cross Product")) CreateNodeOperator(context, FNODE_CROSSPRODUCT, "Cross Product", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Desaturate")) CreateNodeOperator(context, FNODE_DESATURATE, "Desaturate", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Distance")) CreateNodeOperator(context, FNODE_DISTANCE, "Distance", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Dot Product")) CreateNodeOperator(context, FNODE_DOTPRODUCT, "Dot Product", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Length")) CreateNodeOperator(context, FNODE_LENGTH, "Length", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Transpose")) CreateNodeOperator(context, FNODE_TRANSPOSE, "Transpose", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector Projection")) CreateNodeOperator(context, FNODE_PROJECTION, "Vector Projection", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vector Rejection")) CreateNodeOperator(context, FNODE_REJECTION, "Vector Rejection", 2);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Half Direction")) CreateNodeOperator(context, FNODE_HALFDIRECTION, "Half Direction", 2);
 
     DrawRightSection("Geometry Data", &layoutRect, (Vector4){ 50, 1.45f, 6, 1.85f });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vertex Position")) CreateNodeUniform(FNODE_VERTEXPOSITION, "Vertex Position", 3);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Normal Direction")) CreateNodeUniform(FNODE_VERTEXNORMAL, "Normal Direction", 3);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vertex Color")) CreateNodeOperator(FNODE_VERTEXCOLOR, "Vertex Color", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "View Direction")) CreateNodeUniform(FNODE_VIEWDIRECTION, "View Direction", 3);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Fresnel")) CreateNodeUniform(FNODE_FRESNEL, "Fresnel", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "MVP Matrix")) CreateNodeUniform(FNODE_MVP, "MVP Matrix", 16);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vertex Position")) CreateNodeUniform(context, FNODE_VERTEXPOSITION, "Vertex Position", 3);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Normal Direction")) CreateNodeUniform(context, FNODE_VERTEXNORMAL, "Normal Direction", 3);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Vertex Color")) CreateNodeOperator(context, FNODE_VERTEXCOLOR, "Vertex Color", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "View Direction")) CreateNodeUniform(context, FNODE_VIEWDIRECTION, "View Direction", 3);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Fresnel")) CreateNodeUniform(context, FNODE_FRESNEL, "Fresnel", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "MVP Matrix")) CreateNodeUniform(context, FNODE_MVP, "MVP Matrix", 16);
 
     DrawRightSection("Math Constants", &layoutRect, (Vector4){ 58, 1.25f, 2, 1.05f });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "PI")) CreateNodePI();
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "e")) CreateNodeE();
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "PI")) CreateNodePI(context);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "e")) CreateNodeE(context);
 
     DrawRightSection("Trigonometry", &layoutRect, (Vector4){ 61, 1.72f, 7, 0.3f });
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Current Time")) CreateNodeUniform(FNODE_TIME, "Current Time", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Cosine")) CreateNodeOperator(FNODE_COS, "Cosine", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Sine")) CreateNodeOperator(FNODE_SIN, "Sine", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Tangent")) CreateNodeOperator(FNODE_TAN, "Tangent", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Deg to Rad")) CreateNodeOperator(FNODE_DEG2RAD, "Deg to Rad", 1);
-    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Rad to Deg")) CreateNodeOperator(FNODE_RAD2DEG, "Rad to Deg", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Current Time")) CreateNodeUniform(context, FNODE_TIME, "Current Time", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Cosine")) CreateNodeOperator(context, FNODE_COS, "Cosine", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Sine")) CreateNodeOperator(context, FNODE_SIN, "Sine", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Tangent")) CreateNodeOperator(context, FNODE_TAN, "Tangent", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Deg to Rad")) CreateNodeOperator(context, FNODE_DEG2RAD, "Deg to Rad", 1);
+    if (InterfaceButton(RIGHT_LAYOUT_RECT, "Rad to Deg")) CreateNodeOperator(context, FNODE_RAD2DEG, "Rad to Deg", 1);
 
     DrawScrollbar();
 }
@@ -2292,9 +2102,9 @@ void DrawHelp(void)
 {
     if (help)
     {
-        int leftPadding = screenSize.x - canvasSize.x;
-        DrawRectangle(leftPadding + PADDING_MAIN_LEFT, PADDING_MAIN_BOTTOM, 450, 200, COLOR_HELP_BACKGROUND);
-        DrawRectangleLines(leftPadding + PADDING_MAIN_LEFT, PADDING_MAIN_BOTTOM, 450, 200, COLOR_HELP_BORDER);
+        int leftPadding = context->screenSize.x - canvasSize.x;
+        DrawRectangle(leftPadding + PADDING_MAIN_LEFT, PADDING_MAIN_BOTTOM, 450, 260, COLOR_HELP_BACKGROUND);
+        DrawRectangleLines(leftPadding + PADDING_MAIN_LEFT, PADDING_MAIN_BOTTOM, 450, 260, COLOR_HELP_BORDER);
 
         DrawText("Welcome to FNode, adventurer!", leftPadding + PADDING_MAIN_LEFT + 15, PADDING_MAIN_BOTTOM + 15, 10, COLOR_HELP_TEXT);
         DrawText("Controls:", leftPadding + PADDING_MAIN_LEFT + 15, PADDING_MAIN_BOTTOM + 35, 10, COLOR_HELP_TEXT);
@@ -2304,14 +2114,17 @@ void DrawHelp(void)
         DrawText("- Delete Node/Line/Comment: RIGHT MOUSE BUTTON", leftPadding + PADDING_MAIN_LEFT + 35, PADDING_MAIN_BOTTOM + 115, 10, COLOR_HELP_TEXT);
         DrawText("- Link: LEFT MOUSE BUTTON (INPUT/OUTPUT RECTANGLES)", leftPadding + PADDING_MAIN_LEFT + 35, PADDING_MAIN_BOTTOM + 135, 10, COLOR_HELP_TEXT);
         DrawText("- Preview: RIGHT ALT BUTTON", PADDING_MAIN_LEFT + 35, leftPadding + PADDING_MAIN_BOTTOM + 155, 10, COLOR_HELP_TEXT);
-        DrawText("Powered by raylib", leftPadding + PADDING_MAIN_LEFT + 15, PADDING_MAIN_BOTTOM + 180, 10, COLOR_HELP_TEXT);
+        DrawText("- Bake Texture: B BUTTON", leftPadding + PADDING_MAIN_LEFT + 35, PADDING_MAIN_BOTTOM + 175, 10, COLOR_HELP_TEXT);
+        DrawText("- Vertex Hoisting: V BUTTON", leftPadding + PADDING_MAIN_LEFT + 35, PADDING_MAIN_BOTTOM + 195, 10, COLOR_HELP_TEXT);
+        DrawText("- Evaluate Mesh: M BUTTON", leftPadding + PADDING_MAIN_LEFT + 35, PADDING_MAIN_BOTTOM + 215, 10, COLOR_HELP_TEXT);
+        DrawText("Powered by raylib", leftPadding + PADDING_MAIN_LEFT + 15, PADDING_MAIN_BOTTOM + 240, 10, COLOR_HELP_TEXT);
 
-        Rectangle iconRect = (Rectangle){ leftPadding + PADDING_MAIN_LEFT + 440 - iconTex.width, PADDING_MAIN_BOTTOM + 190 - iconTex.height, iconTex.width, iconTex.height };
+        Rectangle iconRect = (Rectangle){ leftPadding + PADDING_MAIN_LEFT + 440 - iconTex.width, PADDING_MAIN_BOTTOM + 250 - iconTex.height, iconTex.width, iconTex.height };
         DrawTexturePro(iconTex, (Rectangle){ 0, 0, iconTex.width, iconTex.height }, iconRect, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
     }
     else
     {
-        int leftPadding = screenSize.x - canvasSize.x;
+        int leftPadding = context->screenSize.x - canvasSize.x;
         DrawRectangle(leftPadding + PADDING_MAIN_LEFT, PADDING_MAIN_BOTTOM, WIDTH_HELP_LABEL, UI_BUTTON_HEIGHT, COLOR_HELP_BACKGROUND);
         DrawRectangleLines(leftPadding + PADDING_MAIN_LEFT, PADDING_MAIN_BOTTOM, WIDTH_HELP_LABEL, UI_BUTTON_HEIGHT, COLOR_HELP_BORDER);
 
@@ -2358,13 +2171,13 @@ void ApplySectionPadding(Rectangle *rect)
     rect->y += PADDING_MAIN_TOP*0.55f;
     rect->width -= PADDING_MAIN_LEFT;
     rect->height = UI_BUTTON_HEIGHT;
-    menuOffset = 0;
+    context->menuOffset = 0;
 }
 
 // Draw textures section content to drag and drop resources files
 void DrawTexturesPanel(Rectangle rect)
 {
-    menuOffset = 0;
+    context->menuOffset = 0;
     int menuOffsetY = 0;
 
     for (int i = 0; i < MAX_TEXTURES; i++)
@@ -2375,10 +2188,10 @@ void DrawTexturesPanel(Rectangle rect)
         Rectangle dest = (Rectangle){ 0, 0, 0, 0 };
 
         if (rowEnd)
-            dest = (Rectangle){ rect.x + (rect.width/2 + PADDING_MAIN_CENTER/2)*menuOffset, rect.y + (PADDING_MAIN_CENTER + rect.width/2)*menuOffsetY, 
+            dest = (Rectangle){ rect.x + (rect.width/2 + PADDING_MAIN_CENTER/2)*context->menuOffset, rect.y + (PADDING_MAIN_CENTER + rect.width/2)*menuOffsetY, 
             rect.width/2 - PADDING_MAIN_CENTER/2, rect.width/2 };
         else
-            dest = (Rectangle){ rect.x + (rect.width/2 + PADDING_MAIN_CENTER/2)*menuOffset, rect.y + 
+            dest = (Rectangle){ rect.x + (rect.width/2 + PADDING_MAIN_CENTER/2)*context->menuOffset, rect.y + 
             (PADDING_MAIN_CENTER + rect.width/2)*menuOffsetY, rect.width/2 - PADDING_MAIN_CENTER/2, rect.width/2 };
 
         if (!loadedtexRects) texRects[i] = dest;
@@ -2397,7 +2210,7 @@ void DrawTexturesPanel(Rectangle rect)
                 texPaths[i] = NULL;
             }
         }
-        else menuOffset++;
+        else context->menuOffset++;
 
         if (textures[i].id == 0)
         {
@@ -2411,7 +2224,7 @@ void DrawTexturesPanel(Rectangle rect)
 
         if (rowEnd)
         {
-            menuOffset = 0;
+            context->menuOffset = 0;
             menuOffsetY++;
         }
     }
@@ -2422,7 +2235,7 @@ void DrawTexturesPanel(Rectangle rect)
 // Draw right interface scroll rectangle and handle
 void DrawScrollbar(void)
 {
-    DrawRectangle(menuScrollRec.x, 0, menuScrollRec.width, screenSize.y, COLOR_SCROLLBAR_BACKGROUND);
+    DrawRectangle(menuScrollRec.x, 0, menuScrollRec.width, context->screenSize.y, COLOR_SCROLLBAR_BACKGROUND);
     DrawRectangleRec(menuScrollRec, (COLOR_SCROLLBAR_HANDLE));
 
     if (scrollState == 1) DrawRectangleRec(menuScrollRec, COLOR_BUTTON_PRESSED);
@@ -2450,7 +2263,7 @@ bool InterfaceButton(Rectangle bounds, const char *text)
     if (buttonState == BUTTON_HOVER) DrawRectangleRec(bounds, COLOR_BUTTON_HIGHLIGHT);
     else if (buttonState == BUTTON_PRESSED) DrawRectangleRec(bounds, COLOR_BUTTON_PRESSED);
 
-    menuOffset++;
+    context->menuOffset++;
 
     return (buttonState == BUTTON_CLICKED);
 }
@@ -2477,7 +2290,7 @@ bool InterfaceButtonGroup(Rectangle bounds, const char *text, bool enabled)
     if (buttonState == BUTTON_HOVER) DrawRectangleRec(bounds, COLOR_BUTTON_HIGHLIGHT);
     else if (buttonState == BUTTON_PRESSED) DrawRectangleRec(bounds, COLOR_BUTTON_PRESSED);
 
-    menuOffset++;
+    context->menuOffset++;
 
     return (buttonState == BUTTON_CLICKED);
 }
@@ -2548,8 +2361,10 @@ int main(void)
 {
     // Initialization
     //--------------------------------------------------------------------------------------
+    context = InitFNode();
+
     SetConfigFlags(FLAG_MSAA_4X_HINT | FLAG_VSYNC_HINT);
-    InitWindow(screenSize.x, screenSize.y, "[fnode] Create shaders with visual scripting");
+    InitWindow(context->screenSize.x, context->screenSize.y, "[fnode] Create shaders with visual scripting");
     iconTex = LoadTexture(WINDOW_ICON);
 
     // Load resources
@@ -2559,26 +2374,31 @@ int main(void)
     if (model.meshCount > 0)
         loadedModel = true;
     
-    visorTarget = LoadRenderTexture(screenSize.x/4, screenSize.y/4);
-    gridTarget = LoadRenderTexture(screenSize.x, screenSize.y);
+    visorTarget = LoadRenderTexture(context->screenSize.x/4, context->screenSize.y/4);
+    gridTarget = LoadRenderTexture(context->screenSize.x, context->screenSize.y);
     fxaa = LoadShader(FXAA_VERTEX, FXAA_FRAGMENT);
 
     // Initialize values
-    camera = (Camera2D){ (Vector2){ 0, 0 }, (Vector2){ screenSize.x/2, screenSize.y/2 }, 0.0f, 1.0f };
-    canvasSize = (Vector2){ screenSize.x*0.85f, screenSize.y };
-    interfaceRect = (Rectangle){ canvasSize.x, 0.0f, screenSize.x - canvasSize.x, screenSize.y };
-    sidebarRect = (Rectangle){ 0, 0, screenSize.x - canvasSize.x, screenSize.y };
-    camera3d = (Camera){{ 4.0f, 2.0f, 4.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, 45.0f };
-    SetCameraMode(camera3d, CAMERA_FREE);
-    menuScrollRec = (Rectangle){ screenSize.x - 10, 0, 10, 30 };
+    context->camera = (Camera2D){ (Vector2){ 0, 0 }, (Vector2){ context->screenSize.x/2, context->screenSize.y/2 }, 0.0f, 1.0f };
+    canvasSize = (Vector2){ context->screenSize.x*0.85f, context->screenSize.y };
+    interfaceRect = (Rectangle){ canvasSize.x, 0.0f, context->screenSize.x - canvasSize.x, context->screenSize.y };
+    sidebarRect = (Rectangle){ 0, 0, context->screenSize.x - canvasSize.x, context->screenSize.y };
+    context->camera3d = (Camera){{ 4.0f, 2.0f, 4.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, 45.0f };
+    SetCameraMode(context->camera3d, CAMERA_FREE);
+    menuScrollRec = (Rectangle){ context->screenSize.x - 10, 0, 10, 30 };
     menuScrollLimits = (Vector2){ 0, HEIGHT_SCROLL_AREA };
 
     // Initialize shaders values
     fxaaUniform = GetShaderLocation(fxaa, FXAA_SCREENSIZE_UNIFORM);
 
-    InitFNode();
+    SetBackfaceCulling(false);
+    InitShaderExtensions();
+
+    // Cache files of previous sessions are limited so output folder does not grow with every edited graph
+    TrimCacheFiles("cache_", 2*MAX_CACHE_FILES);
+    TrimCacheFiles("program_", MAX_CACHE_FILES);
     CheckPreviousShader(true);
-    UpdateCamera(&camera3d);
+    UpdateCamera(&context->camera3d);
 
     SetTargetFPS(60);
     //--------------------------------------------------------------------------------------
@@ -2647,11 +2467,13 @@ int main(void)
     }
 
     UnloadShader(fxaa);
-    if (loadedShader) UnloadShader(shader);
+    CancelShaderCompile();
+    if (loadedShader && !IsShaderCached(shader)) UnloadShader(shader);
+    UnloadShaderCache();
 
     for (int i = 0; i < MAX_TEXTURES; i++) UnloadTexture(textures[i]);
 
-    CloseFNode();
+    CloseFNode(context);
     CloseWindow();        // Close window and OpenGL context
     //--------------------------------------------------------------------------------------
 